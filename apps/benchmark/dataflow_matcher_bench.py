@@ -0,0 +1,108 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark graph pattern matching of relax.dpl with and without the candidate index.
+
+A dataflow block of stacked attention layers is matched against a graph pattern spanning one
+layer, once without a start hint and once from the start of every layer. Both searches are
+timed with the indexed matcher and with the exhaustive one. Without a start hint the two may
+pick different layers, so only the sizes of the matches are compared; from a start hint they
+must find the same vars.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+from tvm import relax as rx
+from tvm.relax.dpl import PatternContext, is_call_tir_extern, is_op, wildcard
+
+
+def stacked_attention_block(num_layers):
+    """A dataflow block of num_layers attention layers of 10 bindings each."""
+    bb = rx.BlockBuilder()
+    x = rx.Var("x", [32, 32], rx.DynTensorType(2, "float32"))
+    weights = [rx.Var("w%d" % i, [32, 32], rx.DynTensorType(2, "float32")) for i in range(3)]
+    with bb.function("main", [x] + weights):
+        with bb.dataflow():
+            hidden = x
+            for _ in range(num_layers):
+                qkv = []
+                for w in weights:
+                    fc = bb.emit(rx.call_tir("my_fc", (hidden, w), (32, 32), dtype="float32"))
+                    qkv.append(
+                        bb.emit(rx.call_tir("my_transpose", (fc,), (32, 32), dtype="float32"))
+                    )
+                score = bb.emit(rx.op.multiply(qkv[0], qkv[1]))
+                prob = bb.emit(rx.call_tir("softmax", (score,), (32, 32), dtype="float32"))
+                attn = bb.emit(rx.op.multiply(prob, qkv[2]))
+                hidden = bb.emit(rx.op.add(attn, hidden))
+            out = bb.emit_output(hidden)
+        bb.emit_func_output(out)
+    return bb.get()["main"].body.blocks[0]
+
+
+def measure(ctx, dfb, starts, use_index, repeat):
+    """Return the best time of the searches in seconds, and the matches of each search."""
+    best = None
+    for _ in range(repeat):
+        tic = time.perf_counter()
+        results = [
+            ctx.match_dfb(
+                dfb, start_hint=start, must_include_hint=start is not None, use_index=use_index
+            )
+            for start in starts
+        ]
+        elapsed = time.perf_counter() - tic
+        best = elapsed if best is None else min(best, elapsed)
+    matches = [
+        sorted(str(var.name_hint) for var in result.values()) if start is not None else len(result)
+        for start, result in zip(starts, results)
+    ]
+    return best, matches
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--num-layers",
+        type=int,
+        nargs="+",
+        default=[24, 96],
+        help="The numbers of attention layers of the matched block, 10 bindings each",
+    )
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    print("%-10s %-12s %12s %12s %9s" % ("layers", "search", "naive (s)", "indexed (s)", "speedup"))
+    for num_layers in args.num_layers:
+        dfb = stacked_attention_block(num_layers)
+        with PatternContext() as ctx:
+            fc_trans = is_call_tir_extern("my_fc") >> is_call_tir_extern("my_transpose")
+            fc_trans >> is_op("relax.multiply")(wildcard(), wildcard()) >> is_call_tir_extern(
+                "softmax"
+            )
+            searches = [
+                ("first", [None]),
+                ("per-layer", [dfb.bindings[layer * 10].var for layer in range(num_layers)]),
+            ]
+            for name, starts in searches:
+                naive, naive_matches = measure(ctx, dfb, starts, False, args.repeat)
+                indexed, indexed_matches = measure(ctx, dfb, starts, True, args.repeat)
+                assert naive_matches == indexed_matches, "The index changed the matches"
+                print(
+                    "%-10d %-12s %12.4f %12.4f %8.1fx"
+                    % (num_layers, name, naive, indexed, naive / indexed)
+                )
@@ -0,0 +1,96 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark the lowering time of a network with function-level passes run on several threads.
+
+The network is built for llvm once per value of "ir.function_pass_num_threads", and the time
+spent in the thread-safe TIR passes is reported next to the time of the whole build. The
+generated code is checked to be the same for every number of threads.
+see README.md for the usage of this script.
+"""
+import argparse
+import hashlib
+import multiprocessing
+import time
+
+import tvm
+from tvm import relay
+
+from util import get_network
+
+THREAD_SAFE_PASSES = ["tir.Simplify", "tir.RemoveNoOp", "tir.UnrollLoop", "tir.VectorizeLoop"]
+
+
+@tvm.instrument.pass_instrument
+class PassTimer:
+    """Accumulate the time spent in the passes with the given names."""
+
+    def __init__(self, names):
+        self.names = set(names)
+        self.elapsed = 0.0
+        self.start = None
+
+    def run_before_pass(self, mod, info):
+        if info.name in self.names:
+            self.start = time.perf_counter()
+
+    def run_after_pass(self, mod, info):
+        if info.name in self.names:
+            self.elapsed += time.perf_counter() - self.start
+
+
+def measure(mod, params, num_threads, repeat):
+    """Return the best build time and time in the thread-safe passes in seconds, and a digest
+    of the generated code."""
+    results = []
+    for _ in range(repeat):
+        timer = PassTimer(THREAD_SAFE_PASSES)
+        config = {"ir.function_pass_num_threads": num_threads}
+        tic = time.perf_counter()
+        with tvm.transform.PassContext(opt_level=3, config=config, instruments=[timer]):
+            lib = relay.build(mod, target="llvm", params=params)
+        results.append((time.perf_counter() - tic, timer.elapsed))
+    digest = hashlib.sha256(lib.get_lib().get_source("ll").encode()).hexdigest()
+    build_time, pass_time = min(results)
+    return build_time, pass_time, digest
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--network",
+        type=str,
+        default="resnet-50",
+        help="The name of the network, see util.get_network",
+    )
+    parser.add_argument(
+        "--num-threads",
+        type=int,
+        nargs="+",
+        default=[1, multiprocessing.cpu_count()],
+        help="The values of ir.function_pass_num_threads to compare, 0 uses all cores",
+    )
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    net, params, _, _ = get_network(args.network, batch_size=1)
+    print("%-12s %12s %14s" % ("threads", "build (s)", "passes (s)"))
+    digests = set()
+    for num_threads in args.num_threads:
+        build_time, pass_time, digest = measure(net, params, num_threads, args.repeat)
+        digests.add(digest)
+        print("%-12d %12.2f %14.2f" % (num_threads, build_time, pass_time))
+    assert len(digests) == 1, "The generated code depends on the number of threads"
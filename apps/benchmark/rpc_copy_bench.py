@@ -0,0 +1,155 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark the throughput of array copies over RPC.
+
+The copies go to an rpc.Server on the local machine through a proxy which delays every chunk
+of data by a configurable one-way latency, to measure copies over links like the ones to
+remote devices.
+see README.md for the usage of this script.
+"""
+import argparse
+import collections
+import socket
+import threading
+import time
+
+import numpy as np
+
+import tvm
+from tvm import rpc
+
+
+def measure(remote, nbytes, repeat):
+    """Return the upload and download throughput in MB/s."""
+    dev = remote.cpu(0)
+    a_np = np.random.randint(0, 255, size=(nbytes,), dtype="uint8")
+    a = tvm.nd.empty(a_np.shape, "uint8", dev)
+    b_np = np.empty_like(a_np)
+
+    # warm up
+    a.copyfrom(a_np)
+    a.copyto(b_np)
+
+    tic = time.time()
+    for _ in range(repeat):
+        a.copyfrom(a_np)
+    upload = nbytes * repeat / (time.time() - tic) / 1e6
+
+    tic = time.time()
+    for _ in range(repeat):
+        a.copyto(b_np)
+    download = nbytes * repeat / (time.time() - tic) / 1e6
+    np.testing.assert_equal(a_np, b_np)
+    return upload, download
+
+
+class DelayProxy(object):
+    """A TCP proxy to a server which delivers every chunk `delay` seconds after receiving it.
+
+    Chunks are forwarded by a separate thread, so the delay adds latency without limiting the
+    bandwidth, like a long link would.
+    """
+
+    def __init__(self, server_port, delay):
+        self.delay = delay
+        self.server_port = server_port
+        self.listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.listener.bind(("127.0.0.1", 0))
+        self.listener.listen(1)
+        self.port = self.listener.getsockname()[1]
+        thread = threading.Thread(target=self._accept, daemon=True)
+        thread.start()
+
+    def _accept(self):
+        while True:
+            client, _ = self.listener.accept()
+            server = socket.create_connection(("127.0.0.1", self.server_port))
+            for sock in [client, server]:
+                sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            self._pipe(client, server)
+            self._pipe(server, client)
+
+    def _pipe(self, src, dst):
+        chunks = collections.deque()
+        ready = threading.Condition()
+
+        def receive():
+            while True:
+                data = src.recv(1 << 20)
+                with ready:
+                    chunks.append((time.time() + self.delay, data))
+                    ready.notify()
+                if not data:
+                    return
+
+        def send():
+            while True:
+                with ready:
+                    while not chunks:
+                        ready.wait()
+                    deadline, data = chunks.popleft()
+                time.sleep(max(0.0, deadline - time.time()))
+                if not data:
+                    dst.shutdown(socket.SHUT_WR)
+                    return
+                dst.sendall(data)
+
+        threading.Thread(target=receive, daemon=True).start()
+        threading.Thread(target=send, daemon=True).start()
+
+
+def main(args):
+    """Print the throughput of copies of each size, at each delay, with and without streaming."""
+    server = rpc.Server(host="127.0.0.1", key="x1")
+    header = ("delay ms", "stream", "size", "upload MB/s", "download MB/s")
+    print("%-10s %-8s %12s %14s %14s" % header)
+    for delay_ms in args.delay:
+        proxy = DelayProxy(server.port, delay_ms / 1000.0)
+        remote = rpc.connect("127.0.0.1", proxy.port, key="x1")
+        for window in [0, args.window]:
+            remote.set_copy_stream(window)
+            for nbytes in args.size:
+                upload, download = measure(remote, nbytes, args.repeat)
+                print(
+                    "%-10g %-8s %12d %14.1f %14.1f"
+                    % (delay_ms, "on" if window else "off", nbytes, upload, download)
+                )
+        del remote
+    server.terminate()
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--delay",
+        type=float,
+        nargs="+",
+        default=[0, 1, 10],
+        help="The one-way latencies added to the link to the server, in milliseconds.",
+    )
+    parser.add_argument(
+        "--size",
+        type=int,
+        nargs="+",
+        default=[1 << 12, 1 << 16, 1 << 20, 1 << 24, 1 << 28],
+        help="The sizes of the copies in bytes.",
+    )
+    parser.add_argument(
+        "--window", type=int, default=8, help="The copy stream window to compare with no streaming."
+    )
+    parser.add_argument("--repeat", type=int, default=10)
+    main(parser.parse_args())
@@ -0,0 +1,85 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Benchmark the lowering time of a network with and without the simplify cache.
+
+The network is built for llvm once per cache size of tir.Simplify, and the time spent in
+tir.Simplify is reported next to the time of the whole build.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import tvm
+from tvm import relay
+
+from util import get_network
+
+
+@tvm.instrument.pass_instrument
+class PassTimer:
+    """Accumulate the time spent in the passes with a given name."""
+
+    def __init__(self, name):
+        self.name = name
+        self.elapsed = 0.0
+        self.start = None
+
+    def run_before_pass(self, mod, info):
+        if info.name == self.name:
+            self.start = time.perf_counter()
+
+    def run_after_pass(self, mod, info):
+        if info.name == self.name:
+            self.elapsed += time.perf_counter() - self.start
+
+
+def measure(mod, params, cache_size, repeat):
+    """Return the best build time and time in tir.Simplify in seconds."""
+    results = []
+    for _ in range(repeat):
+        timer = PassTimer("tir.Simplify")
+        config = {"tir.Simplify": {"simplify_cache_size": cache_size}}
+        tic = time.perf_counter()
+        with tvm.transform.PassContext(opt_level=3, config=config, instruments=[timer]):
+            relay.build(mod, target="llvm", params=params)
+        results.append((time.perf_counter() - tic, timer.elapsed))
+    return min(results)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--network",
+        type=str,
+        default="resnet-50",
+        help="The name of the network, see util.get_network",
+    )
+    parser.add_argument(
+        "--cache-size",
+        type=int,
+        nargs="+",
+        default=[0, 4096],
+        help="The cache sizes of tir.Simplify to compare, 0 disables the cache",
+    )
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    net, params, _, _ = get_network(args.network, batch_size=1)
+    print("%-12s %12s %14s" % ("cache size", "build (s)", "Simplify (s)"))
+    for cache_size in args.cache_size:
+        build_time, simplify_time = measure(net, params, cache_size, args.repeat)
+        print("%-12d %12.2f %14.2f" % (cache_size, build_time, simplify_time))
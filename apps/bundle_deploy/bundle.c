@@ -25,6 +25,7 @@
 #include <tvm/runtime/crt/graph_executor.h>
 #include <tvm/runtime/crt/packed_func.h>
 #include <tvm/runtime/crt/page_allocator.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
 
 #ifdef ENABLE_TVM_ABORT_BACKTRACE
 #include "backtrace.h"
@@ -64,8 +65,12 @@ TVM_DLL void* tvm_runtime_create(const char* json_data, const char* params_data,
   dev.device_id = device_id;
 
   // declare pointers
+#ifdef TVM_CRT_USE_TLSF_ALLOCATOR
+  TVM_CCALL(TLSFMemoryManagerCreate(&g_memory_manager, g_crt_memory, sizeof(g_crt_memory)));
+#else
   TVM_CCALL(PageMemoryManagerCreate(&g_memory_manager, g_crt_memory, sizeof(g_crt_memory),
                                     CRT_MEMORY_PAGE_SIZE_LOG2));
+#endif
   TVM_CCALL(TVMInitializeRuntime());
   TVMPackedFunc pf;
   TVMArgs args = TVMArgs_Create(NULL, NULL, 0);
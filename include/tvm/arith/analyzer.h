@@ -494,6 +494,8 @@ class ConstraintContext {
   PrimExpr constraint_;
   /*! \brief function to be called in recovery */
   std::vector<std::function<void()>> recovery_functions_;
+  /*! \brief The simplify cache epoch of the analyzer before entering the scope */
+  uint64_t saved_simplify_epoch_{0};
 };
 
 /*!
@@ -675,6 +677,49 @@ class TVM_DLL Analyzer {
    * \note Analyzer will call into sub-analyzers to get the result.
    */
   PrimExpr Simplify(const PrimExpr& expr, int steps = 2);
+  /*!
+   * \brief Memoize the results of Simplify.
+   *
+   *  Results are keyed by the expression node and are valid in the constraint context
+   *  and for the bindings they were computed with. Entering or leaving a ConstraintContext
+   *  switches the context, and Bind starts a new binding epoch. Stale results are dropped
+   *  once the cache is full.
+   *
+   * \param max_entries The maximum number of cached results, the cache is emptied once
+   *        it is full. 0 disables the cache.
+   *
+   * \note Code that updates a sub-analyzer directly, bypassing Analyzer::Bind and
+   *       ConstraintContext, must call InvalidateSimplifyCache.
+   */
+  void EnableSimplifyCache(size_t max_entries = 4096);
+  /*! \brief Invalidate all the memoized results of Simplify. */
+  void InvalidateSimplifyCache();
+
+ private:
+  friend class ConstraintContext;
+  /*! \brief A memoized result of Simplify. */
+  struct SimplifyCacheEntry {
+    /*! \brief The number of simplification steps */
+    int steps;
+    /*! \brief The constraint context epoch the result is valid in */
+    uint64_t epoch;
+    /*! \brief The binding epoch the result is valid in */
+    uint64_t bind_epoch;
+    /*! \brief The enabled rewrite simplifier extensions */
+    int extensions;
+    /*! \brief The simplified expression */
+    PrimExpr result;
+  };
+  /*! \brief The maximum number of cached results, 0 if the cache is disabled */
+  size_t simplify_cache_max_entries_{0};
+  /*! \brief The memoized results of Simplify */
+  std::unordered_map<PrimExpr, SimplifyCacheEntry, ObjectPtrHash, ObjectPtrEqual> simplify_cache_;
+  /*! \brief The epoch of the current constraint context */
+  uint64_t simplify_epoch_{0};
+  /*! \brief The last allocated constraint context epoch */
+  uint64_t last_simplify_epoch_{0};
+  /*! \brief The epoch of the bindings, advanced by Bind and InvalidateSimplifyCache */
+  uint64_t simplify_bind_epoch_{0};
 };
 
 }  // namespace arith
@@ -547,6 +547,17 @@ class IntImm : public PrimExpr {
   TVM_DEFINE_OBJECT_REF_METHODS(IntImm, PrimExpr, IntImmNode);
 };
 
+/*!
+ * \brief Enable or disable the interning of small integer constants.
+ *
+ *  When enabled, IntImm constructed without a span shares one node per dtype and value for
+ *  int32/int64 values in [-16, 256) and for booleans. This saves allocations, but code that
+ *  keys on node identity sees all these constants as one node, so it is disabled by default.
+ * \param enabled Whether to intern the constants constructed from now on.
+ * \return Whether interning was enabled before.
+ */
+TVM_DLL bool SetIntImmInterning(bool enabled);
+
 /*!
  * \brief Constant floating point literals in the program.
  * \sa FloatImm
@@ -64,6 +64,7 @@
 #include <tvm/runtime/container/string.h>
 #include <tvm/support/with.h>
 
+#include <functional>
 #include <string>
 #include <utility>
 
@@ -321,6 +322,12 @@ class PassInfoNode : public Object {
   /*! \brief The passes that are required to perform the current pass. */
   Array<String> required;
 
+  /*!
+   * \brief Boolean that tells whether a function-level pass can process different functions
+   * of a module concurrently. See "ir.function_pass_num_threads".
+   */
+  bool thread_safe = false;
+
   PassInfoNode() = default;
 
   void VisitAttrs(AttrVisitor* v) {
@@ -328,6 +335,7 @@ class PassInfoNode : public Object {
     v->Visit("name", &name);
     v->Visit("required", &required);
     v->Visit("traceable", &traceable);
+    v->Visit("thread_safe", &thread_safe);
   }
 
   static constexpr const char* _type_key = "transform.PassInfo";
@@ -347,8 +355,11 @@ class PassInfo : public ObjectRef {
    * \param name Name of the pass.
    * \param required  The passes that are required to perform the current pass.
    * \param traceable Boolean that tells whether the pass is traceable.
+   * \param thread_safe Boolean that tells whether a function-level pass can process different
+   * functions concurrently.
    */
-  TVM_DLL PassInfo(int opt_level, String name, Array<runtime::String> required, bool traceable);
+  TVM_DLL PassInfo(int opt_level, String name, Array<runtime::String> required, bool traceable,
+                   bool thread_safe = false);
 
   TVM_DEFINE_OBJECT_REF_METHODS(PassInfo, ObjectRef, PassInfoNode);
 };
@@ -526,6 +537,31 @@ TVM_DLL Pass CreateModulePass(
     const runtime::TypedPackedFunc<IRModule(IRModule, PassContext)>& pass_func, int opt_level,
     String name, Array<runtime::String> required, bool traceable = false);
 
+/*!
+ * \brief Get the number of threads a function-level pass uses to process the functions of a
+ * module. Functions are only processed in parallel when the pass is declared thread-safe and
+ * "ir.function_pass_num_threads" is set in the pass context.
+ *
+ * \param pass_ctx The pass context.
+ * \param pass_info The information of the function-level pass.
+ *
+ * \return The number of threads, 1 if the functions are processed serially.
+ */
+TVM_DLL int GetFunctionPassNumThreads(const PassContext& pass_ctx, const PassInfo& pass_info);
+
+/*!
+ * \brief Run `fapply(task_id)` for each task in [0, num_tasks) on `num_threads` threads.
+ * `pass_ctx` is entered (without running instrumentations) in every worker thread so that
+ * PassContext::Current() stays valid inside the pass functions.
+ *
+ * \param pass_ctx The pass context the tasks run under.
+ * \param num_threads The number of threads.
+ * \param num_tasks The number of tasks.
+ * \param fapply The function applied to each task.
+ */
+TVM_DLL void ParallelForEachFunction(const PassContext& pass_ctx, int num_threads, int num_tasks,
+                                     const std::function<void(int task_id)>& fapply);
+
 /*!
  * \brief A special trace pass that prints the header and IR to LOG(INFO).
  * \param header The header to be attached to the output.
@@ -31,7 +31,9 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/support/random_engine.h>
 
+#include <future>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace tvm {
@@ -59,6 +61,11 @@ class TaskRecordNode : public runtime::Object {
   Optional<Array<BuilderResult>> builder_results = NullOpt;
   /*! \brief Packed functions to fetch the runner results asynchronously. */
   Optional<Array<RunnerFuture>> runner_futures = NullOpt;
+  /*!
+   * \brief The asynchronous build of `measure_candidates` still in flight, if any. It produces
+   * the builder results, and the runner futures aligned with the candidates.
+   */
+  std::shared_future<std::pair<Array<BuilderResult>, Array<RunnerFuture>>> inflight_build;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("ctx", &ctx);
@@ -71,6 +78,7 @@ class TaskRecordNode : public runtime::Object {
     v->Visit("measure_candidates", &measure_candidates);
     v->Visit("builder_results", &builder_results);
     v->Visit("runner_futures", &runner_futures);
+    // `inflight_build` is not visited
   }
 
   static constexpr const char* _type_key = "meta_schedule.TaskRecord";
@@ -139,6 +147,13 @@ class TaskSchedulerNode : public runtime::Object {
   Optional<CostModel> cost_model_;
   /*! \brief The number of remaining tasks to be tuned. */
   int remaining_tasks_;
+  /*!
+   * \brief The maximum number of measurement batches kept in flight across tasks.
+   * If positive, candidates are built and sent to the runner in the background, so that the search
+   * of the next task overlaps with the measurement of the previous ones. If zero, candidates are
+   * built synchronously before the next task is picked.
+   */
+  int max_inflight_batches = 0;
 
   /*! \brief The default destructor. */
   virtual ~TaskSchedulerNode() = default;
@@ -150,6 +165,7 @@ class TaskSchedulerNode : public runtime::Object {
     v->Visit("database_", &database_);
     v->Visit("cost_model_", &cost_model_);
     v->Visit("remaining_tasks_", &remaining_tasks_);
+    v->Visit("max_inflight_batches", &max_inflight_batches);
   }
 
   /*!
@@ -198,6 +214,8 @@ class TaskSchedulerNode : public runtime::Object {
   void TouchTask(int task_id);
   /*! \brief Print out a human-readable format of the tuning statistics. */
   void PrintTuningStatistics();
+  /*! \brief Count the tasks whose measurement batches are still in flight. */
+  int CountInflightBatches() const;
 
   static constexpr const char* _type_key = "meta_schedule.TaskScheduler";
   TVM_DECLARE_BASE_OBJECT_INFO(TaskSchedulerNode, Object);
@@ -264,19 +282,22 @@ class TaskScheduler : public runtime::ObjectRef {
   /*!
    * \brief Create a task scheduler that fetches tasks in a round-robin fashion.
    * \param logger The tuning task's logging function.
+   * \param max_inflight_batches The maximum number of measurement batches kept in flight.
    * \return The task scheduler created.
    */
-  TVM_DLL static TaskScheduler RoundRobin(PackedFunc logger);
+  TVM_DLL static TaskScheduler RoundRobin(PackedFunc logger, int max_inflight_batches);
   /*!
    * \brief Create a task scheduler that fetches tasks in a gradient based fashion.
    * \param logger The tuning task's logging function.
    * \param alpha The parameter alpha to control gradient computation.
    * \param window_size The parameter to control backward window size.
    * \param seed The random seed.
+   * \param max_inflight_batches The maximum number of measurement batches kept in flight.
    * \return The task scheduler created.
    */
   TVM_DLL static TaskScheduler GradientBased(PackedFunc logger, double alpha, int window_size,
-                                             support::LinearCongruentialEngine::TRandState seed);
+                                             support::LinearCongruentialEngine::TRandState seed,
+                                             int max_inflight_batches);
   /*!
    * \brief Create a task scheduler with customized methods on the python-side.
    * \param logger The tuning task's logging function.
@@ -27,6 +27,7 @@
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/ndarray.h>
 
+#include <atomic>
 #include <functional>
 #include <string>
 
@@ -84,6 +85,79 @@ class StructuralHash : public BaseValueHash {
   TVM_DLL size_t operator()(const ObjectRef& key) const;
 };
 
+/*!
+ * \brief A slot that caches the structural hash of an immutable node.
+ *
+ *  Node types that are expensive to hash and hashed repeatedly (e.g. functions)
+ *  can embed this slot and register it with TVM_REGISTER_STRUCTURAL_HASH_CACHE.
+ *  StructuralHash then reuses the cached value when the node is hashed as a root.
+ *
+ *  Copying the slot yields an empty slot, so a node copied by CopyOnWrite never
+ *  inherits a stale value. A node mutated in place (CopyOnWrite on a uniquely
+ *  referenced object) must call Clear. The slot is neither read nor written while
+ *  the node has a single reference, since it may still be mutated through a
+ *  pointer returned by an earlier CopyOnWrite.
+ */
+class StructuralHashCache {
+ public:
+  StructuralHashCache() = default;
+  StructuralHashCache(const StructuralHashCache&) {}
+  StructuralHashCache& operator=(const StructuralHashCache&) {
+    this->Clear();
+    return *this;
+  }
+  /*!
+   * \brief Get the cached hash value.
+   * \param value The output hash value.
+   * \return Whether the cache holds a value.
+   */
+  bool Get(size_t* value) const {
+    if (!valid_.load(std::memory_order_acquire)) return false;
+    *value = value_.load(std::memory_order_relaxed);
+    return true;
+  }
+  /*!
+   * \brief Set the cached hash value.
+   * \param value The hash value.
+   */
+  void Set(size_t value) const {
+    value_.store(value, std::memory_order_relaxed);
+    valid_.store(true, std::memory_order_release);
+  }
+  /*! \brief Invalidate the cached value. */
+  void Clear() const { valid_.store(false, std::memory_order_release); }
+
+ private:
+  /*! \brief The cached hash value. */
+  mutable std::atomic<size_t> value_{0};
+  /*! \brief Whether value_ holds a valid hash. */
+  mutable std::atomic<bool> valid_{false};
+};
+
+/*!
+ * \brief Register the structural hash cache slot of a node type.
+ * \param type_index The runtime type index of the node type.
+ * \param fget The function returning the slot of a node of this type.
+ * \return true, used to register at static initialization time.
+ */
+TVM_DLL bool RegisterStructuralHashCache(uint32_t type_index,
+                                         const StructuralHashCache* (*fget)(const Object*));
+
+#define TVM_STRUCTURAL_HASH_CACHE_REG_VAR_DEF static TVM_ATTRIBUTE_UNUSED bool __make_shash_cache
+
+/*!
+ * \brief Register a StructuralHashCache member of a node type.
+ * \param NodeType The node type.
+ * \param Field The name of the StructuralHashCache member.
+ */
+#define TVM_REGISTER_STRUCTURAL_HASH_CACHE(NodeType, Field)                   \
+  TVM_STR_CONCAT(TVM_STRUCTURAL_HASH_CACHE_REG_VAR_DEF, __COUNTER__) =        \
+      ::tvm::RegisterStructuralHashCache(                                     \
+          NodeType::RuntimeTypeIndex(),                                       \
+          [](const ::tvm::runtime::Object* n) -> const ::tvm::StructuralHashCache* { \
+            return &static_cast<const NodeType*>(n)->Field;                   \
+          })
+
 /*!
  * \brief A Reducer class to reduce the structural hash value.
  *
@@ -54,12 +54,16 @@ bool MatchExpr(DFPattern pattern, Expr expr, Optional<runtime::Map<Var, Expr>> v
  * \param dfb The function to match.
  * \param start_hint The starting point expression to match to distinguish multiple matches.
  * \param must_include_hint If start_hint is given, the return pattern must include start_hint.
+ * \param use_index Whether to look up the candidates of each pattern node by op and to memoize
+ * node-level matches. Disabling it tries every var for every pattern node, which is only useful
+ * to measure the index.
  * \return tvm::runtime::Map<DFPattern, Var>
  */
 TVM_DLL tvm::runtime::Map<DFPattern, Var> MatchGraph(const PatternContext& ctx,
                                                      const DataflowBlock& dfb,
                                                      Optional<Var> start_hint = NullOpt,
-                                                     bool must_include_hint = false);
+                                                     bool must_include_hint = false,
+                                                     bool use_index = true);
 
 /**
  * \brief Match a graph-wise pattern with the current context (PatternContext::Current()).
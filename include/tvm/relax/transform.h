@@ -49,7 +49,8 @@ using DataflowBlock = tvm::relax::DataflowBlock;
  */
 TVM_DLL Pass CreateFunctionPass(
     const runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required, bool traceable = false);
+    int opt_level, String name, tvm::Array<String> required, bool traceable = false,
+    bool thread_safe = false);
 
 /*!
  * \brief Create a dataflowblock pass.
@@ -166,11 +167,24 @@ TVM_DLL Pass FuseOps(int fuse_opt_level = -1);
 /*!
  * \brief Fuse relax sub-function into a larger TIR function if possible.
     this pass works together with FuseOps to perform operator fusion.
+ * \note When the PassContext config "relax.FuseTIR.reuse_intermediate_buffers" is set,
+ *       intermediate buffers of the same shape and dtype whose lifetimes do not overlap share
+ *       one allocation in the fused function.
 
  * \return The Pass.
  */
 TVM_DLL Pass FuseTIR();
 
+/*!
+ * \brief Batch independent call_tir bindings in a dataflow block that invoke the same PrimFunc
+ * into a single call_tir, whose PrimFunc runs all the original kernels and returns their outputs
+ * as a tuple. Unlike FuseOps and FuseTIR, which fuse along producer-consumer edges, this pass
+ * fuses calls that do not depend on each other, e.g. the Q/K/V projections of attention.
+ *
+ * \return The Pass.
+ */
+TVM_DLL Pass HorizontalFuseTIR();
+
 /*!
  * \brief Remove unused global relax functions in a IRModule.
  * \param entry_functions list of entry functions
@@ -218,6 +218,23 @@ class TraceNode : public runtime::Object {
     return out_mod;
   }
 
+  /*!
+   * \brief Add a knob and its decision whose outcome is already known, e.g., from a database.
+   * Unlike `Add`, the knob is not re-applied.
+   * \param knob The knob to add.
+   * \param decision The decision made for the knob.
+   * \param known_out_mod The IRModule produced by applying the decision to the current out_mod.
+   * \return The new output IRModule.
+   */
+  IRModule AddWithOutMod(Knob knob, String decision, IRModule known_out_mod) {
+    out_mod = known_out_mod;
+    knobs.push_back(knob);
+    decisions.push_back(decision);
+    perf = -1;
+    size++;
+    return out_mod;
+  }
+
   /*!
    * \brief Serialize Trace as a JSON-style object
    * \param include_in_mod Boolean config to include input IRModule in the output.
@@ -369,6 +386,29 @@ class DatabaseNode : public runtime::Object {
    */
   virtual Array<FloatImm> GetMeasurementRecord(const meta_schedule::Workload& workload,
                                                const Target target) = 0;
+  /*!
+   * \brief Look up the output IRModule of a previously recorded trace prefix.
+   * \param workload The workload of the input IRModule of the trace.
+   * \param target The target to be searched for.
+   * \param knobs The knobs of the trace prefix.
+   * \param decisions The decisions of the trace prefix.
+   * \return The output IRModule of the trace prefix if recorded, NullOpt otherwise.
+   */
+  virtual Optional<IRModule> QueryTracePrefix(const meta_schedule::Workload& workload,
+                                              const Target& target, const Array<Knob>& knobs,
+                                              const Array<String>& decisions) = 0;
+  /*!
+   * \brief Record the output IRModule of a trace prefix so that later queries can reuse it.
+   * Unlike tuning records, trace prefixes are kept in memory only.
+   * \param workload The workload of the input IRModule of the trace.
+   * \param target The target the trace prefix is recorded for.
+   * \param knobs The knobs of the trace prefix.
+   * \param decisions The decisions of the trace prefix.
+   * \param out_mod The output IRModule of the trace prefix.
+   */
+  virtual void CommitTracePrefix(const meta_schedule::Workload& workload, const Target& target,
+                                 const Array<Knob>& knobs, const Array<String>& decisions,
+                                 const IRModule& out_mod) = 0;
 
   static constexpr const char* _type_key = "relax.tuning_api.Database";
   TVM_DECLARE_BASE_OBJECT_INFO(DatabaseNode, runtime::Object);
@@ -386,9 +426,13 @@ class Database : public runtime::ObjectRef {
    * \param path_tuning_record The path to the tuning record table.
    * \param path_measurement_record The path to the measurement_record table.
    * \param allow_missing Whether to create new file when the given path is not found.
+   * \param max_records_per_key The maximum number of tuning records kept in memory for each
+   * pair of workload and target. Records beyond the best ones stay in the tuning record file
+   * only. -1 means unbounded.
    */
   TVM_DLL static Database JSONDatabase(String path_workload, String path_tuning_record,
-                                       String path_measurement_record, bool allow_missing);
+                                       String path_measurement_record, bool allow_missing,
+                                       int max_records_per_key = -1);
   TVM_DEFINE_MUTABLE_NOTNULLABLE_OBJECT_REF_METHODS(Database, runtime::ObjectRef, DatabaseNode);
 };
 
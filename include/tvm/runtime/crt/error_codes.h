@@ -80,6 +80,7 @@ typedef enum {
   kTvmErrorPlatformNoMemory = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryPlatform, 3),
   kTvmErrorPlatformTimerBadState = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryPlatform, 4),
   kTvmErrorPlatformStackAllocBadFree = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryPlatform, 5),
+  kTvmErrorPlatformMemoryBadFree = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryPlatform, 6),
 
   // Common error codes returned from generated functions.
   kTvmErrorGeneratedInvalidStorageId = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryGenerated, 0),
@@ -88,6 +89,10 @@ typedef enum {
   kTvmErrorExecutorModuleAlreadyCreated = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryExecutor, 0),
   kTvmErrorExecutorModuleBadContext = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryExecutor, 1),
   kTvmErrorExecutorModuleNoSuchInput = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryExecutor, 2),
+  kTvmErrorExecutorGraphTableInvalid = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryExecutor, 3),
+  kTvmErrorExecutorArenaTooSmall = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryExecutor, 4),
+  kTvmErrorExecutorInputNotSet = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryExecutor, 5),
+  kTvmErrorExecutorOperatorFailed = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryExecutor, 6),
 
   // Function Calls - common problems encountered calling functions.
   kTvmErrorFunctionCallNumArguments = DEFINE_TVM_CRT_ERROR(kTvmErrorCategoryFunctionCall, 0),
@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/runtime/crt/static_graph_executor.h
+ * \brief Graph executor which runs a graph serialized ahead of time, from a static arena.
+ *
+ * Unlike the graph executor, which parses the graph JSON and allocates every tensor when it
+ * starts, the static graph executor runs a table produced at build time by
+ * tvm.micro.serialize_graph_table. The table places all the activations in a single arena and
+ * the executor keeps its own state after them, so it neither parses JSON nor allocates memory.
+ * Graph inputs and parameters are bound by pointer with TVMStaticGraphExecutor_SetInput.
+ */
+#ifndef TVM_RUNTIME_CRT_STATIC_GRAPH_EXECUTOR_H_
+#define TVM_RUNTIME_CRT_STATIC_GRAPH_EXECUTOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <dlpack/dlpack.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/error_codes.h>
+
+struct TVMGraphTableHeader;
+struct TVMGraphTableEntry;
+struct TVMGraphTableOp;
+struct TVMGraphTableInput;
+
+/*! \brief Largest alignment of the activations counted in TVM_STATIC_GRAPH_EXECUTOR_ARENA_SIZE. */
+#define TVM_STATIC_GRAPH_EXECUTOR_MAX_ALIGNMENT 64
+
+/*! \brief A graph executor created by TVMStaticGraphExecutor_Create, kept in its arena. */
+typedef struct TVMStaticGraphExecutor {
+  const struct TVMGraphTableHeader* header;
+  const struct TVMGraphTableEntry* entries;
+  const struct TVMGraphTableOp* ops;
+  const struct TVMGraphTableInput* inputs;
+  const uint32_t* outputs;
+  const char* names;
+  TVMModuleHandle module_handle;
+  /*! \brief The tensors of the graph, by entry id. */
+  DLTensor* tensors;
+  /*! \brief The arguments of all the operators. */
+  TVMValue* arg_values;
+  int* arg_type_codes;
+  /*! \brief The function of each operator. */
+  TVMFunctionHandle* funcs;
+} TVMStaticGraphExecutor;
+
+/*!
+ * \brief Size of the arena needed to run a graph table, in bytes. The arguments are the fields
+ *  of the tvm.micro.GraphTable returned by serialize_graph_table, which also emits this macro in
+ *  GraphTable.to_c_source, so the arena can be a static array.
+ */
+#define TVM_STATIC_GRAPH_EXECUTOR_ARENA_SIZE(activation_bytes, num_entries, num_ops, num_op_args) \
+  (TVM_STATIC_GRAPH_EXECUTOR_MAX_ALIGNMENT + (activation_bytes) +                                 \
+   sizeof(TVMStaticGraphExecutor) + sizeof(DLTensor) * (num_entries) +                            \
+   sizeof(TVMValue) * (num_op_args) + sizeof(TVMFunctionHandle) * (num_ops) +                     \
+   sizeof(int) * (num_op_args))
+
+/*!
+ * \brief Create a static graph executor.
+ *
+ * \param table The graph table, aligned to 8 bytes. It is used until the executor is no longer
+ *     used, so it can stay in flash.
+ * \param table_size Size of `table`, in bytes.
+ * \param module_handle TVM Module that exposes the functions to call.
+ * \param devices runtime execution device.
+ * \param arena The memory of the executor: the activations, then the state of the executor.
+ * \param arena_size Size of `arena`, in bytes. See TVM_STATIC_GRAPH_EXECUTOR_ARENA_SIZE.
+ * \param executor Pointer which receives the executor, which lives in `arena`.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TVMStaticGraphExecutor_Create(const void* table, size_t table_size,
+                                              TVMModuleHandle module_handle,
+                                              const DLDevice* devices, uint8_t* arena,
+                                              size_t arena_size,
+                                              TVMStaticGraphExecutor** executor);
+
+/*!
+ * \brief Get the number of inputs of the graph, parameters included.
+ * \param executor The graph executor.
+ * \return The number of inputs.
+ */
+int TVMStaticGraphExecutor_GetNumInputs(const TVMStaticGraphExecutor* executor);
+
+/*!
+ * \brief Get the index of an input given its name.
+ * \param executor The graph executor.
+ * \param name The name of the input.
+ * \return The index of the input, or -1 when there is no such input.
+ */
+int TVMStaticGraphExecutor_GetInputIndex(const TVMStaticGraphExecutor* executor,
+                                         const char* name);
+
+/*!
+ * \brief Bind an input or a parameter of the graph to the data of a tensor, without a copy.
+ * \param executor The graph executor.
+ * \param name The name of the input.
+ * \param data_in The tensor, whose data must stay valid while the graph runs.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TVMStaticGraphExecutor_SetInput(TVMStaticGraphExecutor* executor,
+                                                const char* name, const DLTensor* data_in);
+
+/*!
+ * \brief Get the number of outputs of the graph.
+ * \param executor The graph executor.
+ * \return The number of outputs.
+ */
+int TVMStaticGraphExecutor_GetNumOutputs(const TVMStaticGraphExecutor* executor);
+
+/*!
+ * \brief Copy an output of the graph.
+ * \param executor The graph executor.
+ * \param index The output index.
+ * \param out The tensor which receives the output.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TVMStaticGraphExecutor_GetOutput(const TVMStaticGraphExecutor* executor,
+                                                 int32_t index, DLTensor* out);
+
+/*!
+ * \brief Execute the graph. All the inputs must have been set.
+ * \param executor The graph executor.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TVMStaticGraphExecutor_Run(TVMStaticGraphExecutor* executor);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_STATIC_GRAPH_EXECUTOR_H_
@@ -0,0 +1,87 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/runtime/crt/tlsf_allocator.h
+ * \brief A Two-Level Segregated Fit (TLSF) memory allocator for microcontrollers.
+ *
+ * Unlike the page allocator, adjacent free blocks are merged when memory is freed, so a
+ * long-running application does not fragment the memory pool. Allocate and Free run in
+ * constant time. Select it instead of the page allocator by defining
+ * TVM_CRT_USE_TLSF_ALLOCATOR in crt_config.h.
+ */
+
+#ifndef TVM_RUNTIME_CRT_TLSF_ALLOCATOR_H_
+#define TVM_RUNTIME_CRT_TLSF_ALLOCATOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/page_allocator.h>
+
+/*! \brief Usage statistics of a TLSF memory manager. */
+typedef struct TLSFMemoryStats {
+  /*! \brief Number of bytes in allocated blocks. */
+  size_t used_bytes;
+  /*! \brief Largest value of used_bytes since the memory manager was created. */
+  size_t peak_used_bytes;
+  /*! \brief Number of allocated blocks. */
+  size_t num_used_blocks;
+  /*! \brief Number of bytes in free blocks. */
+  size_t free_bytes;
+  /*! \brief Number of free blocks. */
+  size_t num_free_blocks;
+  /*!
+   * \brief Size of the largest free block, in bytes. The pool is fragmented when it is much
+   *  smaller than free_bytes.
+   */
+  size_t largest_free_block_bytes;
+} TLSFMemoryStats;
+
+/*!
+ * \brief Create a TLSF memory manager.
+ *
+ * \param manager Pointer, initialized with the new MemoryManager.
+ * \param memory_pool Pointer to the global memory pool used by the CRT. The memory manager keeps
+ *     its state at the beginning of the pool.
+ * \param memory_pool_size_bytes Size of `memory_pool`, in bytes.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TLSFMemoryManagerCreate(MemoryManagerInterface** manager, uint8_t* memory_pool,
+                                        size_t memory_pool_size_bytes);
+
+/*!
+ * \brief Get the usage statistics of a TLSF memory manager.
+ *
+ * \param manager A memory manager created by TLSFMemoryManagerCreate.
+ * \param stats Pointer which receives the statistics.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TLSFMemoryManagerGetStats(MemoryManagerInterface* manager,
+                                          TLSFMemoryStats* stats);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_TLSF_ALLOCATOR_H_
@@ -35,6 +35,9 @@
 
 namespace tvm {
 namespace runtime {
+
+class ParallelLoader;
+
 namespace relax_vm {
 
 /*!
@@ -148,6 +151,14 @@ class Executable : public runtime::ModuleNode {
    * \return The loaded executable, in the form of a `runtime::Module`.
    */
   static Module LoadFromFile(const std::string& file_name);
+  /*!
+   * \brief Load Executable from its serialized content in memory, copying the NDArray
+   *  constants with a ParallelLoader whose profile is kept, see runtime.GetLoadProfile.
+   * \param data The serialized content, which is only used during the call.
+   * \param size The size of the serialized content.
+   * \return The loaded executable, in the form of a `runtime::Module`.
+   */
+  static Module LoadFromMemory(char* data, size_t size);
 
   /*! \brief The virtual machine's function table. */
   std::vector<VMFunction> global_funcs;
@@ -199,9 +210,13 @@ class Executable : public runtime::ModuleNode {
   void LoadGlobalSection(dmlc::Stream* strm);
   /*!
    * \brief Load the constant pool.
-   * \param strm The input stream.
+   * \param strm The input stream over the memory at base.
+   * \param base The memory the stream reads, which must stay valid until the loader runs.
+   * \param nbytes The size of the memory at base.
+   * \param loader The loader to which the data of the NDArray constants is added.
    */
-  void LoadConstantSection(dmlc::Stream* strm);
+  void LoadConstantSection(dmlc::SeekStream* strm, const char* base, size_t nbytes,
+                           ParallelLoader* loader);
   /*!
    * \brief Load the instructions.
    * \param strm The input stream.
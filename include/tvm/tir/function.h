@@ -98,6 +98,11 @@ class PrimFuncNode : public BaseFuncNode {
    *  flattened alias of the buffer.
    */
   Map<tir::Var, Buffer> buffer_map;
+  /*!
+   * \brief The cached structural hash of the function, not visited.
+   * \note PrimFunc::CopyOnWrite clears it, as the function may be mutated afterwards.
+   */
+  StructuralHashCache shash_cache;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("params", &params);
@@ -165,7 +170,22 @@ class PrimFunc : public BaseFunc {
                    DictAttrs attrs = NullValue<DictAttrs>(), Span span = Span());
 
   TVM_DEFINE_OBJECT_REF_METHODS(PrimFunc, BaseFunc, PrimFuncNode);
-  TVM_DEFINE_OBJECT_REF_COW_METHOD(PrimFuncNode);
+
+  /*!
+   * \brief Copy-on-write, also invalidating the cached structural hash
+   *  since the returned node may be mutated in place.
+   * \return The mutable node.
+   */
+  PrimFuncNode* CopyOnWrite() {
+    ICHECK(data_ != nullptr);
+    if (!data_.unique()) {
+      auto n = make_object<PrimFuncNode>(*(operator->()));
+      ObjectPtr<Object>(std::move(n)).swap(data_);
+    }
+    PrimFuncNode* node = static_cast<PrimFuncNode*>(data_.get());
+    node->shash_cache.Clear();
+    return node;
+  }
 };
 
 /*!
@@ -56,7 +56,8 @@ using tvm::transform::Sequential;
  */
 TVM_DLL Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required, bool traceable = false);
+    int opt_level, String name, tvm::Array<String> required, bool traceable = false,
+    bool thread_safe = false);
 
 /*!
  * \brief Inject prefetch instructions into stmt.
@@ -91,6 +91,7 @@ class Analyzer:
         self._int_set = _mod("int_set")
         self._enter_constraint_context = _mod("enter_constraint_context")
         self._can_prove_equal = _mod("can_prove_equal")
+        self._enable_simplify_cache = _mod("enable_simplify_cache")
 
     def const_int_bound(self, expr):
         """Find constant integer bound for expr.
@@ -142,6 +143,19 @@ class Analyzer:
         """
         return self._simplify(expr, steps)
 
+    def enable_simplify_cache(self, max_entries=4096):
+        """Memoize the results of simplify.
+
+        The results are cached per expression under the current constraint context,
+        and are invalidated whenever a variable is bound.
+
+        Parameters
+        ----------
+        max_entries : int
+            The maximum number of cached results, 0 disables the cache.
+        """
+        self._enable_simplify_cache(max_entries)
+
     def rewrite_simplify(self, expr):
         """Simplify expression via rewriting rules.
 
@@ -207,6 +207,25 @@ class GraphModule(object):
             self.set_input(**input_dict)
         self._run()
 
+    def set_parallel(self, num_workers, intra_op_threads=0):
+        """Run the operators of the graph on a pool of workers.
+
+        Each operator runs as soon as the operators it depends on are done,
+        so that independent branches of the graph run at the same time.
+        Only graphs on CPU devices are run in parallel.
+
+        Parameters
+        ----------
+        num_workers : int
+            The number of workers. 0 or 1 runs the operators one by one.
+
+        intra_op_threads : int
+            The number of threads each worker runs an operator with.
+            0 splits the cores evenly between the workers. Each worker
+            is pinned to its own cores if there are enough of them.
+        """
+        self.module["set_parallel"](num_workers, intra_op_threads)
+
     def get_num_outputs(self):
         """Get the number of outputs from the graph
 
@@ -325,6 +344,17 @@ class GraphModule(object):
         """
         self._load_params(bytearray(params_bytes))
 
+    def load_params_from_file(self, path):
+        """Load parameters from a file directly into the storage of the module.
+
+        Parameters
+        ----------
+        path : str
+            The path to a file saved by :py:func:`tvm.runtime.save_param_file`,
+            or containing the bytes of :py:func:`tvm.runtime.save_param_dict`.
+        """
+        self.module["load_params_from_file"](path)
+
     def share_params(self, other, params_bytes):
         """Share parameters from pre-existing GraphExecutor instance.
 
@@ -338,6 +368,21 @@ class GraphModule(object):
         """
         self._share_params(other.module, bytearray(params_bytes))
 
+    def create_instance(self):
+        """Create another executor of the same graph, e.g. to serve requests concurrently.
+
+        The new executor reuses the graph, the compiled operators and the
+        parameters of this one, and only allocates its own storage for the
+        inputs, outputs and intermediate results. The values of the other
+        inputs, e.g. weights given to set_input, are copied into it.
+
+        Returns
+        -------
+        instance : GraphModule
+            The new executor. Setting a parameter on it changes it for this one too.
+        """
+        return GraphModule(self.module["create_instance"]())
+
     def __getitem__(self, key):
         """Get internal module function
 
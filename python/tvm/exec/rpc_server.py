@@ -49,6 +49,7 @@ def main(args):
         custom_addr=args.custom_addr,
         silent=args.silent,
         no_fork=not args.fork,
+        copy_cache=args.copy_cache,
     )
     server.proc.join()
 
@@ -90,6 +91,11 @@ if __name__ == "__main__":
     parser.add_argument(
         "--custom-addr", type=str, help="Custom IP Address to Report to RPC Tracker"
     )
+    parser.add_argument(
+        "--copy-cache",
+        action="store_true",
+        help="Keep the arrays copied into the sessions so that later sessions can skip them.",
+    )
 
     parser.set_defaults(fork=True)
     args = parser.parse_args()
@@ -202,3 +202,24 @@ def is_relax_expr(expr: RelayExpr) -> bool:
     ):
         return True
     return False
+
+
+def set_int_imm_interning(enabled: bool) -> bool:
+    """Enable or disable the interning of small integer constants.
+
+    When enabled, IntImm constants of dtype int32/int64 in [-16, 256) and
+    booleans constructed without a span share one node per dtype and value.
+    Code that keys on node identity then sees these constants as one node,
+    so interning is disabled by default.
+
+    Parameters
+    ----------
+    enabled : bool
+        Whether to intern the constants constructed from now on.
+
+    Returns
+    -------
+    prev : bool
+        Whether interning was enabled before.
+    """
+    return bool(_ffi_api.SetIntImmInterning(enabled))
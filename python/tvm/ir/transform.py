@@ -42,11 +42,18 @@ class PassInfo(tvm.runtime.Object):
 
     required : List[str]
         The list of passes that are required by a certain pass.
+
+    traceable : bool
+        Whether the pass is traceable.
+
+    thread_safe : bool
+        Whether a function-level pass can process different functions concurrently.
+        Takes effect when "ir.function_pass_num_threads" is set in the PassContext.
     """
 
-    def __init__(self, opt_level, name, required=None, traceable=False):
+    def __init__(self, opt_level, name, required=None, traceable=False, thread_safe=False):
         self.__init_handle_by_constructor__(
-            _ffi_transform_api.PassInfo, opt_level, name, required, traceable
+            _ffi_transform_api.PassInfo, opt_level, name, required, traceable, thread_safe
         )
 
 
@@ -44,6 +44,12 @@ class JSONDatabase(Database):
                             given module. The "ignore-ndarray" varint is used for the extracted
                             blocks or in case no anchor block is found.
                             For the definition of the anchor block, see tir/analysis/analysis.py.
+          - "anchor-block-schema": Same as "anchor-block" for equality testing, but only
+                                   hash the schema of the anchor block, which is cheap and
+                                   independent of shape constants.
+
+    The workload hashes stored in path_workload are trusted when the database is loaded. A
+    lookup compares the modules whose hashes match, so collisions are resolved lazily.
     """
 
     path_workload: str
@@ -34,6 +34,7 @@ class GradientBased(TaskScheduler):
         alpha: float = 0.2,
         window_size: int = 3,
         seed: int = -1,
+        max_inflight_batches: int = 0,
     ) -> None:
         """Constructor.
 
@@ -45,6 +46,9 @@ class GradientBased(TaskScheduler):
             The parameter to control backward window size in gradient computation.
         seed : int = -1
             The random seed.
+        max_inflight_batches : int = 0
+            The maximum number of measurement batches kept in flight across tasks. If positive,
+            candidates are built and measured in the background while the next task is searched.
         """
         self.__init_handle_by_constructor__(
             _ffi_api.TaskSchedulerGradientBased,  # type: ignore # pylint: disable=no-member
@@ -52,4 +56,5 @@ class GradientBased(TaskScheduler):
             alpha,
             window_size,
             seed,
+            max_inflight_batches,
         )
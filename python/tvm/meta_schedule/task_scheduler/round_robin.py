@@ -28,9 +28,17 @@ logger = get_logger(__name__)  # pylint: disable=invalid-name
 class RoundRobin(TaskScheduler):
     """Round Robin Task Scheduler"""
 
-    def __init__(self) -> None:
-        """Constructor."""
+    def __init__(self, *, max_inflight_batches: int = 0) -> None:
+        """Constructor.
+
+        Parameters
+        ----------
+        max_inflight_batches : int = 0
+            The maximum number of measurement batches kept in flight across tasks. If positive,
+            candidates are built and measured in the background while the next task is searched.
+        """
         self.__init_handle_by_constructor__(
             _ffi_api.TaskSchedulerRoundRobin,  # type: ignore # pylint: disable=no-member
             get_logging_func(logger),
+            max_inflight_batches,
         )
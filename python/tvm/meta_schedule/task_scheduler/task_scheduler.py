@@ -62,6 +62,7 @@ class TaskScheduler(Object):
     database_: Optional[Database]
     cost_model_: Optional[CostModel]
     remaining_tasks_: int
+    max_inflight_batches: int
 
     TaskSchedulerType = Union["TaskScheduler", Literal["gradient", "round-robin"]]
 
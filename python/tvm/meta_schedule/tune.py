@@ -80,6 +80,8 @@ def tune_tasks(
                             given module. The "ignore-ndarray" varint is used for the extracted
                             blocks or in case no anchor block is found.
                             For the definition of the anchor block, see tir/analysis/analysis.py.
+          - "anchor-block-schema": Same as "anchor-block" with a cheaper hash, see
+                                   tvm.meta_schedule.database.JSONDatabase.
 
     Returns
     -------
@@ -0,0 +1,287 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""Serializes graph executor JSON into the binary table run by the CRT static graph executor.
+
+The CRT graph executor parses the graph JSON and allocates every storage entry when it starts.
+The table produced here is parsed ahead of time instead: it lists the operators, their
+arguments and the tensors they use, and places every activation at a fixed offset of a single
+arena. Storage entries whose lifetimes do not overlap share the same bytes of the arena.
+
+The layout must be kept identical to src/runtime/crt/include/tvm/runtime/crt/internal/
+graph_executor/graph_table.h. All fields are little-endian:
+
+    header   uint32[12]: magic, version, num_entries, num_ops, num_op_args, num_inputs,
+                         num_outputs, num_shape_dims, names_bytes, activation_bytes,
+                         alignment, reserved
+    shapes   int64[num_shape_dims]
+    entries  uint32[num_entries][4]: arena offset, dtype, ndim, index of the first dim in shapes
+    ops      uint32[num_ops][3]: offset of the name in names, index of the first arg, num args
+    op_args  uint32[num_op_args]: entry of each argument, inputs first
+    inputs   uint32[num_inputs][2]: offset of the name in names, entry
+    outputs  uint32[num_outputs]: entry
+    names    NUL-terminated strings, padded to make the size of the table a multiple of 8
+"""
+
+import json
+import re
+import struct
+import typing
+
+GRAPH_TABLE_MAGIC = 0x4C425447  # "GTBL"
+GRAPH_TABLE_VERSION = 1
+
+# Arena offset of the entries bound by the application through SetInput.
+EXTERNAL_OFFSET = 0xFFFFFFFF
+
+_DTYPE_CODES = {"int": 0, "uint": 1, "float": 2, "bfloat": 4}
+
+
+class GraphTableError(Exception):
+    """Raised when a graph cannot be run by the CRT static graph executor."""
+
+
+def _parse_dtype(dtype: str) -> typing.Tuple[int, int, int]:
+    if dtype == "bool":
+        return _DTYPE_CODES["uint"], 1, 1
+    match = re.fullmatch(r"(int|uint|float|bfloat)(\d+)(?:x(\d+))?", dtype)
+    if match is None:
+        raise GraphTableError(f"Unsupported data type: {dtype}")
+    lanes = int(match.group(3)) if match.group(3) else 1
+    return _DTYPE_CODES[match.group(1)], int(match.group(2)), lanes
+
+
+def _align(value: int, alignment: int) -> int:
+    return (value + alignment - 1) // alignment * alignment
+
+
+class GraphTable:
+    """A graph serialized for the CRT static graph executor.
+
+    Parameters
+    ----------
+    data : bytes
+        The serialized table.
+
+    activation_bytes : int
+        Size of the activation arena, in bytes.
+
+    num_entries : int
+        Number of tensors of the graph.
+
+    num_ops : int
+        Number of operators of the graph.
+
+    num_op_args : int
+        Total number of operator arguments.
+
+    storage_offsets : Dict[int, int]
+        The arena offset of each storage id, except the ones of the graph inputs.
+    """
+
+    def __init__(self, data, activation_bytes, num_entries, num_ops, num_op_args, storage_offsets):
+        self.data = data
+        self.activation_bytes = activation_bytes
+        self.num_entries = num_entries
+        self.num_ops = num_ops
+        self.num_op_args = num_op_args
+        self.storage_offsets = storage_offsets
+
+    def to_c_source(self, name: str) -> str:
+        """Return a C source defining the table as `<name>_graph_table` and the size of the
+        arena to pass to TVMStaticGraphExecutor_Create as `<name>_ARENA_SIZE`.
+
+        The table is emitted as an array of uint64_t, which keeps it aligned and lets it stay
+        in flash.
+        """
+        data = self.data + b"\0" * (_align(len(self.data), 8) - len(self.data))
+        words = struct.unpack(f"<{len(data) // 8}Q", data)
+        lines = [
+            "#include <stdint.h>",
+            "#include <tvm/runtime/crt/static_graph_executor.h>",
+            "",
+            f"#define {name.upper()}_ARENA_SIZE TVM_STATIC_GRAPH_EXECUTOR_ARENA_SIZE("
+            f"{self.activation_bytes}, {self.num_entries}, {self.num_ops}, {self.num_op_args})",
+            "",
+            f"const uint64_t {name}_graph_table[{len(words)}] = {{",
+        ]
+        for i in range(0, len(words), 4):
+            lines.append("  " + " ".join(f"0x{w:016x}ULL," for w in words[i : i + 4]))
+        lines.append("};")
+        return "\n".join(lines) + "\n"
+
+
+def _plan_arena(sizes, lifetimes, alignment):
+    """Place each storage id in the arena, largest first, at the lowest offset which does not
+    overlap a storage id already placed and live at the same time."""
+    offsets = {}
+    arena_bytes = 0
+    for sid in sorted(sizes, key=lambda s: (-sizes[s], s)):
+        first, last = lifetimes[sid]
+        conflicts = sorted(
+            (offsets[other], offsets[other] + sizes[other])
+            for other in offsets
+            if lifetimes[other][0] <= last and first <= lifetimes[other][1]
+        )
+        offset = 0
+        for begin, end in conflicts:
+            if offset + sizes[sid] <= begin:
+                break
+            offset = max(offset, _align(end, alignment))
+        offsets[sid] = offset
+        arena_bytes = max(arena_bytes, offset + sizes[sid])
+    return offsets, _align(arena_bytes, alignment)
+
+
+def serialize_graph_table(graph_json: str, alignment: int = 64) -> GraphTable:
+    """Serialize a graph executor JSON into a table for the CRT static graph executor.
+
+    Graph inputs and parameters get no storage in the arena: the application binds them with
+    TVMStaticGraphExecutor_SetInput, for example to parameters kept in flash.
+
+    Parameters
+    ----------
+    graph_json : str
+        The graph, as returned by tvm.relay.build().
+
+    alignment : int
+        Alignment of each tensor in the arena, in bytes. A power of two from 8 to 64.
+
+    Returns
+    -------
+    GraphTable :
+        The serialized graph.
+    """
+    if alignment < 8 or alignment > 64 or alignment & (alignment - 1):
+        raise GraphTableError(f"alignment must be a power of two from 8 to 64, got {alignment}")
+    graph = json.loads(graph_json)
+    nodes = graph["nodes"]
+    attrs = graph["attrs"]
+    node_row_ptr = graph["node_row_ptr"]
+    storage_ids = attrs["storage_id"][1]
+    dltypes = attrs["dltype"][1]
+    shapes = attrs["shape"][1]
+    arg_nodes = set(graph["arg_nodes"])
+    num_entries = node_row_ptr[-1]
+
+    def entry_id(node_entry):
+        return node_row_ptr[node_entry[0]] + node_entry[1]
+
+    names = bytearray()
+    name_offsets = {}
+
+    def add_name(name):
+        if name not in name_offsets:
+            name_offsets[name] = len(names)
+            names.extend(name.encode("utf-8") + b"\0")
+        return name_offsets[name]
+
+    inputs = []
+    input_eids = set()
+    for nid in sorted(arg_nodes):
+        inputs.append((add_name(nodes[nid]["name"]), node_row_ptr[nid]))
+        input_eids.update(range(node_row_ptr[nid], node_row_ptr[nid + 1]))
+    external_sids = {storage_ids[eid] for eid in input_eids}
+    for eid in range(num_entries):
+        if eid not in input_eids and storage_ids[eid] in external_sids:
+            raise GraphTableError(f"Storage {storage_ids[eid]} is shared by an input and an op")
+
+    # The lifetime of each storage id is the range of operators which use it.
+    ops = []
+    op_args = []
+    sizes = {}
+    lifetimes = {}
+
+    def use(eid, op_index):
+        sid = storage_ids[eid]
+        if sid in external_sids:
+            return
+        _, bits, lanes = _parse_dtype(dltypes[eid])
+        nbytes = (bits * lanes + 7) // 8
+        for dim in shapes[eid]:
+            nbytes *= dim
+        sizes[sid] = max(sizes.get(sid, 0), nbytes)
+        first, last = lifetimes.get(sid, (op_index, op_index))
+        lifetimes[sid] = (min(first, op_index), max(last, op_index))
+
+    for nid, node in enumerate(nodes):
+        if node["op"] == "null":
+            if nid not in arg_nodes:
+                raise GraphTableError(f"Node {node['name']} has no operator and is not an input")
+            continue
+        if node["op"] != "tvm_op":
+            raise GraphTableError(f"Can only take tvm_op as op, but {node['op']} is found")
+        op_attrs = node["attrs"]
+        func_name = op_attrs["func_name"]
+        if func_name in ("__nop", "__copy"):
+            raise GraphTableError(f"{func_name} function is not supported")
+        if int(op_attrs.get("flatten_data", "0")):
+            raise GraphTableError(f"{func_name}: flatten_data is not supported")
+        op_index = len(ops)
+        args = [entry_id(e) for e in node["inputs"]]
+        args += [node_row_ptr[nid] + i for i in range(int(op_attrs["num_outputs"]))]
+        for eid in args:
+            use(eid, op_index)
+        ops.append((add_name(func_name), len(op_args), len(args)))
+        op_args.extend(args)
+
+    outputs = [entry_id(e) for e in graph["heads"]]
+    for eid in outputs:
+        use(eid, len(ops))
+
+    storage_offsets, activation_bytes = _plan_arena(sizes, lifetimes, alignment)
+
+    shape_dims = []
+    entries = []
+    for eid in range(num_entries):
+        code, bits, lanes = _parse_dtype(dltypes[eid])
+        sid = storage_ids[eid]
+        offset = EXTERNAL_OFFSET if sid in external_sids else storage_offsets.get(sid, 0)
+        dtype = code | (bits << 8) | (lanes << 16)
+        entries.append((offset, dtype, len(shapes[eid]), len(shape_dims)))
+        shape_dims.extend(shapes[eid])
+
+    body = bytearray(struct.pack(f"<{len(shape_dims)}q", *shape_dims))
+    for entry in entries:
+        body += struct.pack("<4I", *entry)
+    for op in ops:
+        body += struct.pack("<3I", *op)
+    body += struct.pack(f"<{len(op_args)}I", *op_args)
+    for graph_input in inputs:
+        body += struct.pack("<2I", *graph_input)
+    body += struct.pack(f"<{len(outputs)}I", *outputs)
+    # Pad the names so the size of the table is a multiple of 8 bytes.
+    names.extend(b"\0" * (_align(len(body) + len(names), 8) - len(body) - len(names)))
+    body += names
+    header = (
+        GRAPH_TABLE_MAGIC,
+        GRAPH_TABLE_VERSION,
+        num_entries,
+        len(ops),
+        len(op_args),
+        len(inputs),
+        len(outputs),
+        len(shape_dims),
+        len(names),
+        activation_bytes,
+        alignment,
+        0,
+    )
+    data = struct.pack("<12I", *header) + body
+    return GraphTable(
+        bytes(data), activation_bytes, num_entries, len(ops), len(op_args), storage_offsets
+    )
@@ -249,3 +249,27 @@ def called_global_vars(expr: Expr) -> List[GlobalVar]:
         in post-DFS order
     """
     return _ffi_api.called_global_vars(expr)  # type: ignore
+
+
+def estimate_fusion_cost(mod: tvm.IRModule, group: Dict[Var, Expr]) -> Dict[str, int]:
+    """
+    Estimate the memory traffic of running a group of bindings as one fused kernel, from the
+    buffers of the PrimFuncs they call with call_tir. This is the estimate the "analytical"
+    cost model of FuseOps relies on.
+
+    Parameters
+    ----------
+    mod: tvm.IRModule
+        The module holding the PrimFuncs called by the bindings.
+
+    group: Dict[Var, Expr]
+        The bindings of the group, from bound var to value.
+
+    Returns
+    -------
+    ret: Dict[str, int]
+        The estimate, with keys "bytes_moved_unfused", "bytes_moved_fused", "bytes_saved",
+        "working_set_bytes", "store_iterations", "intensity" (store iterations per byte moved
+        by the fused kernel), "has_reduction" and "known".
+    """
+    return _ffi_api.estimate_fusion_cost(mod, group)  # type: ignore
@@ -65,6 +65,7 @@ class PatternContext(tvm.runtime.Object):
         dfb: DataflowBlock,
         start_hint: Optional[Var] = None,
         must_include_hint: bool = False,
+        use_index: bool = True,
     ) -> Dict[DFPattern, Var]:
         """
         Match a DataflowBlock via a graph of DFPattern and corresponding constraints
@@ -77,10 +78,13 @@ class PatternContext(tvm.runtime.Object):
             Indicating the starting expression to match, by default None
         must_include_hint : bool, optional
             Whether the start_hint expression must be matched, by default False
+        use_index : bool, optional
+            Whether to look up the candidates of each pattern by op and memoize the node-level
+            matches, by default True. Disabling it is only useful to measure the index.
 
         Returns
         -------
         Dict[DFPattern, Var]
             The mapping from DFPattern to matched expression
         """
-        return ffi.match_dfb(self, dfb, start_hint, must_include_hint)  # type: ignore
+        return ffi.match_dfb(self, dfb, start_hint, must_include_hint, use_index)  # type: ignore
@@ -273,6 +273,15 @@ def FuseOps(fuse_opt_level=-1) -> tvm.ir.transform.Pass:
 
     A follow-up pass named "FuseTIR" will generate a TIR PrimFunc for each grouped function.
 
+    When the PassContext config "relax.FuseOps.cost_model" is set, every fusion allowed by the op
+    patterns is also checked by a cost model. "analytical" selects the built-in model, which
+    refuses to fuse a reduction once the working set of the fused kernel exceeds
+    "relax.FuseOps.cache_bytes", unless the fused kernel is compute bound, i.e. its arithmetic
+    intensity (innermost loop iterations per byte moved) is high. Any other value names a
+    registered global function that takes the module and the bindings of the candidate group
+    and returns whether to fuse. For debugging, setting "relax.FuseOps.report" records each
+    decision and its estimated memory traffic saved in the "fusion_report" module attribute.
+
     Parameters
     ----------
     fuse_opt_level : int
@@ -290,6 +299,10 @@ def FuseOps(fuse_opt_level=-1) -> tvm.ir.transform.Pass:
 def FuseTIR() -> tvm.ir.transform.Pass:
     """Fuse primitive relax function into a larger TIR function if possible
 
+    When the PassContext config "relax.FuseTIR.reuse_intermediate_buffers" is set, an intermediate
+    buffer of the fused function reuses the memory of an earlier intermediate buffer of the same
+    shape and dtype that is no longer read, which reduces the workspace of long fused chains.
+
     Returns
     -------
     ret : tvm.transform.Pass
@@ -298,6 +311,22 @@ def FuseTIR() -> tvm.ir.transform.Pass:
     return _ffi_api.FuseTIR()  # type: ignore
 
 
+def HorizontalFuseTIR() -> tvm.ir.transform.Pass:
+    """Batch independent call_tir bindings that invoke the same PrimFunc into a single call_tir.
+
+    Within a dataflow block, calls to structurally equal schedulable PrimFuncs whose arguments are
+    all available before the first of them are replaced by one call to a new PrimFunc that runs
+    the bodies of all the original kernels. The original vars are bound to the fields of its tuple
+    output, so one kernel is dispatched instead of many.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass for horizontal tir fusion.
+    """
+    return _ffi_api.HorizontalFuseTIR()  # type: ignore
+
+
 def MetaScheduleApplyDatabase(
     work_dir: Optional[str] = None,
     module_equality: str = "structural",
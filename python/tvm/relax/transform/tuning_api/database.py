@@ -25,7 +25,7 @@ from tvm.meta_schedule.database import Workload
 from tvm.tir.schedule.trace import JSON_TYPE
 from tvm.target import Target
 from tvm._ffi import register_object
-from .primitives import Trace
+from .primitives import Knob, Trace
 from . import _ffi_api
 
 logger = logging.getLogger("TuningAPI")  # pylint: disable=invalid-name
@@ -223,6 +223,59 @@ class Database(Object):
         """
         return _ffi_api.DatabaseGetTopK(self, workload, target, top_k)  # type: ignore # pylint: disable=no-member
 
+    def query_trace_prefix(
+        self,
+        workload: Workload,
+        target: Target,
+        knobs: List[Knob],
+        decisions: List[str],
+    ) -> Optional[IRModule]:
+        """Look up the output IRModule of a previously recorded trace prefix.
+
+        Parameters
+        ----------
+        workload : Workload
+            The workload of the input IRModule of the trace.
+        target: Target
+            The target to be searched for.
+        knobs : List[Knob]
+            The knobs of the trace prefix.
+        decisions : List[str]
+            The decisions of the trace prefix.
+
+        Returns
+        -------
+        out_mod : Optional[IRModule]
+            The output IRModule of the trace prefix if recorded, None otherwise.
+        """
+        return _ffi_api.DatabaseQueryTracePrefix(self, workload, target, knobs, decisions)  # type: ignore # pylint: disable=no-member
+
+    def commit_trace_prefix(
+        self,
+        workload: Workload,
+        target: Target,
+        knobs: List[Knob],
+        decisions: List[str],
+        out_mod: IRModule,
+    ) -> None:
+        """Record the output IRModule of a trace prefix so that later queries can reuse it.
+        Unlike tuning records, trace prefixes are kept in memory only.
+
+        Parameters
+        ----------
+        workload : Workload
+            The workload of the input IRModule of the trace.
+        target: Target
+            The target the trace prefix is recorded for.
+        knobs : List[Knob]
+            The knobs of the trace prefix.
+        decisions : List[str]
+            The decisions of the trace prefix.
+        out_mod : IRModule
+            The output IRModule of the trace prefix.
+        """
+        _ffi_api.DatabaseCommitTracePrefix(self, workload, target, knobs, decisions, out_mod)  # type: ignore # pylint: disable=no-member
+
 
 @register_object("relax.tuning_api.JSONDatabase")
 class JSONDatabase(Database):
@@ -238,11 +291,14 @@ class JSONDatabase(Database):
     path_measurement_record : str
         The path to the path_measurement_record table.
         Manages pairs of <Workload (out_mod), run_secs>
+    max_records_per_key : int
+        The maximum number of tuning records kept in memory for each pair of workload and target.
     """
 
     path_workload: str
     path_tuning_record: str
     path_measurement_record: str
+    max_records_per_key: int
 
     def __init__(
         self,
@@ -250,6 +306,7 @@ class JSONDatabase(Database):
         path_tuning_record: str,
         path_measurement_record: str,
         allow_missing: bool = True,
+        max_records_per_key: int = -1,
     ) -> None:
         """Constructor.
 
@@ -263,6 +320,10 @@ class JSONDatabase(Database):
             The path to the path_measurement_record table.
         allow_missing : bool
             Whether to create new file when the given path is not found.
+        max_records_per_key : int
+            The maximum number of tuning records kept in memory for each pair of workload and
+            target. Only the fastest records are kept; the others stay in the tuning record file.
+            -1 means unbounded.
         """
         self.__init_handle_by_constructor__(
             _ffi_api.DatabaseJSONDatabase,  # type: ignore # pylint: disable=no-member
@@ -270,4 +331,5 @@ class JSONDatabase(Database):
             path_tuning_record,
             path_measurement_record,
             allow_missing,
+            max_records_per_key,
         )
@@ -15,7 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """Relax Tuning Pass API default functions"""
-from typing import Dict, List, Optional
+from typing import Dict, List, Optional, Union
 import sys
 import itertools
 import logging
@@ -35,6 +35,7 @@ from tvm.meta_schedule.runner import (
 )
 from tvm._ffi.registry import register_func
 from .primitives import Knob, Trace
+from .database import TuningRecord
 
 logger = logging.getLogger("TuningAPI")  # pylint: disable=invalid-name
 
@@ -52,7 +53,10 @@ def default_constr_func(mod: IRModule) -> bool:  # pylint: disable=unused-argume
 
 @register_func("relax.tuning_api.default_generate_candidate")
 def default_generate_candidate(
-    knobs: List[Knob], trace: Trace, eval_passes: Optional[List[Pass]] = None
+    knobs: List[Knob],
+    trace: Trace,
+    eval_passes: Optional[List[Pass]] = None,
+    target: Optional[Union[str, tvm.target.Target]] = None,
 ) -> List[Trace]:
     """
     Default function to generate the search space for a given trace by using registered choices.
@@ -73,6 +77,10 @@ def default_generate_candidate(
     eval_passes: Optional[List[Pass]]
         List of passes to consider to evaluate each candidate.
         This will enable joint-optimization.
+    target: Optional[Union[str, tvm.target.Target]]
+        Target the candidates are evaluated on. If given, decision histories
+        recorded for it in the tuning API database are not re-applied, and
+        every newly applied decision history is recorded as a trace prefix.
 
     Return
     ----------
@@ -80,6 +88,16 @@ def default_generate_candidate(
         List of candidate traces
     """
 
+    # Decision histories recorded before for the target are not re-applied;
+    # their output IRModules are reused from the database. Every prefix applied
+    # here is recorded so that later generations can reuse it as well.
+    database = PassContext.current().get_tuning_api_database()
+    if isinstance(target, str):
+        target = tvm.target.Target(target)
+    workload = None
+    if database is not None and target is not None:
+        workload = database.commit_workload(trace.in_mod)
+
     candidates = [trace]
     # Iterate over every decision
     for knob in knobs:
@@ -91,7 +109,23 @@ def default_generate_candidate(
                 # Generate new candidate when this condition satisfies.
                 if choice.check_constr(cur_trace.out_mod):
                     new_trace = cur_trace.deepcopy()
-                    new_trace.add(knob, decision)
+                    known_out_mod = None
+                    if workload is not None:
+                        known_out_mod = database.query_trace_prefix(
+                            workload,
+                            target,
+                            list(new_trace.knobs) + [knob],
+                            list(new_trace.decisions) + [decision],
+                        )
+                    new_trace.add(knob, decision, known_out_mod)
+                    if workload is not None and known_out_mod is None:
+                        database.commit_trace_prefix(
+                            workload,
+                            target,
+                            new_trace.knobs,
+                            new_trace.decisions,
+                            new_trace.out_mod,
+                        )
                     candidates.append(new_trace)
 
     # Expand candidates by using eval passes if provided. This will enable joint-optimization.
@@ -145,6 +179,7 @@ def default_evaluate(
     params: Optional[Dict[str, np.ndarray]] = None,
     builder: Optional[meta_schedule.builder.Builder] = None,
     runner: Optional[meta_schedule.runner.Runner] = None,
+    record_traces: bool = False,
 ) -> None:
     """
     Default function to evaluate a set of candidate traces by using MetaSchedule builder/runner.
@@ -161,6 +196,9 @@ def default_evaluate(
         builder function. If not provided, default local builder will be used.
     runner: Optional[meta_schedule.runner.Runner]
         runner function. If not provided, default local runner will be used.
+    record_traces: bool
+        Whether to commit a tuning record of each evaluated candidate, so that
+        default_generate_candidate can reuse its decision history for this target.
     """
 
     ctx = PassContext.current()
@@ -276,6 +314,11 @@ def default_evaluate(
 
         # Store the evaluation result
         candidate.set_perf(np.mean(perfs))
+        # Record the trace so that its decision history can be reused as a prefix.
+        if record_traces:
+            database.commit_tuning_record(
+                database.commit_workload(candidate.in_mod), target, TuningRecord(candidate, perfs)
+            )
 
     ctx.inc_num_evals(num_evals)
 
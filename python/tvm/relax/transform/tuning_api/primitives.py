@@ -300,10 +300,16 @@ class Trace(Object):
         """Verify if current history is valid."""
         return _ffi_api.TraceVerify()  # type: ignore
 
-    def add(self, knob: Knob, decision: Union[str, int]) -> IRModule:
-        """Add & Apply new decision (with knob)."""
+    def add(
+        self, knob: Knob, decision: Union[str, int], out_mod: Optional[IRModule] = None
+    ) -> IRModule:
+        """Add & Apply new decision (with knob).
+        If `out_mod` is given, it is taken as the result of the decision without re-applying it.
+        """
         if isinstance(decision, int):
             decision = str(decision)
+        if out_mod is not None:
+            return _ffi_api.TraceAddWithOutMod(self, knob, decision, out_mod)  # type: ignore
         return _ffi_api.TraceAdd(self, knob, decision)  # type: ignore
 
     def set_perf(self, perf: float) -> None:
@@ -15,6 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """RPC client tools"""
+import json
 import os
 import socket
 import stat
@@ -91,6 +92,68 @@ class RPCSession(object):
         dev._rpc_sess = self
         return dev
 
+    def set_copy_stream(self, window, block_bytes=1 << 20):
+        """Set how large arrays are copied to and from the remote.
+
+        Copies larger than one block are split into blocks, and up to `window` blocks
+        are kept in flight instead of waiting for a round trip per block. Streaming is
+        disabled by default, apps/benchmark/rpc_copy_bench.py measures whether it pays
+        off on a given link.
+
+        Parameters
+        ----------
+        window : int
+            The maximum number of blocks in flight. 0 disables streaming.
+
+        block_bytes : int
+            The size of each block in bytes.
+        """
+        _ffi_api.SessSetCopyStream(self._sess, window, block_bytes)
+
+    def set_copy_cache(self, min_bytes=1 << 16):
+        """Copy arrays to the remote through the copy cache of the server.
+
+        Arrays of at least `min_bytes` are referenced by a hash of their content first,
+        and only sent when the server has not received the same content before, e.g.
+        when the same weights are uploaded again in a later session.
+
+        Parameters
+        ----------
+        min_bytes : int
+            The minimum size in bytes of the arrays to cache. 0 disables the cache.
+        """
+        _ffi_api.SessSetCopyCache(self._sess, min_bytes)
+
+    def set_copy_compression(self, level=1, min_bytes=1 << 16):
+        """Compress the arrays copied to and from the remote with zstd.
+
+        Copies of at least `min_bytes` are compressed in blocks, and the blocks which
+        do not get smaller are sent as is. Compression only applies when the server
+        supports it, other copies are sent as before.
+
+        Parameters
+        ----------
+        level : int
+            The zstd compression level, higher levels compress more but slower,
+            negative levels are faster. 0 disables compression.
+
+        min_bytes : int
+            The minimum size in bytes of the copies to compress.
+        """
+        _ffi_api.SessSetCopyCompression(self._sess, level, min_bytes)
+
+    def transfer_stats(self):
+        """Get the transfer statistics of the session.
+
+        Returns
+        -------
+        stats : dict
+            The bytes sent and received on the channel, the bytes copied to and from
+            the remote, the bytes served from the copy cache, the bytes of the compressed
+            copies and of their payloads, and the time spent in copies.
+        """
+        return json.loads(_ffi_api.SessGetTransferStats(self._sess))
+
     def upload(self, data, target=None):
         """Upload file to remote runtime temp folder
 
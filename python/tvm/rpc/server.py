@@ -26,6 +26,7 @@ Server is TCP based with the following protocol:
 """
 # pylint: disable=invalid-name
 import ctypes
+import os
 import socket
 import select
 import struct
@@ -59,8 +60,11 @@ logger.addHandler(console_handler)
 logger.setLevel(logging.INFO)
 logger.propagate = False
 
+# The maximum total size of the copy cache kept across the sessions of a server.
+COPY_CACHE_MAX_BYTES = 1 << 30
 
-def _server_env(load_library, work_path=None):
+
+def _server_env(load_library, work_path=None, copy_cache_dir=None):
     """Server environment function return temp dir"""
     if work_path:
         temp = work_path
@@ -72,6 +76,12 @@ def _server_env(load_library, work_path=None):
     def get_workpath(path):
         return temp.relpath(path)
 
+    if copy_cache_dir:
+
+        @tvm._ffi.register_func("tvm.rpc.server.copy_cache_dir", override=True)
+        def get_copy_cache_dir():
+            return copy_cache_dir
+
     @tvm._ffi.register_func("tvm.rpc.server.load_module", override=True)
     def load_module(file_name):
         """Load module from remote side."""
@@ -118,16 +128,39 @@ def _server_env(load_library, work_path=None):
     return temp
 
 
-def _serve_loop(sock, addr, load_library, work_path=None):
+def _serve_loop(sock, addr, load_library, work_path=None, copy_cache_dir=None):
     """Server loop"""
     sockfd = sock.fileno()
-    temp = _server_env(load_library, work_path)
+    temp = _server_env(load_library, work_path, copy_cache_dir)
     _ffi_api.ServerLoop(sockfd)
     if not work_path:
         temp.remove()
     logger.info("Finish serving %s", addr)
 
 
+def _trim_copy_cache(copy_cache_dir, max_bytes):
+    """Remove the oldest entries of the copy cache until it fits in max_bytes."""
+    entries = []
+    total_bytes = 0
+    for name in os.listdir(copy_cache_dir):
+        path = os.path.join(copy_cache_dir, name)
+        try:
+            info = os.stat(path)
+        except OSError:
+            continue
+        entries.append((info.st_mtime, info.st_size, path))
+        total_bytes += info.st_size
+    for _, size, path in sorted(entries):
+        if total_bytes <= max_bytes:
+            break
+        try:
+            # A forked server may rename its temporary file meanwhile.
+            os.remove(path)
+        except OSError:
+            continue
+        total_bytes -= size
+
+
 def _parse_server_opt(opts):
     # parse client options
     ret = {}
@@ -137,7 +170,7 @@ def _parse_server_opt(opts):
     return ret
 
 
-def _listen_loop(sock, port, rpc_key, tracker_addr, load_library, custom_addr):
+def _listen_loop(sock, port, rpc_key, tracker_addr, load_library, custom_addr, copy_cache_dir=None):
     """Listening loop of the server."""
 
     def _accept_conn(listen_sock, tracker_conn, ping_period=2):
@@ -240,7 +273,8 @@ def _listen_loop(sock, port, rpc_key, tracker_addr, load_library, custom_addr):
         work_path = utils.tempdir()
         logger.info("connection from %s", addr)
         server_proc = multiprocessing.Process(
-            target=_serve_loop, args=(conn, addr, load_library, work_path)
+            target=_serve_loop,
+            args=(conn, addr, load_library, work_path, copy_cache_dir),
         )
 
         server_proc.start()
@@ -261,6 +295,8 @@ def _listen_loop(sock, port, rpc_key, tracker_addr, load_library, custom_addr):
             # terminate the worker
             server_proc.terminate()
         work_path.remove()
+        if copy_cache_dir:
+            _trim_copy_cache(copy_cache_dir, COPY_CACHE_MAX_BYTES)
 
 
 def _connect_proxy_loop(addr, key, load_library):
@@ -319,6 +355,7 @@ class PopenRPCServerState(object):
         load_library=None,
         custom_addr=None,
         silent=False,
+        copy_cache_dir=None,
     ):
 
         # start update
@@ -349,7 +386,15 @@ class PopenRPCServerState(object):
             self.sock = sock
             self.thread = threading.Thread(
                 target=_listen_loop,
-                args=(self.sock, self.port, key, tracker_addr, load_library, self.custom_addr),
+                args=(
+                    self.sock,
+                    self.port,
+                    key,
+                    tracker_addr,
+                    load_library,
+                    self.custom_addr,
+                    copy_cache_dir,
+                ),
             )
             self.thread.start()
         else:
@@ -371,6 +416,7 @@ def _popen_start_rpc_server(
     silent=False,
     no_fork=False,
     server_init_callback=None,
+    copy_cache_dir=None,
 ):
     if no_fork:
         multiprocessing.set_start_method("spawn")
@@ -382,7 +428,16 @@ def _popen_start_rpc_server(
     # Popen worker to run on a separate process.
     # Create and start the server in a different thread
     state = PopenRPCServerState(
-        host, port, port_end, is_proxy, tracker_addr, key, load_library, custom_addr, silent
+        host,
+        port,
+        port_end,
+        is_proxy,
+        tracker_addr,
+        key,
+        load_library,
+        custom_addr,
+        silent,
+        copy_cache_dir,
     )
     PopenRPCServerState.current = state
     # returns the port so that the main can get the port number.
@@ -434,6 +489,11 @@ class Server(object):
     server_init_callback: Callable, optional
         Additional initialization function when starting the server.
 
+    copy_cache: bool, optional
+        Whether to keep the arrays copied into the sessions in a copy cache, so that
+        clients which enable RPCSession.set_copy_cache can skip sending them again in
+        later sessions. The cache is removed when the server terminates.
+
     Note
     ----
     The RPC server only sees functions in the tvm namespace.
@@ -464,12 +524,15 @@ class Server(object):
         silent=False,
         no_fork=False,
         server_init_callback=None,
+        copy_cache=False,
     ):
         try:
             if _ffi_api.ServerLoop is None:
                 raise RuntimeError("Please compile with USE_RPC=1")
         except NameError:
             raise RuntimeError("Please compile with USE_RPC=1")
+        # The copy cache is owned here, so that it is removed with the server.
+        self.copy_cache = utils.tempdir() if copy_cache and not is_proxy else None
         self.proc = PopenWorker()
         # send the function
         self.proc.send(
@@ -486,6 +549,7 @@ class Server(object):
                 silent,
                 no_fork,
                 server_init_callback,
+                self.copy_cache.temp_dir if self.copy_cache else None,
             ],
         )
         # receive the port
@@ -497,6 +561,9 @@ class Server(object):
         if self.proc:
             self.proc.kill()
             self.proc = None
+        if self.copy_cache:
+            self.copy_cache.remove()
+            self.copy_cache = None
 
     def __del__(self):
         self.terminate()
@@ -112,6 +112,41 @@ class AotModule(object):
             self.set_input(**input_dict)
         self._run()
 
+    def profile(self, collectors=None, **input_dict):
+        """Run forward execution of the model and collect overall and per-op
+        performance metrics.
+
+        The model must be built with the "instrument-ops" option of the AOT executor, e.g.
+        ``Executor("aot", {"instrument-ops": True})``. Each operator call then reports its
+        duration and the workspace size live while it runs, and the device metrics include the
+        workspace high-water mark.
+
+        Parameters
+        ----------
+        collectors : Optional[Sequence[MetricCollector]]
+            Extra metrics to collect. If profiling over RPC, collectors must be `None`.
+
+        input_dict : dict of str to NDArray
+            List of input values to be feed to
+
+        Return
+        ------
+        timing_results : tvm.runtime.profiling.Report
+            Per-operator and whole model timing results.
+        """
+        # pylint: disable=import-outside-toplevel
+        from tvm.runtime.profiling import Report
+
+        if input_dict:
+            self.set_input(**input_dict)
+
+        if self.module.type_key == "rpc":
+            # We cannot serialize MetricCollectors over RPC
+            assert collectors is None, "Profiling with collectors is not supported over RPC"
+            return Report.from_json(self.module["profile_rpc"]())
+        # Looked up here since the CRT and older runtimes do not provide it.
+        return self.module["profile"](collectors)
+
     def get_num_outputs(self):
         """Get the number of outputs from the model
 
@@ -16,6 +16,8 @@
 # under the License.
 # pylint: disable=invalid-name
 """Helper utility to save and load parameter dicts."""
+import json
+
 from . import _ffi_api, ndarray
 
 
@@ -67,3 +69,63 @@ def load_param_dict(param_bytes):
     if isinstance(param_bytes, (bytes, str)):
         param_bytes = bytearray(param_bytes)
     return _ffi_api.LoadParams(param_bytes)
+
+
+def save_param_file(params, path):
+    """Save parameter dictionary to a file.
+
+    The data of each parameter is aligned in the file, so that
+    :py:func:`load_param_file` can map the file into memory instead of
+    reading it.
+
+    Parameters
+    ----------
+    params : dict of str to NDArray
+        The parameter dictionary.
+
+    path : str
+        The path to the file.
+    """
+    transformed = {k: ndarray.array(v) for (k, v) in params.items()}
+    _ffi_api.SaveParamsToFile(transformed, path)
+
+
+def load_param_file(path, copy=False, num_threads=0):
+    """Load parameter dictionary from a file.
+
+    Parameters
+    ----------
+    path : str
+        The path to a file saved by :py:func:`save_param_file`, or containing
+        the bytes of :py:func:`save_param_dict`.
+
+    copy : bool
+        Whether to copy the parameters out of the file with a pool of threads,
+        verifying their checksums, instead of mapping the file into memory.
+
+    num_threads : int
+        The number of threads used when copying, 0 for the number of cores.
+
+    Returns
+    -------
+    params : dict of str to NDArray
+        The parameter dictionary.
+    """
+    if copy:
+        return _ffi_api.LoadParamsParallel(path, num_threads)
+    return _ffi_api.LoadParamsFromFile(path)
+
+
+def last_load_profile():
+    """Get the time spent in each phase of the last parallel load on this thread.
+
+    Parallel loads are done by :py:func:`load_param_file` with ``copy=True``
+    and by loading a relax executable.
+
+    Returns
+    -------
+    profile : dict of str to float
+        The seconds spent in each phase, e.g. "map", "parse", "verify" and
+        "copy", the number of threads and the "total" time.
+    """
+    return json.loads(_ffi_api.GetLoadProfile())
@@ -90,3 +90,23 @@ def llvm_version_major(allow_none=False):
         if allow_none:
             return None
         raise RuntimeError("LLVM version is not available, please check if you built TVM with LLVM")
+
+
+def kernel_cache_stats():
+    """Get the counters of the persistent kernel cache.
+
+    The cache holds the object code of each PrimFunc built for the LLVM host
+    target, and is enabled by setting "codegen.kernel_cache_dir" in the
+    PassContext.
+
+    Returns
+    -------
+    stats : Dict[str, int]
+        The number of hits, misses, insertions and evictions.
+    """
+    return {key: int(value) for key, value in _ffi_api.KernelCacheGetStats().items()}
+
+
+def reset_kernel_cache_stats():
+    """Reset the counters of the persistent kernel cache."""
+    _ffi_api.KernelCacheResetStats()
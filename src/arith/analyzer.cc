@@ -25,6 +25,8 @@
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 
+#include <iterator>
+
 namespace tvm {
 namespace arith {
 
@@ -46,6 +48,7 @@ void Analyzer::Bind(const Var& var, const PrimExpr& expr, bool allow_override) {
   this->canonical_simplify.Update(var, new_expr, allow_override);
   this->int_set.Update(var, this->int_set(new_expr), allow_override);
   this->transitive_comparisons.Bind(var, expr, allow_override);
+  this->InvalidateSimplifyCache();
 }
 
 void Analyzer::Bind(const Var& var, const Range& range, bool allow_override) {
@@ -56,6 +59,7 @@ void Analyzer::Bind(const Var& var, const Range& range, bool allow_override) {
     this->const_int_bound.Bind(var, range, allow_override);
     this->int_set.Bind(var, range, allow_override);
     this->transitive_comparisons.Bind(var, range, allow_override);
+    this->InvalidateSimplifyCache();
   }
   // skip modular_set
   // skip rewrite simplify
@@ -69,6 +73,9 @@ void Analyzer::Bind(const Map<Var, Range>& variables, bool allow_override) {
 
 void ConstraintContext::EnterWithScope() {
   ICHECK(recovery_functions_.size() == 0);
+  // a fresh epoch for the cached simplify results under the new constraint.
+  saved_simplify_epoch_ = analyzer_->simplify_epoch_;
+  analyzer_->simplify_epoch_ = ++analyzer_->last_simplify_epoch_;
   // entering the scope.
   recovery_functions_.push_back(analyzer_->const_int_bound.EnterConstraint(constraint_));
   recovery_functions_.push_back(analyzer_->modular_set.EnterConstraint(constraint_));
@@ -85,6 +92,8 @@ void ConstraintContext::ExitWithScope() {
     }
     recovery_functions_.pop_back();
   }
+  // the context is back to the one before entering the scope.
+  analyzer_->simplify_epoch_ = saved_simplify_epoch_;
 }
 
 bool Analyzer::CanProveGreaterEqual(const PrimExpr& expr, int64_t lower_bound) {
@@ -127,11 +136,23 @@ bool Analyzer::CanProve(const PrimExpr& expr) {
 }
 
 PrimExpr Analyzer::Simplify(const PrimExpr& expr, int steps) {
+  bool use_cache = simplify_cache_max_entries_ != 0 && !tir::is_const_int(expr);
+  uint64_t epoch = simplify_epoch_;
+  uint64_t bind_epoch = simplify_bind_epoch_;
+  int extensions = static_cast<int>(rewrite_simplify.GetEnabledExtensions());
+  if (use_cache) {
+    auto it = simplify_cache_.find(expr);
+    if (it != simplify_cache_.end() && it->second.steps == steps && it->second.epoch == epoch &&
+        it->second.bind_epoch == bind_epoch && it->second.extensions == extensions) {
+      return it->second.result;
+    }
+  }
+
   PrimExpr res = expr;
 
   for (int i = 0; i < steps; ++i) {
     if (tir::is_const_int(res)) {
-      return res;
+      break;
     }
     if (i % 2 == 0) {
       res = this->rewrite_simplify(res);
@@ -140,9 +161,28 @@ PrimExpr Analyzer::Simplify(const PrimExpr& expr, int steps) {
     }
   }
 
+  if (use_cache) {
+    if (simplify_cache_.size() >= simplify_cache_max_entries_) {
+      // Drop the results of previous bindings first, then everything if still full.
+      for (auto it = simplify_cache_.begin(); it != simplify_cache_.end();) {
+        it = it->second.bind_epoch != bind_epoch ? simplify_cache_.erase(it) : std::next(it);
+      }
+      if (simplify_cache_.size() >= simplify_cache_max_entries_) {
+        simplify_cache_.clear();
+      }
+    }
+    simplify_cache_[expr] = SimplifyCacheEntry{steps, epoch, bind_epoch, extensions, res};
+  }
   return res;
 }
 
+void Analyzer::EnableSimplifyCache(size_t max_entries) {
+  simplify_cache_max_entries_ = max_entries;
+  simplify_cache_.clear();
+}
+
+void Analyzer::InvalidateSimplifyCache() { ++simplify_bind_epoch_; }
+
 TVM_REGISTER_GLOBAL("arith.CreateAnalyzer").set_body([](TVMArgs args, TVMRetValue* ret) {
   using runtime::PackedFunc;
   using runtime::TypedPackedFunc;
@@ -157,6 +197,7 @@ TVM_REGISTER_GLOBAL("arith.CreateAnalyzer").set_body([](TVMArgs args, TVMRetValu
     } else if (name == "const_int_bound_update") {
       return PackedFunc([self](TVMArgs args, TVMRetValue* ret) {
         self->const_int_bound.Update(args[0], args[1], args[2]);
+        self->InvalidateSimplifyCache();
       });
     } else if (name == "Simplify") {
       return PackedFunc([self](TVMArgs args, TVMRetValue* ret) {
@@ -194,6 +235,10 @@ TVM_REGISTER_GLOBAL("arith.CreateAnalyzer").set_body([](TVMArgs args, TVMRetValu
         auto fexit = [ctx](TVMArgs, TVMRetValue*) mutable { ctx.reset(); };
         *ret = PackedFunc(fexit);
       });
+    } else if (name == "enable_simplify_cache") {
+      return PackedFunc([self](TVMArgs args, TVMRetValue* ret) {
+        self->EnableSimplifyCache(args[0].operator int64_t());
+      });
     } else if (name == "can_prove_equal") {
       return PackedFunc(
           [self](TVMArgs args, TVMRetValue* ret) { *ret = self->CanProveEqual(args[0], args[1]); });
@@ -33,6 +33,9 @@
 #include <tvm/te/tensor.h>
 #include <tvm/tir/expr.h>
 
+#include <atomic>
+#include <vector>
+
 #include "../support/scalars.h"
 
 namespace tvm {
@@ -72,6 +75,79 @@ PrimExpr PrimExpr::FromObject_(ObjectRef ref) {
   return Downcast<PrimExpr>(ref);
 }
 
+/*!
+ * \brief Hash-consing table of the small integer constants that appear all over the IR
+ *  (loop bounds, strides, indices and booleans). IntImm is immutable, so sharing one node
+ *  among all the occurrences saves the allocations and lets pointer-equality fast paths
+ *  (same_as, ObjectPtrHash-keyed memos) hit on equal constants. It is only used once enabled
+ *  by SetIntImmInterning.
+ */
+class IntImmInternTable {
+ public:
+  /*! \brief The interned value range [kMinValue, kMaxValue). */
+  static constexpr int64_t kMinValue = -16;
+  static constexpr int64_t kMaxValue = 256;
+
+  static const IntImmInternTable* Global() {
+    static IntImmInternTable* inst = new IntImmInternTable();
+    return inst;
+  }
+
+  ObjectPtr<Object> Lookup(DataType dtype, int64_t value) const {
+    if (dtype.lanes() != 1) return nullptr;
+    const std::vector<ObjectPtr<IntImmNode>>* table = nullptr;
+    if (dtype == DataType::Int(32)) {
+      table = &int32_;
+    } else if (dtype == DataType::Int(64)) {
+      table = &int64_;
+    } else if (dtype == DataType::Bool()) {
+      table = &bool_;
+    } else {
+      return nullptr;
+    }
+    if (value < kMinValue || value - kMinValue >= static_cast<int64_t>(table->size())) {
+      return nullptr;
+    }
+    return (*table)[value - kMinValue];
+  }
+
+ private:
+  IntImmInternTable() {
+    Fill(DataType::Int(32), kMinValue, kMaxValue, &int32_);
+    Fill(DataType::Int(64), kMinValue, kMaxValue, &int64_);
+    // Only 0 and 1 are valid booleans, slots below 0 stay empty.
+    Fill(DataType::Bool(), kMinValue, 2, &bool_);
+  }
+
+  static void Fill(DataType dtype, int64_t begin, int64_t end,
+                   std::vector<ObjectPtr<IntImmNode>>* table) {
+    for (int64_t value = begin; value < end; ++value) {
+      if (dtype.is_bool() && value < 0) {
+        table->push_back(nullptr);
+        continue;
+      }
+      ObjectPtr<IntImmNode> node = make_object<IntImmNode>();
+      node->dtype = dtype;
+      node->value = value;
+      table->push_back(node);
+    }
+  }
+
+  std::vector<ObjectPtr<IntImmNode>> int32_;
+  std::vector<ObjectPtr<IntImmNode>> int64_;
+  std::vector<ObjectPtr<IntImmNode>> bool_;
+};
+
+/*! \brief Whether IntImm constants are interned. */
+static std::atomic<bool> intern_int_imm{false};
+
+bool SetIntImmInterning(bool enabled) { return intern_int_imm.exchange(enabled); }
+
+static ObjectPtr<Object> LookupInternedIntImm(DataType dtype, int64_t value) {
+  if (!intern_int_imm.load(std::memory_order_relaxed)) return nullptr;
+  return IntImmInternTable::Global()->Lookup(dtype, value);
+}
+
 IntImm::IntImm(DataType dtype, int64_t value, Span span) {
   ICHECK(dtype.is_scalar()) << "ValueError: IntImm can only take scalar, but " << dtype
                             << " was supplied.";
@@ -93,6 +169,12 @@ IntImm::IntImm(DataType dtype, int64_t value, Span span) {
     ICHECK_LT(value, 1LL << (dtype.bits() - 1))
         << "ValueError: Literal value " << value << " exceeds maximum of " << dtype;
   }
+  if (!span.defined()) {
+    if (ObjectPtr<Object> interned = LookupInternedIntImm(dtype, value)) {
+      data_ = std::move(interned);
+      return;
+    }
+  }
   ObjectPtr<IntImmNode> node = make_object<IntImmNode>();
   node->dtype = dtype;
   node->value = value;
@@ -104,6 +186,8 @@ TVM_REGISTER_GLOBAL("ir.IntImm").set_body_typed([](DataType dtype, int64_t value
   return IntImm(dtype, value, span);
 });
 
+TVM_REGISTER_GLOBAL("ir.SetIntImmInterning").set_body_typed(SetIntImmInterning);
+
 TVM_REGISTER_NODE_TYPE(IntImmNode);
 
 TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
@@ -28,10 +28,13 @@
 #include <tvm/relax/tuning_api.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <stack>
+#include <thread>
 #include <unordered_set>
 
 #include "../runtime/object_internal.h"
@@ -44,6 +47,7 @@ using tvm::runtime::TVMArgs;
 using tvm::runtime::TVMRetValue;
 
 TVM_REGISTER_PASS_CONFIG_OPTION("testing.immutable_module", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("ir.function_pass_num_threads", Integer);
 
 struct PassContextThreadLocalEntry {
   /*! \brief The default pass context. */
@@ -343,15 +347,55 @@ class ModulePass : public Pass {
 };
 
 PassInfo::PassInfo(int opt_level, String name, tvm::Array<runtime::String> required,
-                   bool traceable) {
+                   bool traceable, bool thread_safe) {
   auto pass_info = make_object<PassInfoNode>();
   pass_info->opt_level = opt_level;
   pass_info->name = std::move(name);
   pass_info->required = std::move(required);
   pass_info->traceable = std::move(traceable);
+  pass_info->thread_safe = thread_safe;
   data_ = std::move(pass_info);
 }
 
+int GetFunctionPassNumThreads(const PassContext& pass_ctx, const PassInfo& pass_info) {
+  if (!pass_info->thread_safe) {
+    return 1;
+  }
+  int num_threads =
+      pass_ctx->GetConfig<Integer>("ir.function_pass_num_threads", Integer(1)).value().IntValue();
+  CHECK_GE(num_threads, 0) << "ValueError: ir.function_pass_num_threads must be non-negative, "
+                           << "but got " << num_threads;
+  if (num_threads == 0) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  return num_threads;
+}
+
+void ParallelForEachFunction(const PassContext& pass_ctx, int num_threads, int num_tasks,
+                             const std::function<void(int task_id)>& fapply) {
+  num_threads = std::min(num_threads, num_tasks);
+  if (num_threads <= 1) {
+    for (int task_id = 0; task_id < num_tasks; ++task_id) {
+      fapply(task_id);
+    }
+    return;
+  }
+  support::parallel_for_dynamic(0, num_tasks, num_threads, [&](int thread_id, int task_id) {
+    // Enter the pass context on the worker thread. Instrumentations are not re-run since
+    // the context has already been entered by the caller.
+    std::stack<PassContext>& context_stack =
+        RelayPassContextThreadLocalStore::Get()->context_stack;
+    context_stack.push(pass_ctx);
+    try {
+      fapply(task_id);
+    } catch (...) {
+      context_stack.pop();
+      throw;
+    }
+    context_stack.pop();
+  });
+}
+
 ModulePass::ModulePass(runtime::TypedPackedFunc<IRModule(IRModule, PassContext)> pass_func,
                        PassInfo pass_info) {
   auto n = make_object<ModulePassNode>();
@@ -503,8 +547,9 @@ Pass CreateModulePass(const runtime::TypedPackedFunc<IRModule(IRModule, PassCont
 TVM_REGISTER_NODE_TYPE(PassInfoNode);
 
 TVM_REGISTER_GLOBAL("transform.PassInfo")
-    .set_body_typed([](int opt_level, String name, tvm::Array<String> required, bool traceable) {
-      return PassInfo(opt_level, name, required, traceable);
+    .set_body_typed([](int opt_level, String name, tvm::Array<String> required, bool traceable,
+                       bool thread_safe) {
+      return PassInfo(opt_level, name, required, traceable, thread_safe);
     });
 
 TVM_REGISTER_GLOBAL("transform.Info").set_body([](TVMArgs args, TVMRetValue* ret) {
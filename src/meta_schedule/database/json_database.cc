@@ -160,16 +160,17 @@ Database Database::JSONDatabase(String path_workload, String path_tuning_record,
   {
     std::vector<ObjectRef> json_objs = JSONFileReadLines(path_workload, num_threads, allow_missing);
     int n_objs = json_objs.size();
+    // The hash persisted in the file is trusted rather than recomputed for every workload. A
+    // lookup only returns a workload whose module is also equal to the queried one, so hash
+    // collisions are resolved there. A workload whose persisted hash is stale is never found
+    // and is committed again under its current hash.
+    workloads.resize(n_objs, Workload{nullptr});
+    support::parallel_for_dynamic(0, n_objs, num_threads, [&](int thread_id, int task_id) {
+      workloads[task_id] = Workload::FromJSON(json_objs[task_id]);
+    });
     n->workloads2idx_.reserve(n_objs);
-    workloads.reserve(n_objs);
     for (int i = 0; i < n_objs; ++i) {
-      Workload workload = Workload::FromJSON(json_objs[i]);
-      auto recalc_hash = n->GetModuleEquality().Hash(workload->mod);
-      CHECK_EQ(recalc_hash, workload->shash)
-          << "ValueError: Module hash changed. Given: " << workload->shash
-          << "; Recalculated: " << recalc_hash;
-      n->workloads2idx_.emplace(workload, i);
-      workloads.push_back(workload);
+      n->workloads2idx_.emplace(workloads[i], i);
     }
   }
   // Load `n->tuning_records_` from `path_tuning_record`
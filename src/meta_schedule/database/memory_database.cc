@@ -39,21 +39,15 @@ class MemoryDatabaseNode : public DatabaseNode {
 
  public:
   bool HasWorkload(const IRModule& mod) final {
-    for (const auto& workload : workloads) {
-      if (GetModuleEquality().Equal(workload->mod, mod)) {
-        return true;
-      }
-    }
-    return false;
+    return FindWorkload(mod, GetModuleEquality().Hash(mod)).defined();
   }
 
   Workload CommitWorkload(const IRModule& mod) final {
-    for (const auto& workload : workloads) {
-      if (GetModuleEquality().Equal(workload->mod, mod)) {
-        return workload;
-      }
+    Workload::THashCode shash = GetModuleEquality().Hash(mod);
+    if (Optional<Workload> workload = FindWorkload(mod, shash)) {
+      return workload.value();
     }
-    Workload workload(mod, GetModuleEquality().Hash(mod));
+    Workload workload(mod, shash);
     workloads.push_back(workload);
     return workload;
   }
@@ -98,6 +92,20 @@ class MemoryDatabaseNode : public DatabaseNode {
   Array<TuningRecord> GetAllTuningRecords() final { return records; }
 
   int64_t Size() final { return records.size(); }
+
+ private:
+  /*!
+   * \brief Find the workload equal to the given module. The full equality check only runs on the
+   * workloads whose hash collides with the module's.
+   */
+  Optional<Workload> FindWorkload(const IRModule& mod, Workload::THashCode shash) {
+    for (const auto& workload : workloads) {
+      if (workload->shash == shash && GetModuleEquality().Equal(workload->mod, mod)) {
+        return workload;
+      }
+    }
+    return NullOpt;
+  }
 };
 
 Database Database::MemoryDatabase(String mod_eq_name) {
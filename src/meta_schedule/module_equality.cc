@@ -24,8 +24,10 @@
 #include <tvm/tir/analysis.h>
 
 #include <memory>
+#include <string>
 
 #include "../node/ndarray_hash_equal.h"
+#include "../support/utils.h"
 
 namespace tvm {
 namespace meta_schedule {
@@ -77,6 +79,7 @@ class ModuleEqualityIgnoreNDArray : public ModuleEquality {
 // The NDArray-ignoring variant of structural equal / hash is used for the module equality
 // on the extracted anchor blocks.
 class ModuleEqualityAnchorBlock : public ModuleEquality {
+ public:
   size_t Hash(IRModule mod) const {
     auto anchor_block = tir::FindAnchorBlock(mod);
     if (anchor_block) {
@@ -95,6 +98,33 @@ class ModuleEqualityAnchorBlock : public ModuleEquality {
   }
 };
 
+// The hash only covers the schema of the anchor block, i.e. its name, iterator types and the
+// dtypes and dimensions of the buffers it accesses. It is cheap to compute and does not depend on
+// shape constants, while hash collisions are resolved by the full anchor-block equality.
+class ModuleEqualityAnchorBlockSchema : public ModuleEqualityAnchorBlock {
+  size_t Hash(IRModule mod) const {
+    auto anchor_block = tir::FindAnchorBlock(mod);
+    if (!anchor_block) {
+      return ModuleEqualityIgnoreNDArray().Hash(mod);
+    }
+    uint64_t hash = std::hash<std::string>()(anchor_block->name_hint);
+    for (const tir::IterVar& iter : anchor_block->iter_vars) {
+      hash = support::HashCombine(hash, static_cast<int>(iter->iter_type));
+    }
+    for (const Array<tir::BufferRegion>& regions : {anchor_block->reads, anchor_block->writes}) {
+      hash = support::HashCombine(hash, regions.size());
+      for (const tir::BufferRegion& region : regions) {
+        const tir::Buffer& buffer = region->buffer;
+        hash = support::HashCombine(hash, buffer->dtype.code());
+        hash = support::HashCombine(hash, buffer->dtype.bits());
+        hash = support::HashCombine(hash, buffer->dtype.lanes());
+        hash = support::HashCombine(hash, buffer->shape.size());
+      }
+    }
+    return hash;
+  }
+};
+
 std::unique_ptr<ModuleEquality> ModuleEquality::Create(const std::string& mod_eq_name) {
   if (mod_eq_name == "structural") {
     return std::make_unique<ModuleEqualityStructural>();
@@ -102,6 +132,8 @@ std::unique_ptr<ModuleEquality> ModuleEquality::Create(const std::string& mod_eq
     return std::make_unique<ModuleEqualityIgnoreNDArray>();
   } else if (mod_eq_name == "anchor-block") {
     return std::make_unique<ModuleEqualityAnchorBlock>();
+  } else if (mod_eq_name == "anchor-block-schema") {
+    return std::make_unique<ModuleEqualityAnchorBlockSchema>();
   }
   LOG(FATAL) << "Unknown module equality " << mod_eq_name;
   return nullptr;
@@ -46,6 +46,11 @@ class ModuleEquality {
    *                      given module. The "ignore-ndarray" varint is used for the extracted blocks
    *                      or in case no anchor block is found.
    *                      For the definition of the anchor block, see tvm/tir/analysis.h.
+   *    - "anchor-block-schema": Same as "anchor-block" for equality testing, but only hash the
+   *                             schema of the anchor block, i.e. its name, iterator types, and the
+   *                             dtypes and dimensions of the buffers it accesses. The hash is cheap
+   *                             and independent of shape constants; collisions are resolved by
+   *                             equality testing.
    * \return An owning pointer to the created instance
    */
   static std::unique_ptr<ModuleEquality> Create(const std::string& mod_eq_name);
@@ -18,6 +18,7 @@
  */
 
 #include "../module_equality.h"
+#include "../trace_cache.h"
 #include "../utils.h"
 
 #define TVM_META_SCHEDULE_CHECK_PROB_RANGE(p, name)                               \
@@ -239,6 +240,120 @@ std::vector<double> PredictNormalizedScore(const std::vector<Schedule>& candidat
   return scores;
 }
 
+/*!
+ * \brief Apply the trace and postprocessors to an IRModule, consulting the trace cache first.
+ * \param pp The threaded trace applier
+ * \param cache The trace cache
+ * \param mod The IRModule to be applied
+ * \param trace The trace to apply to the IRModule
+ * \param rand_state The random seed
+ * \return The schedule created, or NullOpt if any postprocessor fails
+ */
+Optional<Schedule> ApplyTraceWithCache(ThreadedTraceApply* pp, TraceCache* cache,
+                                       const IRModule& mod, const tir::Trace& trace,
+                                       TRandState* rand_state) {
+  TraceCache::Fingerprint fingerprint(trace);
+  bool known_failure = false;
+  if (Optional<Schedule> sch = cache->Lookup(fingerprint, &known_failure)) {
+    return sch;
+  }
+  if (known_failure) {
+    return NullOpt;
+  }
+  Optional<Schedule> sch = pp->Apply(mod, trace, rand_state);
+  cache->Insert(fingerprint, sch);
+  return sch;
+}
+
+/*!
+ * \brief The shape-agnostic signature of a workload. Workloads with the same structure, e.g. the
+ * same operator with different shape constants, are considered similar, and the distance between
+ * them is measured on their iteration extents in log scale.
+ */
+struct WorkloadSignature {
+  /*! \brief The block names and iterator types of the workload, without the extents */
+  std::string structure;
+  /*! \brief The log2 of the extents of all block iterators, in the order they appear */
+  std::vector<double> log_extents;
+
+  explicit WorkloadSignature(const IRModule& mod) {
+    std::ostringstream os;
+    for (const auto& kv : mod->functions) {
+      const auto* func = kv.second.as<tir::PrimFuncNode>();
+      if (func == nullptr) {
+        continue;
+      }
+      tir::PreOrderVisit(func->body, [&os, this](const ObjectRef& obj) -> bool {
+        if (const auto* block = obj.as<tir::BlockNode>()) {
+          os << block->name_hint << "(";
+          for (const tir::IterVar& iter : block->iter_vars) {
+            os << static_cast<int>(iter->iter_type);
+            if (const auto* extent = iter->dom->extent.as<IntImmNode>()) {
+              log_extents.push_back(std::log2(std::max<int64_t>(extent->value, 1)));
+            } else {
+              os << "?";
+            }
+          }
+          os << ")";
+        }
+        return true;
+      });
+    }
+    structure = os.str();
+  }
+
+  /*! \brief The distance to the signature of another workload with the same structure */
+  double Distance(const WorkloadSignature& other) const {
+    ICHECK_EQ(log_extents.size(), other.log_extents.size());
+    double sum = 0.0;
+    for (int i = 0, n = log_extents.size(); i < n; ++i) {
+      double diff = log_extents[i] - other.log_extents[i];
+      sum += diff * diff;
+    }
+    return std::sqrt(sum);
+  }
+};
+
+/*!
+ * \brief Retarget a trace tuned on a similar workload to the workload being tuned, by grafting its
+ * sampling decisions onto a design space whose sampling instructions are of the same kinds.
+ * \note Tiling decisions that are not perfect on the new extents are repaired when the trace is
+ * replayed, see `tir::SamplePerfectTile`.
+ * \param trace The trace tuned on a similar workload
+ * \param design_spaces The design spaces of the workload being tuned
+ * \return The retargeted trace, or NullOpt if no design space matches the trace
+ */
+Optional<tir::Trace> RetargetTrace(const tir::Trace& trace, const Array<tir::Trace>& design_spaces) {
+  std::vector<std::pair<tir::InstructionKind, ObjectRef>> sampled;
+  for (const tir::Instruction& inst : trace->insts) {
+    if (inst->kind->IsPostproc()) {
+      break;
+    }
+    if (Optional<ObjectRef> decision = trace->GetDecision(inst)) {
+      sampled.emplace_back(inst->kind, decision.value());
+    }
+  }
+  for (const tir::Trace& space : design_spaces) {
+    Map<tir::Instruction, ObjectRef> decisions;
+    int i = 0, n = sampled.size();
+    bool matched = true;
+    for (const tir::Instruction& inst : space->insts) {
+      if (!space->GetDecision(inst).defined()) {
+        continue;
+      }
+      if (i >= n || !sampled[i].first.same_as(inst->kind)) {
+        matched = false;
+        break;
+      }
+      decisions.Set(inst, sampled[i++].second);
+    }
+    if (matched && i == n) {
+      return tir::Trace(space->insts, decisions);
+    }
+  }
+  return NullOpt;
+}
+
 /**************** Evolutionary Search ****************/
 
 /*!\brief A search strategy that generates measure candidates using evolutionary search. */
@@ -267,6 +382,10 @@ class EvolutionarySearchNode : public SearchStrategyNode {
      * TODO(junrushao1994): add records from the database to avoid re-measuring.
      * */
     IRModuleSet measured_workloads_;
+    /*! \brief The cache of traces applied, shared across generations and iterations. */
+    TraceCache trace_cache_;
+    /*! \brief The best traces of similar workloads in the database, retargeted to this one. */
+    std::vector<tir::Trace> transfer_traces_;
     /*! \brief A Database for selecting useful candidates. */
     Database database_{nullptr};
     /*! \brief A cost model helping to explore the search space */
@@ -282,7 +401,8 @@ class EvolutionarySearchNode : public SearchStrategyNode {
           st(0),
           ed(num_trials_per_iter),
           num_empty_iters(0),
-          measured_workloads_(database->GetModuleEquality()) {
+          measured_workloads_(database->GetModuleEquality()),
+          trace_cache_(/*max_num_schedules=*/2 * self->population_size) {
       design_spaces.reserve(design_spaces.size());
       for (const Schedule& space : design_space_schedules) {
         design_spaces.push_back(space->trace().value()->Simplified(true));
@@ -297,6 +417,8 @@ class EvolutionarySearchNode : public SearchStrategyNode {
       this->database_ = database;
       this->cost_model_ = cost_model;
       this->token_ = database->CommitWorkload(mod);
+      this->transfer_traces_ =
+          RetargetFromSimilarWorkloads(self->population_size * self->init_measured_ratio);
     }
 
     /*!
@@ -305,6 +427,19 @@ class EvolutionarySearchNode : public SearchStrategyNode {
      * \return The picked best candidates.
      */
     inline std::vector<Schedule> PickBestFromDatabase(int num);
+    /*!
+     * \brief Retarget the best traces of the most similar workloads in the database.
+     * \param num The maximum number of traces to retarget.
+     * \return The retargeted traces, the ones from the most similar workloads first.
+     */
+    inline std::vector<tir::Trace> RetargetFromSimilarWorkloads(int num);
+    /*!
+     * \brief Pick up candidates transferred from similar workloads, to warm-start the search when
+     * the database holds few records of the workload itself.
+     * \param num The number of traces to produce.
+     * \return The picked candidates.
+     */
+    inline std::vector<Schedule> PickFromSimilarWorkloads(int num);
     /*!
      * \brief Sample the initial population from previous measured results and randomly generated
      *  traces via trace replaying.
@@ -490,7 +625,8 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
     tir::Trace trace = measured_traces.at(trace_id);
     Schedule& result = results.at(trace_id);
     ICHECK(!result.defined());
-    if (Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
+    if (Optional<Schedule> sch =
+            ApplyTraceWithCache(&pp, &this->trace_cache_, mod, trace, rand_state)) {
       result = sch.value();
     } else {
       LOG(FATAL) << "ValueError: Cannot postprocess the trace:\n" << trace;
@@ -501,6 +637,109 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
   return results;
 }
 
+std::vector<tir::Trace> EvolutionarySearchNode::State::RetargetFromSimilarWorkloads(int num) {
+  auto _ = Profiler::TimedScope("EvoSearch/RetargetFromSimilarWorkloads");
+  // The number of nearest workloads whose records are transferred
+  constexpr int kMaxSimilarWorkloads = 3;
+  std::vector<tir::Trace> results;
+  if (num <= 0) {
+    return results;
+  }
+  const ModuleEquality& mod_eq = database_->GetModuleEquality();
+  Optional<Target> target = self->ctx_->target;
+  WorkloadSignature signature(token_->mod);
+  // Step 1. Index the distinct workloads in the database with the same structure. Databases such
+  // as UnionDatabase, ScheduleFnDatabase or a PyDatabase may not enumerate their records, in which
+  // case there is nothing to retarget from.
+  Array<TuningRecord> records;
+  try {
+    records = database_->GetAllTuningRecords();
+  } catch (const std::exception&) {
+    TVM_PY_LOG(INFO, self->ctx_->logger)
+        << "Skipped retargeting from similar workloads: the database cannot list its records";
+    return results;
+  }
+  std::vector<std::pair<double, Workload>> similar;
+  std::unordered_set<Workload, ObjectPtrHash, ObjectPtrEqual> visited;
+  for (const TuningRecord& record : records) {
+    const Workload& workload = record->workload;
+    if (!visited.insert(workload).second) {
+      continue;
+    }
+    if (workload.same_as(token_) ||
+        (workload->shash == token_->shash && mod_eq.Equal(workload->mod, token_->mod))) {
+      continue;
+    }
+    WorkloadSignature other(workload->mod);
+    if (other.structure == signature.structure) {
+      similar.emplace_back(signature.Distance(other), workload);
+    }
+  }
+  std::sort(similar.begin(), similar.end(),
+            [](const std::pair<double, Workload>& a, const std::pair<double, Workload>& b) {
+              return a.first < b.first;
+            });
+  if (static_cast<int>(similar.size()) > kMaxSimilarWorkloads) {
+    similar.resize(kMaxSimilarWorkloads);
+  }
+  // Step 2. Retarget the best records of the nearest workloads
+  for (const auto& kv : similar) {
+    for (const TuningRecord& record : database_->GetTopK(kv.second, num)) {
+      if (static_cast<int>(results.size()) >= num) {
+        break;
+      }
+      if (target.defined() && (!record->target.defined() ||
+                               record->target.value()->kind->name != target.value()->kind->name)) {
+        continue;
+      }
+      if (Optional<tir::Trace> trace = RetargetTrace(record->trace, design_spaces)) {
+        results.push_back(trace.value());
+      }
+    }
+  }
+  if (!results.empty()) {
+    TVM_PY_LOG(INFO, self->ctx_->logger)
+        << "Retargeted " << results.size() << " trace(s) from " << similar.size()
+        << " similar workload(s) in the database";
+  }
+  return results;
+}
+
+std::vector<Schedule> EvolutionarySearchNode::State::PickFromSimilarWorkloads(int num) {
+  auto _ = Profiler::TimedScope("EvoSearch/PickFromSimilarWorkloads");
+  int actual_num = std::min<int>(num, transfer_traces_.size());
+  if (actual_num <= 0) {
+    return {};
+  }
+  ThreadedTraceApply pp(self->postprocs_);
+  std::vector<Schedule> results(actual_num, Schedule{nullptr});
+  auto f_proc_transferred = [this, &results, &pp](int thread_id, int trace_id) -> void {
+    PerThreadData& data = this->per_thread_data_.at(thread_id);
+    TRandState* rand_state = &data.rand_state;
+    const IRModule& mod = data.mod;
+    const tir::Trace& trace = this->transfer_traces_.at(trace_id);
+    try {
+      if (Optional<Schedule> sch =
+              ApplyTraceWithCache(&pp, &this->trace_cache_, mod, trace, rand_state)) {
+        results.at(trace_id) = sch.value();
+      }
+    } catch (const std::exception& e) {
+      // The retargeted decisions do not fit this workload, so the trace is dropped
+      TVM_PY_LOG(DEBUG, this->self->ctx_->logger)
+          << "Dropped a trace retargeted from a similar workload: " << e.what();
+    }
+  };
+  support::parallel_for_dynamic(0, actual_num, self->ctx_->num_threads, f_proc_transferred);
+  std::vector<Schedule> out_schs;
+  out_schs.reserve(actual_num);
+  for (const Schedule& sch : results) {
+    if (sch.defined()) {
+      out_schs.push_back(sch);
+    }
+  }
+  return out_schs;
+}
+
 std::vector<Schedule> EvolutionarySearchNode::State::SampleInitPopulation(int num) {
   auto _ = Profiler::TimedScope("EvoSearch/SampleInitPopulation");
   ThreadedTraceApply pp(self->postprocs_);
@@ -597,7 +836,8 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
             // Decision: mutate
             Mutator mutator = opt_mutator.value();
             if (Optional<tir::Trace> new_trace = mutator->Apply(trace, rand_state)) {
-              if (Optional<Schedule> sch = pp.Apply(mod, new_trace.value(), rand_state)) {
+              if (Optional<Schedule> sch = ApplyTraceWithCache(
+                      &pp, &this->trace_cache_, mod, new_trace.value(), rand_state)) {
                 // note that sch's trace is different from new_trace
                 // because it contains post-processing information
                 result = sch.value();
@@ -619,7 +859,8 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
 
       population.swap(next_population);
       TVM_PY_LOG(INFO, self->ctx_->logger) << "Evolve iter #" << iter << " done. Summary:\n"
-                                           << pp.SummarizeFailures();
+                                           << pp.SummarizeFailures() << "\n"
+                                           << this->trace_cache_.SummarizeHits();
     }
   }
   // Return the best states from the heap, sorting from higher score to lower ones
@@ -711,9 +952,17 @@ Optional<Array<MeasureCandidate>> EvolutionarySearchNode::State::GenerateMeasure
   inits.reserve(pop);
 
   TVM_PY_LOG(INFO, self->ctx_->logger) << "Generating candidates......";
-  std::vector<Schedule> measured = PickBestFromDatabase(pop * self->init_measured_ratio);
+  int num_measured = pop * self->init_measured_ratio;
+  std::vector<Schedule> measured = PickBestFromDatabase(num_measured);
   TVM_PY_LOG(INFO, self->ctx_->logger)
       << "Picked top " << measured.size() << " candidate(s) from database";
+  if (static_cast<int>(measured.size()) < num_measured && !transfer_traces_.empty()) {
+    std::vector<Schedule> transferred =
+        PickFromSimilarWorkloads(num_measured - static_cast<int>(measured.size()));
+    TVM_PY_LOG(INFO, self->ctx_->logger)
+        << "Picked " << transferred.size() << " candidate(s) transferred from similar workloads";
+    measured.insert(measured.end(), transferred.begin(), transferred.end());
+  }
   std::vector<Schedule> unmeasured = SampleInitPopulation(pop - measured.size());
   if (static_cast<int>(unmeasured.size()) < self->init_min_unmeasured) {
     TVM_PY_LOG(WARNING, self->ctx_->logger)
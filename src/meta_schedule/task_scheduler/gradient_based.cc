@@ -135,9 +135,12 @@ class GradientBasedNode final : public TaskSchedulerNode {
 };
 
 TaskScheduler TaskScheduler::GradientBased(PackedFunc logger, double alpha, int window_size,
-                                           support::LinearCongruentialEngine::TRandState seed) {
+                                           support::LinearCongruentialEngine::TRandState seed,
+                                           int max_inflight_batches) {
+  CHECK_GE(max_inflight_batches, 0) << "ValueError: `max_inflight_batches` must be non-negative";
   ObjectPtr<GradientBasedNode> n = make_object<GradientBasedNode>();
   n->logger = logger;
+  n->max_inflight_batches = max_inflight_batches;
   n->alpha = alpha;
   n->window_size = window_size;
   n->rand_state = support::LinearCongruentialEngine::NormalizeSeed(seed);
@@ -55,9 +55,11 @@ class RoundRobinNode final : public TaskSchedulerNode {
   }
 };
 
-TaskScheduler TaskScheduler::RoundRobin(PackedFunc logger) {
+TaskScheduler TaskScheduler::RoundRobin(PackedFunc logger, int max_inflight_batches) {
+  CHECK_GE(max_inflight_batches, 0) << "ValueError: `max_inflight_batches` must be non-negative";
   ObjectPtr<RoundRobinNode> n = make_object<RoundRobinNode>();
   n->logger = logger;
+  n->max_inflight_batches = max_inflight_batches;
   n->task_id = -1;
   return TaskScheduler(n);
 }
@@ -16,6 +16,9 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <chrono>
+#include <deque>
+
 #include "../utils.h"
 
 namespace tvm {
@@ -38,23 +41,19 @@ TaskRecord::TaskRecord(TuneContext ctx, double task_weight) {
   this->data_ = std::move(n);
 }
 
-void SendToBuilder(TaskRecordNode* self, const Builder& builder) {
-  auto _ = Profiler::TimedScope("SendToBuilder");
-  Array<MeasureCandidate> candidates = self->measure_candidates.value();
-  Target target = self->ctx->target.value();
+Array<BuilderResult> BuildCandidates(const Array<MeasureCandidate>& candidates,
+                                     const Target& target, const Builder& builder) {
   Array<BuilderInput> inputs;
   inputs.reserve(candidates.size());
   for (const MeasureCandidate& candidate : candidates) {
     inputs.push_back(BuilderInput(candidate->sch->mod(), target));
   }
-  self->builder_results = builder->Build(inputs);
+  return builder->Build(inputs);
 }
 
-void SendToRunner(TaskRecordNode* self, const Runner& runner) {
-  auto _ = Profiler::TimedScope("SendToRunner");
-  Array<MeasureCandidate> candidates = self->measure_candidates.value();
-  Array<BuilderResult> builder_results = self->builder_results.value();
-  Target target = self->ctx->target.value();
+Array<RunnerFuture> RunCandidates(const Array<MeasureCandidate>& candidates,
+                                  const Array<BuilderResult>& builder_results,
+                                  const Target& target, const Runner& runner) {
   ICHECK_EQ(candidates.size(), builder_results.size());
   int n = candidates.size();
   int n_build_errors = 0;
@@ -73,8 +72,7 @@ void SendToRunner(TaskRecordNode* self, const Runner& runner) {
   }
   Array<RunnerFuture> futures = runner->Run(inputs);
   if (n_build_errors == 0) {
-    self->runner_futures = futures;
-    return;
+    return futures;
   }
   Array<RunnerFuture> results;
   results.reserve(n);
@@ -91,7 +89,53 @@ void SendToRunner(TaskRecordNode* self, const Runner& runner) {
       results.push_back(futures[j++]);
     }
   }
-  self->runner_futures = results;
+  return results;
+}
+
+void SendToBuilder(TaskRecordNode* self, const Builder& builder) {
+  auto _ = Profiler::TimedScope("SendToBuilder");
+  self->builder_results =
+      BuildCandidates(self->measure_candidates.value(), self->ctx->target.value(), builder);
+}
+
+void SendToRunner(TaskRecordNode* self, const Runner& runner) {
+  auto _ = Profiler::TimedScope("SendToRunner");
+  self->runner_futures = RunCandidates(self->measure_candidates.value(),
+                                       self->builder_results.value(), self->ctx->target.value(),
+                                       runner);
+}
+
+void SendToBuilderAndRunnerAsync(TaskRecordNode* self, const Builder& builder,
+                                 const Runner& runner) {
+  using Batch = std::pair<Array<BuilderResult>, Array<RunnerFuture>>;
+  auto _ = Profiler::TimedScope("SendToBuilderAndRunnerAsync");
+  Array<MeasureCandidate> candidates = self->measure_candidates.value();
+  Target target = self->ctx->target.value();
+  std::shared_future<Batch> inflight =
+      std::async(std::launch::async, [candidates, target, builder, runner]() -> Batch {
+        Array<BuilderResult> builder_results = BuildCandidates(candidates, target, builder);
+        Array<RunnerFuture> runner_futures =
+            RunCandidates(candidates, builder_results, target, runner);
+        return {builder_results, runner_futures};
+      }).share();
+  // The runner futures exposed to the task scheduler wait for the build before the run.
+  int n = candidates.size();
+  Array<RunnerFuture> futures;
+  futures.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    futures.push_back(RunnerFuture(
+        /*f_done=*/
+        [inflight, i]() -> bool {
+          if (inflight.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+          }
+          return inflight.get().second[i]->Done();
+        },
+        /*f_result=*/
+        [inflight, i]() -> RunnerResult { return inflight.get().second[i]->Result(); }));
+  }
+  self->inflight_build = inflight;
+  self->runner_futures = futures;
 }
 
 void TaskCleanUp(TaskRecordNode* self, int task_id, const Array<RunnerResult>& results) {
@@ -138,6 +182,7 @@ void TaskCleanUp(TaskRecordNode* self, int task_id, const Array<RunnerResult>& r
   self->measure_candidates = NullOpt;
   self->builder_results = NullOpt;
   self->runner_futures = NullOpt;
+  self->inflight_build = {};
 }
 
 void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weights,
@@ -176,6 +221,8 @@ void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weigh
   }
 
   int num_trials_already = 0;
+  // The tasks whose measurement batches are in flight, oldest first
+  std::deque<int> inflight_tasks;
   for (int task_id; num_trials_already < max_trials_global && (task_id = NextTaskId()) != -1;) {
     TVM_PY_LOG(INFO, this->logger)
         << "TaskScheduler picks Task #" << task_id << ": " << tasks_[task_id]->ctx->task_name;
@@ -190,10 +237,28 @@ void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weigh
             task->ctx->search_strategy.value()->GenerateMeasureCandidates()) {
       int num_candidates = candidates.value().size();
       num_trials_already += num_candidates;
-      TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to builder";
-      SendToBuilder(task, builder);
-      TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to runner";
-      SendToRunner(task, runner);
+      if (this->max_inflight_batches > 0) {
+        // Bound the number of batches in flight by joining the oldest ones
+        for (int n_inflight = CountInflightBatches(); n_inflight >= this->max_inflight_batches;
+             inflight_tasks.pop_front()) {
+          ICHECK(!inflight_tasks.empty());
+          int oldest_id = inflight_tasks.front();
+          TaskRecordNode* oldest = tasks_[oldest_id].get();
+          if (!oldest->is_terminated && oldest->runner_futures.defined()) {
+            JoinRunningTask(oldest_id);
+            --n_inflight;
+          }
+        }
+        TVM_PY_LOG(INFO, this->logger)
+            << "Sending " << num_candidates << " sample(s) to builder and runner asynchronously";
+        SendToBuilderAndRunnerAsync(task, builder, runner);
+        inflight_tasks.push_back(task_id);
+      } else {
+        TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to builder";
+        SendToBuilder(task, builder);
+        TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to runner";
+        SendToRunner(task, runner);
+      }
     } else {
       TerminateTask(task_id);
     }
@@ -222,6 +287,11 @@ Array<RunnerResult> TaskSchedulerNode::JoinRunningTask(int task_id) {
       results.push_back(future->Result());
     }
   }
+  if (task->inflight_build.valid()) {
+    // All the runner futures are resolved, so the asynchronous build has finished
+    task->builder_results = task->inflight_build.get().first;
+    task->inflight_build = {};
+  }
   ICHECK(task->measure_candidates.defined());
   task->ctx->search_strategy.value()->NotifyRunnerResults(task->measure_candidates.value(),
                                                           results);
@@ -251,6 +321,16 @@ void TaskSchedulerNode::TouchTask(int task_id) {
   }
 }
 
+int TaskSchedulerNode::CountInflightBatches() const {
+  int n_inflight = 0;
+  for (const TaskRecord& task : this->tasks_) {
+    if (!task->is_terminated && task->runner_futures.defined()) {
+      ++n_inflight;
+    }
+  }
+  return n_inflight;
+}
+
 void TaskSchedulerNode::TerminateTask(int task_id) {
   TaskRecordNode* task = this->tasks_[task_id].get();
   ICHECK(!task->is_terminated);
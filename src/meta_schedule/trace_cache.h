@@ -0,0 +1,156 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_META_SCHEDULE_TRACE_CACHE_H_
+#define TVM_META_SCHEDULE_TRACE_CACHE_H_
+
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/tir/schedule/schedule.h>
+#include <tvm/tir/schedule/trace.h>
+
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief A thread-safe cache from trace fingerprints to the outcome of applying the trace,
+ * so that traces already seen in earlier generations are not re-applied.
+ * \note The fingerprint of a trace is its JSON form with postprocessing instructions removed,
+ * which covers both the instructions of its design space and all of its sampling decisions.
+ * Applying a trace whose decisions are all fixed is deterministic, so a known trace either maps
+ * to the schedule created before, or is known to fail postprocessing.
+ * \note The cache keeps its own copy of each schedule and hands out a fresh copy on every hit,
+ * so that the callers may mutate the schedules they get without affecting each other.
+ */
+class TraceCache {
+ public:
+  /*! \brief The fingerprint of a trace */
+  struct Fingerprint {
+    /*! \brief The trace in JSON form, with postprocessing instructions removed */
+    ObjectRef json;
+    /*! \brief The structural hash of `json` */
+    size_t shash;
+
+    explicit Fingerprint(const tir::Trace& trace)
+        : json(trace->AsJSON(/*remove_postproc=*/true)), shash(StructuralHash()(json)) {}
+  };
+
+  /*!
+   * \brief Constructor
+   * \param max_num_schedules The maximum number of successfully applied schedules to keep.
+   * Once exceeded, the cached schedules are dropped, while the known failures are kept.
+   */
+  explicit TraceCache(int max_num_schedules) : max_num_schedules_(max_num_schedules) {}
+
+  /*!
+   * \brief Look up a trace in the cache
+   * \param fingerprint The fingerprint of the trace
+   * \param known_failure Set to true if the trace is known to fail postprocessing
+   * \return A copy of the cached schedule if the trace is known to be applied successfully
+   */
+  Optional<tir::Schedule> Lookup(const Fingerprint& fingerprint, bool* known_failure) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++num_lookups_;
+    *known_failure = false;
+    if (failures_.count(fingerprint)) {
+      ++num_failure_hits_;
+      *known_failure = true;
+      return NullOpt;
+    }
+    auto it = schedules_.find(fingerprint);
+    if (it != schedules_.end()) {
+      ++num_schedule_hits_;
+      // Copying forks the random state of the cached schedule, so it is done under the lock.
+      return it->second->Copy();
+    }
+    return NullOpt;
+  }
+
+  /*!
+   * \brief Record the outcome of applying a trace
+   * \param fingerprint The fingerprint of the trace
+   * \param sch The schedule created, or NullOpt if postprocessing fails. The cache stores a copy
+   * of it, so the caller keeps ownership of `sch`.
+   */
+  void Insert(const Fingerprint& fingerprint, const Optional<tir::Schedule>& sch) {
+    Optional<tir::Schedule> copy = NullOpt;
+    if (sch.defined()) {
+      copy = sch.value()->Copy();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!copy.defined()) {
+      failures_.insert(fingerprint);
+      return;
+    }
+    if (static_cast<int>(schedules_.size()) >= max_num_schedules_) {
+      schedules_.clear();
+    }
+    schedules_.emplace(fingerprint, copy.value());
+  }
+
+  /*! \brief Returns a string summarizing the hit rate of the cache */
+  std::string SummarizeHits() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    int64_t hits = num_schedule_hits_ + num_failure_hits_;
+    std::ostringstream os;
+    os << "Trace cache: " << hits << " hit(s) out of " << num_lookups_ << " lookup(s)";
+    if (num_lookups_ > 0) {
+      os << " (" << std::fixed << std::setprecision(2) << (100.0 * hits / num_lookups_) << "%)";
+    }
+    os << ", of which " << num_schedule_hits_ << " duplicate(s) and " << num_failure_hits_
+       << " known postproc failure(s)";
+    return os.str();
+  }
+
+ private:
+  struct FingerprintHash {
+    size_t operator()(const Fingerprint& fingerprint) const { return fingerprint.shash; }
+  };
+  struct FingerprintEqual {
+    bool operator()(const Fingerprint& lhs, const Fingerprint& rhs) const {
+      return lhs.shash == rhs.shash && StructuralEqual()(lhs.json, rhs.json);
+    }
+  };
+
+  /*! \brief The maximum number of cached schedules */
+  int max_num_schedules_;
+  /*! \brief The mutex guarding the tables and counters */
+  mutable std::mutex mutex_;
+  /*! \brief The traces that have been applied successfully, and the resulting schedules */
+  std::unordered_map<Fingerprint, tir::Schedule, FingerprintHash, FingerprintEqual> schedules_;
+  /*! \brief The traces that are known to fail postprocessing */
+  std::unordered_set<Fingerprint, FingerprintHash, FingerprintEqual> failures_;
+  /*! \brief The number of lookups */
+  int64_t num_lookups_ = 0;
+  /*! \brief The number of lookups that hit a cached schedule */
+  int64_t num_schedule_hits_ = 0;
+  /*! \brief The number of lookups that hit a known failure */
+  int64_t num_failure_hits_ = 0;
+};
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_TRACE_CACHE_H_
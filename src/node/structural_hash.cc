@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 #include "../support/base64.h"
 #include "../support/str_escape.h"
@@ -287,16 +288,50 @@ void SHashHandlerDefault::DispatchSHash(const ObjectRef& key, bool map_free_vars
   impl->DispatchSHash(key, map_free_vars);
 }
 
-TVM_REGISTER_GLOBAL("node.StructuralHash")
-    .set_body_typed([](const ObjectRef& object, bool map_free_vars) -> int64_t {
-      size_t hashed_value = SHashHandlerDefault().Hash(object, map_free_vars);
-      return static_cast<int64_t>(hashed_value);
-    });
+/*! \brief The registered StructuralHashCache accessors, indexed by type index. */
+using FGetStructuralHashCache = const StructuralHashCache* (*)(const Object*);
+
+static std::vector<FGetStructuralHashCache>* StructuralHashCacheRegistry() {
+  static std::vector<FGetStructuralHashCache> inst;
+  return &inst;
+}
+
+bool RegisterStructuralHashCache(uint32_t type_index, FGetStructuralHashCache fget) {
+  std::vector<FGetStructuralHashCache>* registry = StructuralHashCacheRegistry();
+  if (registry->size() <= type_index) {
+    registry->resize(type_index + 1, nullptr);
+  }
+  registry->at(type_index) = fget;
+  return true;
+}
 
 size_t StructuralHash::operator()(const ObjectRef& object) const {
+  // The hash of a node as a root does not depend on any context,
+  // so it can be cached on nodes that registered a cache slot.
+  // A node with a single reference may be mutated in place through a pointer obtained from
+  // CopyOnWrite before it was hashed, so the cache is only used once the node is shared.
+  // Registration only happens at static initialization, no lock is needed here.
+  const std::vector<FGetStructuralHashCache>& registry = *StructuralHashCacheRegistry();
+  if (object.defined() && !object.unique() && object->type_index() < registry.size() &&
+      registry[object->type_index()] != nullptr) {
+    const StructuralHashCache* cache = registry[object->type_index()](object.get());
+    size_t hashed_value;
+    if (!cache->Get(&hashed_value)) {
+      hashed_value = SHashHandlerDefault().Hash(object, false);
+      cache->Set(hashed_value);
+    }
+    return hashed_value;
+  }
   return SHashHandlerDefault().Hash(object, false);
 }
 
+TVM_REGISTER_GLOBAL("node.StructuralHash")
+    .set_body_typed([](const ObjectRef& object, bool map_free_vars) -> int64_t {
+      size_t hashed_value = map_free_vars ? SHashHandlerDefault().Hash(object, map_free_vars)
+                                          : StructuralHash()(object);
+      return static_cast<int64_t>(hashed_value);
+    });
+
 // SEQualReduce traits for runtime containers.
 struct StringObjTrait {
   static constexpr const std::nullptr_t VisitAttrs = nullptr;
@@ -32,7 +32,10 @@
 #include <array>
 #include <cstddef>
 #include <limits>
+#include <map>
+#include <set>
 #include <stack>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -521,14 +524,146 @@ struct RNode {
   std::vector<RNode*> parents;
 };
 
+/*!
+ * \brief Index of the vars of a dataflow block for graph matching.
+ *
+ *  Vars are bucketed by the op of their bound value (and by the callee of call_tir), so a
+ *  pattern node only considers the vars of its bucket. Node-level match results are memoized
+ *  for the whole search, shared by every pattern node, start point and backtracking step.
+ *  When disabled, nothing is indexed or memoized and every var is a candidate.
+ */
+class MatcherIndex {
+ public:
+  MatcherIndex(const DataflowBlock& dfb, const runtime::Map<Var, Expr>& var2val, bool enabled)
+      : matcher_(var2val), enabled_(enabled) {
+    if (!enabled_) return;
+    for (const Binding& binding : dfb->bindings) {
+      const auto* var_binding = binding.as<VarBindingNode>();
+      if (var_binding == nullptr) continue;
+      const VarNode* var = var_binding->var.get();
+      std::pair<std::string, std::string> keys = ValueKeys(var_binding->value, var2val);
+      if (keys.first.empty()) continue;
+      var2keys_[var] = keys;
+      buckets_[keys.first].push_back(var);
+      if (!keys.second.empty()) buckets_[keys.second].push_back(var);
+    }
+  }
+
+  /*!
+   * \brief The candidate vars of a pattern node.
+   * \return The candidates in binding order, or nullptr if the pattern is not indexed.
+   */
+  const std::vector<const VarNode*>* Candidates(const DFPatternNode* pattern) {
+    if (!enabled_) return nullptr;
+    const std::string& key = PatternKey(pattern);
+    if (key.empty()) return nullptr;
+    auto it = buckets_.find(key);
+    return it == buckets_.end() ? &empty_bucket_ : &it->second;
+  }
+
+  /*! \brief Whether the pattern node matches the var, memoized. */
+  bool Match(const DFPatternNode* pattern, const VarNode* var) {
+    if (!enabled_) return matcher_.Match(GetRef<DFPattern>(pattern), GetRef<Var>(var));
+    const std::string& key = PatternKey(pattern);
+    if (!key.empty()) {
+      auto it = var2keys_.find(var);
+      if (it == var2keys_.end() || (it->second.first != key && it->second.second != key)) {
+        return false;
+      }
+    }
+    auto memo_key = std::make_pair(pattern, var);
+    auto it = memo_.find(memo_key);
+    if (it != memo_.end()) return it->second;
+    bool matched = matcher_.Match(GetRef<DFPattern>(pattern), GetRef<Var>(var));
+    memo_.emplace(memo_key, matched);
+    return matched;
+  }
+
+ private:
+  /*!
+   * \brief The index key of a pattern, empty if it may match values of any op.
+   * \note Patterns of relax.divide and relax.multiply are not indexed, as the matcher
+   *  also accepts their associated forms whose outermost op differs.
+   */
+  const std::string& PatternKey(const DFPatternNode* pattern) {
+    auto it = pattern_keys_.find(pattern);
+    if (it != pattern_keys_.end()) return it->second;
+    std::string key;
+    if (const auto* call = GetRef<DFPattern>(pattern).as<CallPatternNode>()) {
+      const auto* op_pattern = call->op.as<ExprPatternNode>();
+      const OpNode* op = op_pattern ? op_pattern->expr.as<OpNode>() : nullptr;
+      if (op != nullptr && op->name != "relax.divide" && op->name != "relax.multiply") {
+        key = op->name;
+        if (op->name == "relax.call_tir" && call->args.defined() && !call->args.empty()) {
+          if (const auto* extern_fn = call->args[0].as<ExternFuncPatternNode>()) {
+            if (!extern_fn->global_symbol().empty()) {
+              key += "/" + std::string(extern_fn->global_symbol());
+            }
+          } else if (const auto* gvar = call->args[0].as<GlobalVarPatternNode>()) {
+            if (!gvar->name_hint().empty()) key += "/" + std::string(gvar->name_hint());
+          }
+        }
+      }
+    }
+    return pattern_keys_.emplace(pattern, std::move(key)).first->second;
+  }
+
+  /*! \brief The op key and the callee key of a bound value, empty if not a call to an op. */
+  static std::pair<std::string, std::string> ValueKeys(Expr value,
+                                                       const runtime::Map<Var, Expr>& var2val) {
+    std::pair<std::string, std::string> keys;
+    // The matcher looks through vars bound to other vars.
+    while (const auto* var = value.as<VarNode>()) {
+      Optional<Expr> bound = var2val.Get(GetRef<Var>(var));
+      if (!bound.defined()) break;
+      value = bound.value();
+    }
+    const auto* call = value.as<CallNode>();
+    const OpNode* op = call ? call->op.as<OpNode>() : nullptr;
+    if (op == nullptr) return keys;
+    keys.first = op->name;
+    if (op->name == "relax.call_tir" && !call->args.empty()) {
+      Expr callee = call->args[0];
+      if (const auto* var = callee.as<VarNode>()) {
+        callee = var2val.Get(GetRef<Var>(var)).value_or(callee);
+      }
+      if (const auto* extern_fn = callee.as<ExternFuncNode>()) {
+        keys.second = op->name + "/" + std::string(extern_fn->global_symbol);
+      } else if (const auto* gvar = callee.as<GlobalVarNode>()) {
+        keys.second = op->name + "/" + std::string(gvar->name_hint);
+      }
+    }
+    return keys;
+  }
+
+  /*! \brief The matcher checking a single pattern node against a var. */
+  DFPatternMatcher matcher_;
+  /*! \brief Whether the index and the memo are used. */
+  bool enabled_;
+  /*! \brief The (op key, callee key) of each var bound to a call to an op. */
+  std::unordered_map<const VarNode*, std::pair<std::string, std::string>> var2keys_;
+  /*! \brief The vars of each key, in binding order. */
+  std::unordered_map<std::string, std::vector<const VarNode*>> buckets_;
+  /*! \brief The cached index keys of the pattern nodes. */
+  std::unordered_map<const DFPatternNode*, std::string> pattern_keys_;
+  /*! \brief The memoized results of Match. */
+  std::map<std::pair<const DFPatternNode*, const VarNode*>, bool> memo_;
+  /*! \brief The bucket of keys no var has. */
+  const std::vector<const VarNode*> empty_bucket_;
+};
+
 /**
  * \brief This method try to match a real node and a pattern node along with its neighbors.
  */
-static bool try_match(PNode* p, RNode* r, DFPatternMatcher* m,
+static bool try_match(PNode* p, RNode* r, MatcherIndex* m,
                       const std::map<const VarNode*, std::set<const VarNode*>>& def2use,
                       const std::map<const VarNode*, std::vector<const VarNode*>>& use2def) {
   if (nullptr != p->matched && p->matched == r->ptr) return true;  // matched before.
-  if (!m->Match(GetRef<DFPattern>(p->ptr), GetRef<Var>(r->ptr))) return false;
+  // VF2-style look-ahead: every neighbor of p has to be matched to a distinct neighbor of r.
+  if (p->parents.size() > r->parents.size() || p->children.size() > r->children.size()) {
+    return false;
+  }
+  if (!m->Match(p->ptr, r->ptr)) return false;
 
   std::stack<std::pair<PNode*, RNode*>> undo_stack{};
 
@@ -665,7 +800,8 @@ class MatcherUseDefAnalysis : public relax::ExprVisitor {
 };
 
 tvm::runtime::Map<DFPattern, Var> MatchGraph(const PatternContext& ctx, const DataflowBlock& dfb,
-                                             Optional<Var> start_hint, bool must_include_hint) {
+                                             Optional<Var> start_hint, bool must_include_hint,
+                                             bool use_index) {
   tvm::runtime::Map<DFPattern, Var> ret{};
   // TODO(@ganler): Handle non-may external use.
   ICHECK(ctx->allow_extern_use == PatternContextNode::kMay) << "Only kMay is supported yet.";
@@ -673,7 +809,7 @@ tvm::runtime::Map<DFPattern, Var> MatchGraph(const PatternContext& ctx, const Da
       << "must_include_hint is only supported with start_hint.";
 
   const auto var2val = AnalyzeVar2Value(dfb);
-  DFPatternMatcher matcher(var2val);
+  MatcherIndex matcher(dfb, var2val, use_index);
 
   // std::map<const VarNode*, std::set<const VarNode*>>
   MatcherUseDefAnalysis ud_analysis;
@@ -731,17 +867,46 @@ tvm::runtime::Map<DFPattern, Var> MatchGraph(const PatternContext& ctx, const Da
     if (must_include_hint) return ret;
   }
 
-  PNode* pnode_start = &pattern2node.begin()->second;
+  // Start from the most constrained pattern node, i.e. the one with the fewest candidates.
+  PNode* pnode_start = nullptr;
+  const std::vector<const VarNode*>* start_candidates = nullptr;
+  size_t min_num_candidates = std::numeric_limits<size_t>::max();
+  for (auto& ppair : pattern2node) {
+    const std::vector<const VarNode*>* candidates = matcher.Candidates(ppair.first);
+    size_t num_candidates = candidates ? candidates->size() : var2node.size();
+    if (pnode_start == nullptr || num_candidates < min_num_candidates) {
+      pnode_start = &ppair.second;
+      start_candidates = candidates;
+      min_num_candidates = num_candidates;
+    }
+  }
 
-  if (!pnode_start->matched) {
-    for (auto& rpair : var2node) {
-      if (start_hint.defined() && start_hint.value().get() == rpair.first) continue;
-      if (try_match(pnode_start, &rpair.second, &matcher, def2use, caller2callees)) {
-        for (auto ppair : pattern2node)
-          ret.Set(GetRef<DFPattern>(ppair.first), GetRef<Var>(ppair.second.matched));
+  const auto try_start = [&](const VarNode* var, RNode* rnode) {
+    if (start_hint.defined() && start_hint.value().get() == var) return false;
+    return try_match(pnode_start, rnode, &matcher, def2use, caller2callees);
+  };
 
-        return ret;
+  if (!pnode_start->matched) {
+    bool found = false;
+    if (start_candidates != nullptr) {
+      for (const VarNode* var : *start_candidates) {
+        auto it = var2node.find(var);
+        if (it != var2node.end() && try_start(var, &it->second)) {
+          found = true;
+          break;
+        }
       }
+    } else {
+      for (auto& rpair : var2node) {
+        if (try_start(rpair.first, &rpair.second)) {
+          found = true;
+          break;
+        }
+      }
+    }
+    if (found) {
+      for (auto ppair : pattern2node)
+        ret.Set(GetRef<DFPattern>(ppair.first), GetRef<Var>(ppair.second.matched));
     }
   }
 
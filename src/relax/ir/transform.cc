@@ -143,11 +143,18 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
   for (const auto& it : updated_mod->functions) {
     // only picks up relax::Function
     if (auto* n = it.second.as<FunctionNode>()) {
-      Function func = GetRef<Function>(n);
-      auto updated_func = SkipFunction(func) ? func : pass_func(func, updated_mod, pass_ctx);
-      updates.push_back({it.first, updated_func});
+      updates.push_back({it.first, GetRef<Function>(n)});
     }
   }
+  // `updated_mod` is only read while the functions are transformed, so that thread-safe passes
+  // can process them concurrently. Updates are applied afterwards in the original order.
+  ParallelForEachFunction(pass_ctx, GetFunctionPassNumThreads(pass_ctx, pass_info),
+                          updates.size(), [&](int task_id) {
+                            Function& func = updates[task_id].second;
+                            if (!SkipFunction(func)) {
+                              func = pass_func(func, updated_mod, pass_ctx);
+                            }
+                          });
 
   for (const auto& pair : updates) {
     updated_mod->Add(pair.first, pair.second, true);
@@ -172,8 +179,8 @@ bool FunctionPassNode::SkipFunction(const Function& func) const {
 
 Pass CreateFunctionPass(
     const runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required, bool traceable) {
-  PassInfo pass_info = PassInfo(opt_level, name, required, traceable);
+    int opt_level, String name, tvm::Array<String> required, bool traceable, bool thread_safe) {
+  PassInfo pass_info = PassInfo(opt_level, name, required, traceable, thread_safe);
   return FunctionPass(pass_func, pass_info);
 }
 
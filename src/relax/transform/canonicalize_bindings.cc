@@ -154,7 +154,8 @@ Pass CanonicalizeBindings() {
       [=](Function f, IRModule m, PassContext pc) {
         return Downcast<Function>(CanonicalizeBindings(f));
       };
-  return CreateFunctionPass(pass_func, 1, "CanonicalizeBindings", {});
+  return CreateFunctionPass(pass_func, 1, "CanonicalizeBindings", {}, /*traceable=*/false,
+                            /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("relax.transform.CanonicalizeBindings").set_body_typed(CanonicalizeBindings);
@@ -26,6 +26,10 @@
 #include <tvm/tir/function.h>
 #include <tvm/tir/op.h>
 
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 namespace tvm {
 namespace relax {
 
@@ -33,7 +37,93 @@ class ConstantFolder : public ExprMutator {
  public:
   explicit ConstantFolder(IRModule ctx_module) : ctx_module_(ctx_module) {}
 
+  /*!
+   * \brief Build all the PrimFuncs that may be folded in expr together in a single module,
+   * so that folding does not compile (and JIT) them one at a time.
+   * \param expr The expression to be folded.
+   */
+  void PrebuildFoldableFuncs(const Expr& expr) {
+    std::vector<tir::PrimFunc> funcs = FoldableCallTIRCollector::Collect(this, expr);
+    if (funcs.size() < 2) return;
+
+    Target eval_cpu_target{"llvm"};
+    bool noalias = transform::PassContext::Current()
+                       ->GetConfig<Bool>("tir.noalias", Bool(true))
+                       .value();
+    Map<GlobalVar, BaseFunc> functions;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < funcs.size(); ++i) {
+      std::string name = "tir_function_" + std::to_string(i);
+      tir::PrimFunc f = WithAttr(funcs[i], tvm::attr::kGlobalSymbol, String(name));
+      if (noalias) {
+        f = WithAttr(std::move(f), "tir.noalias", Bool(true));
+      }
+      functions.Set(GlobalVar(name), f);
+      names.push_back(name);
+    }
+    try {
+      runtime::Module rt_module =
+          build(LowerModule(IRModule(functions)), eval_cpu_target, eval_cpu_target);
+      for (size_t i = 0; i < funcs.size(); ++i) {
+        func_build_cache_[funcs[i]] = rt_module.GetFunction(names[i]);
+      }
+    } catch (const tvm::Error& err) {
+      // Some of the functions cannot be built for CPU. Leave all of them to GetCachedBuild,
+      // which builds (or skips) each function separately.
+      DLOG(WARNING) << "Batched build failure, falling back to per-function build. "
+                    << "Error message: " << err.what();
+    }
+  }
+
  private:
+  /*!
+   * \brief Collect the distinct PrimFuncs of call_tir calls that are foldable, either
+   * directly or after folding the calls they depend on.
+   */
+  class FoldableCallTIRCollector : public ExprVisitor {
+   public:
+    static std::vector<tir::PrimFunc> Collect(ConstantFolder* folder, const Expr& expr) {
+      FoldableCallTIRCollector collector(folder);
+      collector.VisitExpr(expr);
+      return std::move(collector.funcs_);
+    }
+
+   private:
+    explicit FoldableCallTIRCollector(ConstantFolder* folder) : folder_(folder) {}
+
+    void VisitBinding_(const VarBindingNode* binding) final {
+      ExprVisitor::VisitBinding_(binding);
+      if (IsFoldable(binding->value)) {
+        foldable_vars_.insert(binding->var.get());
+      }
+    }
+
+    bool IsFoldable(const Expr& expr) {
+      if (expr.as<relax::ConstantNode>()) return true;
+      if (const auto* var = expr.as<VarNode>()) return foldable_vars_.count(var);
+      static const Op& call_tir_op = Op::Get("relax.call_tir");
+      const auto* call = expr.as<CallNode>();
+      if (!call || !call->op.same_as(call_tir_op) || call->args.size() < 3) return false;
+      Optional<tir::PrimFunc> func = folder_->MatchPrimFunc(call->args[0]);
+      const auto* args = call->args[1].as<TupleNode>();
+      if (!func || !args || !MatchConstShape(call->args[2]) || call->type_args.size() != 1) {
+        return false;
+      }
+      for (const Expr& arg : args->fields) {
+        if (!IsFoldable(arg)) return false;
+      }
+      if (visited_funcs_.insert(func.value()).second) {
+        funcs_.push_back(func.value());
+      }
+      return true;
+    }
+
+    ConstantFolder* folder_;
+    std::unordered_set<const VarNode*> foldable_vars_;
+    std::unordered_set<tir::PrimFunc, StructuralHash, StructuralEqual> visited_funcs_;
+    std::vector<tir::PrimFunc> funcs_;
+  };
+
   /*!
    * \brief Pattern match expr to a constant shape and get runtime shape tuple from it.
    * \return The runtime shape tuple, or nullopt if it is not a constant shape.
@@ -83,6 +173,8 @@ class ConstantFolder : public ExprMutator {
   /*!
    * \brief Get a cached build version of func
    * \return The cached func, nullopt if func cannot be built.
+   * \note Besides this per-pass cache, builds are served from the persistent kernel cache
+   *       across runs when "codegen.kernel_cache_dir" is set in the PassContext.
    */
   Optional<PackedFunc> GetCachedBuild(tir::PrimFunc func) {
     // TODO(tvm-team): consider another way of bulk extract and build PrimFunc once
@@ -207,6 +299,7 @@ Pass FoldConstant() {
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function f, IRModule m, PassContext pc) {
         ConstantFolder folder(m);
+        folder.PrebuildFoldableFuncs(f);
         return Downcast<Function>(folder(f));
       };
   return CreateFunctionPass(pass_func, 0, "FoldConstant", {});
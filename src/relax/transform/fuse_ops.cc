@@ -27,9 +27,17 @@
  * A follow-up pass named "FuseTIR" will generate a TIR PrimFunc for each grouped function.
  */
 
+#include <tvm/relax/analysis.h>
 #include <tvm/relax/expr_functor.h>
 #include <tvm/relax/transform.h>
+#include <tvm/runtime/registry.h>
 #include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "../../relay/analysis/graph_partitioner.h"
 #include "../../support/arena.h"
@@ -85,6 +93,17 @@ using support::LinkNode;
 constexpr uint32_t kMaxFusedOps = 256;
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.max_depth", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.cost_model", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.cache_bytes", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.report", Bool);
+
+/*! \brief The default cache budget of the analytical fusion cost model, in bytes. */
+constexpr int kDefaultFusionCacheBytes = 1 << 20;
+/*!
+ * \brief The arithmetic intensity, in store iterations per byte moved, above which the analytical
+ * fusion cost model takes a fused kernel to be compute bound.
+ */
+constexpr double kComputeBoundIntensity = 4.0;
 
 class GraphCreator : public ExprVisitor {
  public:
@@ -756,23 +775,249 @@ class OperatorFusor : public ExprMutator {
   std::unordered_map<GraphPartitioner::Group*, FunctionCreator> group2func_;
 };
 
-IRModule FuseOps(IRModule mod, int opt_level, size_t max_fuse_depth) {
+/*!
+ * \brief The analytical estimate of the memory traffic of a group of bindings, computed from the
+ * buffers of the PrimFuncs called by call_tir.
+ */
+struct FusionCostEstimate {
+  /*! \brief The bytes read and written when each binding runs as its own kernel. */
+  int64_t bytes_moved_unfused = 0;
+  /*! \brief The bytes read and written when the group runs as one kernel. */
+  int64_t bytes_moved_fused = 0;
+  /*! \brief The total size of the buffers the fused kernel touches. */
+  int64_t working_set_bytes = 0;
+  /*! \brief The number of BufferStore iterations, as a proxy of the arithmetic operations. */
+  int64_t store_iterations = 0;
+  /*! \brief Whether the group contains a reduction or an OutEWiseFusable op. */
+  bool has_reduction = false;
+  /*! \brief Whether all the sizes are static, the estimate is meaningless otherwise. */
+  bool known = true;
+
+  /*! \brief The memory traffic the fusion saves. */
+  int64_t bytes_saved() const { return bytes_moved_unfused - bytes_moved_fused; }
+  /*! \brief The arithmetic intensity of the fused kernel, in store iterations per byte moved. */
+  double intensity() const {
+    return static_cast<double>(store_iterations) / std::max<int64_t>(bytes_moved_fused, 1);
+  }
+};
+
+/*! \brief Count the innermost loop iterations of a PrimFunc, one per BufferStore. */
+class IterationCounter : public tir::StmtVisitor {
+ public:
+  static int64_t Count(const tir::PrimFunc& func, bool* known) {
+    IterationCounter counter;
+    counter(func->body);
+    *known &= counter.known_;
+    return counter.count_;
+  }
+
+ private:
+  void VisitStmt_(const tir::ForNode* op) final {
+    int64_t extent = 1;
+    if (const auto* imm = op->extent.as<IntImmNode>()) {
+      extent = imm->value;
+    } else {
+      known_ = false;
+    }
+    int64_t outer = trip_count_;
+    trip_count_ *= extent;
+    tir::StmtVisitor::VisitStmt_(op);
+    trip_count_ = outer;
+  }
+
+  void VisitStmt_(const tir::BufferStoreNode* op) final {
+    count_ += trip_count_;
+    tir::StmtVisitor::VisitStmt_(op);
+  }
+
+  int64_t trip_count_ = 1;
+  int64_t count_ = 0;
+  bool known_ = true;
+};
+
+/*! \brief The size of a buffer in bytes, or -1 if its shape is not static. */
+static int64_t BufferBytes(const tir::Buffer& buffer) {
+  int64_t bytes = (buffer->dtype.bits() * buffer->dtype.lanes() + 7) / 8;
+  for (const PrimExpr& dim : buffer->shape) {
+    const auto* imm = dim.as<IntImmNode>();
+    if (imm == nullptr) return -1;
+    bytes *= imm->value;
+  }
+  return bytes;
+}
+
+/*!
+ * \brief Estimate the memory traffic of running a group of bindings as one fused kernel.
+ * \param mod The IRModule holding the PrimFuncs called by the bindings.
+ * \param group The bindings of the group, from bound var to value.
+ * \return The estimate.
+ */
+FusionCostEstimate EstimateFusionCost(const IRModule& mod, const Map<Var, Expr>& group) {
+  static const Op& call_tir_op = Op::Get("relax.call_tir");
+  FusionCostEstimate estimate;
+  // The bytes of each tensor read by the group, and of each tensor written by it.
+  std::unordered_map<const Object*, int64_t> input_bytes;
+  std::unordered_map<const Object*, int64_t> output_bytes;
+  std::unordered_set<const Object*> consumed;
+  for (const auto& kv : group) {
+    const auto* call = kv.second.as<CallNode>();
+    if (call == nullptr || call->op != call_tir_op) continue;
+    const auto* gvar = call->args[0].as<GlobalVarNode>();
+    Optional<BaseFunc> base_func =
+        gvar != nullptr ? mod->functions.Get(GetRef<GlobalVar>(gvar)) : Optional<BaseFunc>();
+    const auto* func = base_func.as<tir::PrimFuncNode>();
+    if (func == nullptr) {
+      estimate.known = false;
+      continue;
+    }
+    Array<Expr> args;
+    if (const auto* tuple = call->args[1].as<TupleNode>()) {
+      args = tuple->fields;
+    } else {
+      args = {call->args[1]};
+    }
+    size_t num_tir_vars = call->args.size() > 3 ? 1 : 0;
+    if (func->params.size() < args.size() + num_tir_vars) {
+      estimate.known = false;
+      continue;
+    }
+    size_t num_outputs = func->params.size() - args.size() - num_tir_vars;
+    int64_t out_bytes = 0;
+    for (size_t i = 0; i < args.size() + num_outputs; ++i) {
+      Optional<tir::Buffer> buffer = func->buffer_map.Get(func->params[i]);
+      int64_t bytes = buffer.defined() ? BufferBytes(buffer.value()) : -1;
+      if (bytes < 0) {
+        estimate.known = false;
+        bytes = 0;
+      }
+      estimate.bytes_moved_unfused += bytes;
+      if (i < args.size()) {
+        input_bytes[args[i].get()] = bytes;
+        consumed.insert(args[i].get());
+      } else {
+        out_bytes += bytes;
+      }
+    }
+    output_bytes[kv.first.get()] = out_bytes;
+    estimate.store_iterations +=
+        IterationCounter::Count(GetRef<tir::PrimFunc>(func), &estimate.known);
+    Optional<Integer> pattern = func->GetAttr<Integer>("op_pattern");
+    if (pattern.defined() && (pattern.value()->value == relay::kCommReduce ||
+                              pattern.value()->value == relay::kOutEWiseFusable)) {
+      estimate.has_reduction = true;
+    }
+  }
+  // Tensors produced inside the group never leave the fused kernel, unless nothing in the
+  // group consumes them, in which case they are outputs of the group.
+  for (const auto& kv : input_bytes) {
+    if (!output_bytes.count(kv.first)) {
+      estimate.bytes_moved_fused += kv.second;
+      estimate.working_set_bytes += kv.second;
+    }
+  }
+  for (const auto& kv : output_bytes) {
+    if (!consumed.count(kv.first)) {
+      estimate.bytes_moved_fused += kv.second;
+    }
+    estimate.working_set_bytes += kv.second;
+  }
+  return estimate;
+}
+
+/*!
+ * \brief The analytical fusion cost model. A group without reduction streams over its tensors
+ * once and is always fused. A group with a reduction is fused when the working set of the fused
+ * kernel fits in the cache budget, or when the kernel is compute bound (see
+ * kComputeBoundIntensity), since the cache misses are then hidden behind its arithmetic.
+ */
+bool AnalyticalFusionCostModel(const FusionCostEstimate& estimate, int64_t cache_bytes) {
+  if (!estimate.known || !estimate.has_reduction) return true;
+  return estimate.working_set_bytes <= cache_bytes ||
+         estimate.intensity() >= kComputeBoundIntensity;
+}
+
+IRModule FuseOps(IRModule mod, int opt_level, size_t max_fuse_depth,
+                 Optional<String> cost_model = NullOpt,
+                 int64_t cache_bytes = kDefaultFusionCacheBytes, bool emit_report = false) {
   support::Arena arena;
 
   // Step 1. Create the indexed-forward graph according to the input IRModule.
   IndexedForwardGraph graph = GraphCreator::Create(mod, &arena);
 
-  // Step 2. Partition the graph by applying the fusion algorithm.
+  // Step 2. Partition the graph by applying the fusion algorithm. With a cost model, each fusion
+  // allowed by the op patterns is also checked by the model, and the decisions are reported when
+  // emit_report is set.
+  GraphPartitioner::FCheckFusion fcheck_fusion = nullptr;
+  Array<Map<String, ObjectRef>> report;
+  Map<Var, Expr> var2val;
+  if (cost_model.defined()) {
+    bool analytical = cost_model.value() == "analytical";
+    const runtime::PackedFunc* f = nullptr;
+    if (!analytical) {
+      f = runtime::Registry::Get(cost_model.value());
+      CHECK(f != nullptr) << "ValueError: The fusion cost model " << cost_model.value()
+                          << " is neither \"analytical\" nor a registered global function";
+    }
+    var2val = AnalyzeVar2Value(mod);
+    fcheck_fusion = [&, analytical, f](const std::vector<IndexedForwardGraph::Node*>& fused_nodes,
+                                       IndexedForwardGraph::Node* sink) {
+      Map<Var, Expr> group;
+      for (const IndexedForwardGraph::Node* node : fused_nodes) {
+        if (!node->ref->IsInstance<VarNode>()) continue;
+        Var var = GetRef<Var>(static_cast<const VarNode*>(node->ref));
+        if (Optional<Expr> value = var2val.Get(var)) {
+          group.Set(var, value.value());
+        }
+      }
+      FusionCostEstimate estimate;
+      if (analytical || emit_report) {
+        estimate = EstimateFusionCost(mod, group);
+      }
+      bool fuse = analytical ? AnalyticalFusionCostModel(estimate, cache_bytes)
+                             : static_cast<bool>((*f)(mod, group));
+      if (!emit_report) return fuse;
+      String sink_name = sink->ref->IsInstance<VarNode>()
+                             ? static_cast<const VarNode*>(sink->ref)->name_hint()
+                             : String("");
+      auto make_int = [](int64_t value) { return IntImm(DataType::Int(64), value); };
+      report.push_back({{"sink", sink_name},
+                        {"num_ops", make_int(static_cast<int64_t>(group.size()))},
+                        {"fused", Bool(fuse)},
+                        {"bytes_saved", make_int(estimate.bytes_saved())},
+                        {"working_set_bytes", make_int(estimate.working_set_bytes)},
+                        {"store_iterations", make_int(estimate.store_iterations)},
+                        {"intensity", FloatImm(DataType::Float(64), estimate.intensity())}});
+      return fuse;
+    };
+  }
   std::vector<GraphPartitioner::Group*> groups =
-      GraphPartitioner(&arena, opt_level, max_fuse_depth).Partition(graph);
+      GraphPartitioner(&arena, opt_level, max_fuse_depth, fcheck_fusion).Partition(graph);
 
   // Step 3. Transform the IRModule by fusing the operators in accordance with the graph partition
   // results.
   mod = OperatorFusor(mod, graph, groups).Transform();
 
+  if (emit_report) {
+    mod = WithAttr(std::move(mod), "fusion_report", report);
+  }
   return mod;
 }
 
+TVM_REGISTER_GLOBAL("relax.analysis.estimate_fusion_cost")
+    .set_body_typed([](IRModule mod, Map<Var, Expr> group) {
+      FusionCostEstimate estimate = EstimateFusionCost(mod, group);
+      auto make_int = [](int64_t value) { return IntImm(DataType::Int(64), value); };
+      return Map<String, ObjectRef>{
+          {"bytes_moved_unfused", make_int(estimate.bytes_moved_unfused)},
+          {"bytes_moved_fused", make_int(estimate.bytes_moved_fused)},
+          {"bytes_saved", make_int(estimate.bytes_saved())},
+          {"working_set_bytes", make_int(estimate.working_set_bytes)},
+          {"store_iterations", make_int(estimate.store_iterations)},
+          {"intensity", FloatImm(DataType::Float(64), estimate.intensity())},
+          {"has_reduction", Bool(estimate.has_reduction)},
+          {"known", Bool(estimate.known)}};
+    });
+
 namespace transform {
 
 Pass FuseOps(int fuse_opt_level) {
@@ -780,7 +1025,12 @@ Pass FuseOps(int fuse_opt_level) {
       [=](IRModule m, PassContext pc) {
         int opt_level = fuse_opt_level == -1 ? pc->opt_level : fuse_opt_level;
         auto max_fuse_depth = pc->GetConfig("relax.FuseOps.max_depth", Integer(kMaxFusedOps));
-        return relax::FuseOps(m, opt_level, max_fuse_depth.value().IntValue());
+        auto cost_model = pc->GetConfig<String>("relax.FuseOps.cost_model");
+        auto cache_bytes = pc->GetConfig<Integer>("relax.FuseOps.cache_bytes",
+                                                  Integer(kDefaultFusionCacheBytes));
+        auto emit_report = pc->GetConfig<Bool>("relax.FuseOps.report", Bool(false));
+        return relax::FuseOps(m, opt_level, max_fuse_depth.value().IntValue(), cost_model,
+                              cache_bytes.value().IntValue(), emit_report.value());
       };
   return CreateModulePass(/*pass_function=*/pass_func,  //
                           /*opt_level=*/0,              //
@@ -20,6 +20,12 @@
 #include <tvm/relax/transform.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "../../relay/analysis/graph_partitioner.h"
 #include "../../support/arena.h"
 #include "../../tir/ir/functor_common.h"
@@ -216,16 +222,20 @@ class BlockNameDeduplicator : public tir::StmtMutator {
 
 namespace relax {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseTIR.reuse_intermediate_buffers", Bool);
+
 class FusedTIRConstructor : public ExprVisitor {
  public:
   /*!
    * \brief Construct a fused TIR PrimFunc from a relax sub-function
    * \param mod The IRModule
    * \param gv The global var of relax subfunction to be fused into one PrimFunc
+   * \param reuse_buffers Whether intermediate buffers whose lifetimes do not overlap share memory
    * \return The fused TIR PrimFunc
    */
-  static tir::PrimFunc GetFusedTIR(const IRModule& mod, const GlobalVar& gv) {
-    FusedTIRConstructor visitor(mod, gv->name_hint);
+  static tir::PrimFunc GetFusedTIR(const IRModule& mod, const GlobalVar& gv,
+                                   bool reuse_buffers = false) {
+    FusedTIRConstructor visitor(mod, gv->name_hint, reuse_buffers);
     BaseFunc f = mod->Lookup(gv);
     CHECK(f->IsInstance<relax::FunctionNode>())
         << "Expected relax functions, but got: " << f->GetTypeKey();
@@ -236,8 +246,8 @@ class FusedTIRConstructor : public ExprVisitor {
   }
 
  private:
-  explicit FusedTIRConstructor(const IRModule& mod, const String& func_name)
-      : mod_(mod), func_name_(func_name) {}
+  explicit FusedTIRConstructor(const IRModule& mod, const String& func_name, bool reuse_buffers)
+      : mod_(mod), func_name_(func_name), reuse_buffers_(reuse_buffers) {}
 
   void VisitExpr_(const FunctionNode* func) final {
     // Step 1. Create buffers for function params
@@ -411,6 +421,8 @@ class FusedTIRConstructor : public ExprVisitor {
               ICHECK(shape_expr.as<IntImmNode>()) << "Only support constant shape fusion for now";
             }
             func_info_.buffer_subst_map.Set(buffer, target_buffer);
+            // The intermediate buffer is read by the body being fused.
+            func_info_.buffer_last_use[target_buffer.get()] = func_info_.bodies.size() - 1;
             buffer_idx++;
           }
         }
@@ -460,6 +472,8 @@ class FusedTIRConstructor : public ExprVisitor {
       const tir::Var& param = func->params[n - output_size + i];
       const tir::Buffer& buffer = func->buffer_map.at(param);
       func_info_.alloc_buffers.push_back(buffer);
+      func_info_.intermediate_buffers.push_back(buffer);
+      func_info_.buffer_def[buffer.get()] = func_info_.bodies.size() - 1;
       alloc_buffers.push_back(buffer);
     }
     // Update expr2buffers
@@ -522,10 +536,16 @@ class FusedTIRConstructor : public ExprVisitor {
     Map<String, ObjectRef> attr_map;
     attr_map.Set("tir.noalias", tir::const_true());
     ICHECK(func_info_.global_name != "fused");
-    // Remove output buffers from func_info_.alloc_buffers
+    std::unordered_set<const tir::BufferNode*> reused_buffers;
+    if (reuse_buffers_) {
+      reused_buffers = ReuseIntermediateBuffers();
+    }
+    // Remove output buffers and the buffers sharing memory with others from
+    // func_info_.alloc_buffers
     Array<tir::Buffer> alloc_buffers;
     for (const tir::Buffer& buf : func_info_.alloc_buffers) {
-      if (func_info_.output_buffers.count(buf.get()) == 0) {
+      if (func_info_.output_buffers.count(buf.get()) == 0 &&
+          reused_buffers.count(buf.get()) == 0) {
         alloc_buffers.push_back(buf);
       }
     }
@@ -538,6 +558,67 @@ class FusedTIRConstructor : public ExprVisitor {
     return func;
   }
 
+  /*!
+   * \brief Let intermediate buffers with the same shape and dtype share memory when their
+   * lifetimes do not overlap, and update `func_info_.buffer_subst_map` accordingly.
+   *
+   * The lifetime of an intermediate buffer spans from the body that writes it to the last body
+   * that reads it. A buffer reuses the memory of an earlier one only when that buffer is last read
+   * strictly before the buffer is written, so that no body reads and writes the same memory.
+   * \return The buffers which are replaced by an earlier buffer and need no allocation.
+   */
+  std::unordered_set<const tir::BufferNode*> ReuseIntermediateBuffers() {
+    // A piece of memory, i.e. the buffer that allocates it and the last body reading it.
+    struct Slot {
+      tir::Buffer buffer;
+      size_t last_use;
+    };
+    auto f_compatible = [](const tir::Buffer& a, const tir::Buffer& b) {
+      return a->dtype == b->dtype && a.scope() == b.scope() && a->strides.empty() &&
+             b->strides.empty() && StructuralEqual()(a->shape, b->shape);
+    };
+
+    std::vector<Slot> slots;
+    Map<tir::Buffer, tir::Buffer> reuse_map;
+    std::unordered_set<const tir::BufferNode*> reused_buffers;
+    // Intermediate buffers are visited in the order they are written.
+    for (const tir::Buffer& buffer : func_info_.intermediate_buffers) {
+      if (func_info_.output_buffers.count(buffer.get())) {
+        continue;
+      }
+      size_t def = func_info_.buffer_def.at(buffer.get());
+      auto it_use = func_info_.buffer_last_use.find(buffer.get());
+      size_t last_use = it_use == func_info_.buffer_last_use.end() ? def : it_use->second;
+      auto it_slot = std::find_if(slots.begin(), slots.end(), [&](const Slot& slot) {
+        return slot.last_use < def && f_compatible(slot.buffer, buffer);
+      });
+      if (it_slot != slots.end()) {
+        reuse_map.Set(buffer, it_slot->buffer);
+        reused_buffers.insert(buffer.get());
+        it_slot->last_use = last_use;
+      } else {
+        slots.push_back(Slot{buffer, last_use});
+      }
+    }
+
+    // Redirect the params already mapped to a reused buffer, then substitute the reused buffers
+    // themselves in the bodies which write them.
+    std::vector<std::pair<tir::Buffer, tir::Buffer>> updates;
+    for (const auto& kv : func_info_.buffer_subst_map) {
+      auto it = reuse_map.find(kv.second);
+      if (it != reuse_map.end()) {
+        updates.emplace_back(kv.first, (*it).second);
+      }
+    }
+    for (const auto& kv : updates) {
+      func_info_.buffer_subst_map.Set(kv.first, kv.second);
+    }
+    for (const auto& kv : reuse_map) {
+      func_info_.buffer_subst_map.Set(kv.first, kv.second);
+    }
+    return reused_buffers;
+  }
+
   /*! \brief Get DynTensor numbers from recursive Tuples. */
   static size_t GetTotalTensorSize(const Type& type) {
     if (type.as<DynTensorTypeNode>()) {
@@ -580,6 +661,12 @@ class FusedTIRConstructor : public ExprVisitor {
     Map<tir::Var, tir::Buffer> buffer_map;
     /*! \brief The output buffers in the function buffer_map*/
     std::unordered_set<const tir::BufferNode*> output_buffers;
+    /*! \brief The buffers holding intermediate results, in the order they are written. */
+    Array<tir::Buffer> intermediate_buffers;
+    /*! \brief The index of the body which writes each intermediate buffer. */
+    std::unordered_map<const tir::BufferNode*, size_t> buffer_def;
+    /*! \brief The index of the last body which reads each intermediate buffer. */
+    std::unordered_map<const tir::BufferNode*, size_t> buffer_last_use;
     /*! \brief The name of the fused function */
     std::string global_name = "fused";
   };
@@ -588,6 +675,8 @@ class FusedTIRConstructor : public ExprVisitor {
   const IRModule& mod_;
   /*! \brief The name hint for the input func. */
   String func_name_;
+  /*! \brief Whether intermediate buffers with disjoint lifetimes share memory. */
+  bool reuse_buffers_;
   /*! \brief The helper info to fuse TIR prim_func */
   FuseFuncInfo func_info_;
   /*! \brief The tir function after fusion*/
@@ -599,7 +688,7 @@ class FusedTIRConstructor : public ExprVisitor {
  */
 class TIRFuseMutator : public ExprMutator {
  public:
-  static IRModule Transform(const IRModule& mod) {
+  static IRModule Transform(const IRModule& mod, bool reuse_buffers) {
     // Since TIRFuseMutator will delete bunch of PrimFunc, we create an empty block builder.
     TIRFuseMutator mutator(mod);
     // Step 1. Fuse all primitive relax functions, store the result in `fused_tir_funcs_`
@@ -608,7 +697,7 @@ class TIRFuseMutator : public ExprMutator {
       const BaseFunc& func = kv.second;
       // Only fuse primitive relax functions
       if (func->IsInstance<relax::FunctionNode>() && func->HasNonzeroAttr(attr::kPrimitive)) {
-        tir::PrimFunc fused_tir = FusedTIRConstructor::GetFusedTIR(mod, gv);
+        tir::PrimFunc fused_tir = FusedTIRConstructor::GetFusedTIR(mod, gv, reuse_buffers);
         mutator.fused_tir_funcs_.Set(gv, fused_tir);
       }
     }
@@ -692,16 +781,277 @@ class TIRFuseMutator : public ExprMutator {
   Map<GlobalVar, tir::PrimFunc> fused_tir_funcs_;
 };
 
-IRModule FuseTIR(IRModule mod) {
-  mod = TIRFuseMutator::Transform(mod);
+IRModule FuseTIR(IRModule mod, bool reuse_buffers) {
+  mod = TIRFuseMutator::Transform(mod, reuse_buffers);
   return mod;
 }
 
+/*!
+ * \brief Batch the independent call_tir bindings of a dataflow block that invoke structurally
+ * equal PrimFuncs into a single call_tir. The batched PrimFunc runs the bodies of all the original
+ * calls one after another and returns their outputs as a tuple, so that one kernel is
+ * dispatched instead of many.
+ *
+ * Example:
+ * q = call_tir(matmul, (x, wq), (n, d), dtype="float32")
+ * k = call_tir(matmul, (x, wk), (n, d), dtype="float32")
+ * -->
+ * qk = call_tir(matmul_horizontal, (x, wq, x, wk), ((n, d), (n, d)), ...)
+ * q = qk[0]
+ * k = qk[1]
+ */
+class HorizontalTIRFuseMutator : public ExprMutator {
+ public:
+  static IRModule Transform(const IRModule& mod) {
+    HorizontalTIRFuseMutator mutator(mod);
+    for (const auto& kv : mod->functions) {
+      const GlobalVar& gv = kv.first;
+      const BaseFunc& func = kv.second;
+      if (func->IsInstance<relax::FunctionNode>() && !func->HasNonzeroAttr(attr::kPrimitive)) {
+        relax::Function update_func = Downcast<Function>(mutator.VisitExpr(func));
+        mutator.builder_->UpdateFunction(gv, update_func);
+      }
+    }
+    return mutator.builder_->GetContextIRModule();
+  }
+
+ private:
+  explicit HorizontalTIRFuseMutator(const IRModule& mod) : ExprMutator(mod), mod_(mod) {
+    // Calls to structurally equal PrimFuncs bound to different GlobalVars, e.g. after modules
+    // are merged, are grouped together under the first such GlobalVar.
+    std::unordered_map<tir::PrimFunc, const GlobalVarNode*, StructuralHash, StructuralEqual>
+        representative;
+    for (const auto& kv : mod->functions) {
+      if (const auto* prim_func = kv.second.as<tir::PrimFuncNode>()) {
+        auto it = representative.emplace(GetRef<tir::PrimFunc>(prim_func), kv.first.get()).first;
+        canonical_gv_[kv.first.get()] = it->second;
+      }
+    }
+  }
+
+  using ExprMutator::VisitBindingBlock_;
+
+  BindingBlock VisitBindingBlock_(const DataflowBlockNode* block) final {
+    std::vector<std::vector<size_t>> groups = GroupIndependentCalls(block->bindings);
+    std::unordered_map<size_t, size_t> group_of_binding;
+    for (size_t i = 0; i < groups.size(); ++i) {
+      for (size_t pos : groups[i]) {
+        group_of_binding[pos] = i;
+      }
+    }
+
+    builder_->BeginDataflowBlock();
+    for (size_t pos = 0; pos < block->bindings.size(); ++pos) {
+      auto it = group_of_binding.find(pos);
+      if (it == group_of_binding.end()) {
+        this->VisitBinding(block->bindings[pos]);
+      } else if (groups[it->second].front() == pos) {
+        // The batched call is emitted at the position of the first member. The other members
+        // are dropped at their original positions.
+        EmitBatchedCall(block->bindings, groups[it->second]);
+      }
+    }
+    return builder_->EndBlock();
+  }
+
+  /*!
+   * \brief Group the call_tir bindings of a block which invoke structurally equal PrimFuncs. A
+   * call joins a group only if all its arguments and the symbolic vars of its output shape are
+   * defined before the first member of the group, so that the members are independent of each
+   * other and can all be computed at that position. A call that cannot join any group of its
+   * PrimFunc starts a new one, and the earlier groups stay open to later calls.
+   * \return The positions of the members of each group with at least two members.
+   */
+  std::vector<std::vector<size_t>> GroupIndependentCalls(const Array<Binding>& bindings) {
+    // The position of the binding that defines each var of the block.
+    std::unordered_map<const VarNode*, size_t> def_pos;
+    // The position of the match_shape that defines each symbolic var in the block.
+    std::unordered_map<const tir::VarNode*, size_t> sym_def_pos;
+    // The groups that calls to each representative PrimFunc can join.
+    std::unordered_map<const GlobalVarNode*, std::vector<size_t>> open_groups;
+    std::vector<std::vector<size_t>> groups;
+
+    auto f_defined_before = [&def_pos, &sym_def_pos](const Call& call, size_t pos) {
+      for (const Expr& arg : Downcast<Tuple>(call->args[1])->fields) {
+        if (const auto* var = arg.as<VarNode>()) {
+          auto it = def_pos.find(var);
+          if (it != def_pos.end() && it->second >= pos) {
+            return false;
+          }
+        }
+      }
+      bool defined = true;
+      for (const PrimExpr& dim : Downcast<ShapeExpr>(call->args[2])->values) {
+        tir::PostOrderVisit(dim, [&](const ObjectRef& obj) {
+          if (const auto* var = obj.as<tir::VarNode>()) {
+            auto it = sym_def_pos.find(var);
+            if (it != sym_def_pos.end() && it->second >= pos) {
+              defined = false;
+            }
+          }
+        });
+      }
+      return defined;
+    };
+
+    for (size_t pos = 0; pos < bindings.size(); ++pos) {
+      if (const auto* binding = bindings[pos].as<VarBindingNode>()) {
+        if (IsBatchableCall(binding->value)) {
+          Call call = Downcast<Call>(binding->value);
+          const GlobalVarNode* gv = canonical_gv_.at(call->args[0].as<GlobalVarNode>());
+          std::vector<size_t>& candidates = open_groups[gv];
+          auto it = std::find_if(candidates.begin(), candidates.end(), [&](size_t group) {
+            return f_defined_before(call, groups[group].front());
+          });
+          if (it != candidates.end()) {
+            groups[*it].push_back(pos);
+          } else {
+            candidates.push_back(groups.size());
+            groups.push_back({pos});
+          }
+        }
+        def_pos[binding->var.get()] = pos;
+      } else if (const auto* match_shape = bindings[pos].as<MatchShapeNode>()) {
+        if (match_shape->var.defined()) {
+          def_pos[match_shape->var.get()] = pos;
+        }
+        // Only the first match_shape of a symbolic var defines it, the later ones check it.
+        for (const PrimExpr& dim : match_shape->pattern) {
+          if (const auto* var = dim.as<tir::VarNode>()) {
+            sym_def_pos.emplace(var, pos);
+          }
+        }
+      }
+    }
+
+    std::vector<std::vector<size_t>> result;
+    for (std::vector<size_t>& group : groups) {
+      if (group.size() >= 2) {
+        result.push_back(std::move(group));
+      }
+    }
+    return result;
+  }
+
+  /*!
+   * \brief Check whether a binding value is a call_tir that can be batched, i.e. it calls a
+   * schedulable PrimFunc whose params are the input buffers followed by one output buffer.
+   */
+  bool IsBatchableCall(const Expr& value) const {
+    static const Op& call_tir_op_ = Op::Get("relax.call_tir");
+    const auto* call = value.as<CallNode>();
+    if (call == nullptr || !call->op.same_as(call_tir_op_) || call->args.size() != 3 ||
+        call->type_args.size() != 1 || !call->type_args[0]->IsInstance<DynTensorTypeNode>()) {
+      return false;
+    }
+    const auto* gv = call->args[0].as<GlobalVarNode>();
+    const auto* args = call->args[1].as<TupleNode>();
+    if (gv == nullptr || args == nullptr || !call->args[2]->IsInstance<ShapeExprNode>()) {
+      return false;
+    }
+    auto it = mod_->functions.find(GetRef<GlobalVar>(gv));
+    if (it == mod_->functions.end()) {
+      return false;
+    }
+    const auto* prim_func = (*it).second.as<tir::PrimFuncNode>();
+    if (prim_func == nullptr || !prim_func->body->IsInstance<tir::BlockRealizeNode>() ||
+        prim_func->params.size() != args->fields.size() + 1) {
+      return false;
+    }
+    for (const tir::Var& param : prim_func->params) {
+      if (!prim_func->buffer_map.count(param)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /*! \brief Emit one call_tir for a group and rebind the original vars to its outputs. */
+  void EmitBatchedCall(const Array<Binding>& bindings, const std::vector<size_t>& group) {
+    static const Op& call_tir_op_ = Op::Get("relax.call_tir");
+    Array<tir::PrimFunc> members;
+    Array<Expr> args;
+    Array<Expr> output_shapes;
+    Array<Type> output_types;
+    for (size_t pos : group) {
+      Call call = Downcast<Call>(Downcast<VarBinding>(bindings[pos])->value);
+      members.push_back(Downcast<tir::PrimFunc>(mod_->Lookup(Downcast<GlobalVar>(call->args[0]))));
+      for (const Expr& arg : Downcast<Tuple>(call->args[1])->fields) {
+        args.push_back(this->VisitExpr(arg));
+      }
+      output_shapes.push_back(this->VisitExpr(call->args[2]));
+      output_types.push_back(call->type_args[0]);
+    }
+
+    const VarBindingNode* first = bindings[group.front()].as<VarBindingNode>();
+    GlobalVar callee = Downcast<GlobalVar>(Downcast<Call>(first->value)->args[0]);
+    GlobalVar batched_gv =
+        builder_->AddFunction(ConcatPrimFuncs(members), callee->name_hint + "_horizontal");
+    Call batched_call(call_tir_op_, {batched_gv, Tuple(args), Tuple(output_shapes)}, {},
+                      {TupleType(output_types)});
+    Var batched_var = builder_->Emit(batched_call, batched_gv->name_hint);
+
+    for (size_t i = 0; i < group.size(); ++i) {
+      Var var = this->VisitVarDef(Downcast<VarBinding>(bindings[group[i]])->var);
+      Expr output = builder_->Normalize(TupleGetItem(batched_var, i));
+      builder_->EmitNormalized(VarBinding(var, output));
+    }
+  }
+
+  /*!
+   * \brief Construct a PrimFunc which runs the bodies of the given PrimFuncs in sequence.
+   * \return The PrimFunc whose params are the inputs of all the members followed by their
+   * outputs.
+   */
+  static tir::PrimFunc ConcatPrimFuncs(const Array<tir::PrimFunc>& members) {
+    Array<tir::Var> inputs;
+    Array<tir::Var> outputs;
+    Map<tir::Var, tir::Buffer> buffer_map;
+    Array<tir::Buffer> alloc_buffers;
+    Array<tir::Stmt> bodies;
+    for (const tir::PrimFunc& member : members) {
+      // Renew all vars/buffer definitions and blocks to avoid duplication
+      tir::PrimFunc func = tir::RenewDefs(member);
+      for (size_t i = 0; i + 1 < func->params.size(); ++i) {
+        inputs.push_back(func->params[i]);
+      }
+      outputs.push_back(func->params.back());
+      for (const auto& kv : func->buffer_map) {
+        buffer_map.Set(kv.first, kv.second);
+      }
+      const tir::Block& root_block = Downcast<tir::BlockRealize>(func->body)->block;
+      alloc_buffers.insert(alloc_buffers.end(), root_block->alloc_buffers.begin(),
+                           root_block->alloc_buffers.end());
+      bodies.push_back(root_block->body);
+    }
+    Array<tir::Var> params = inputs;
+    params.insert(params.end(), outputs.begin(), outputs.end());
+
+    Map<String, ObjectRef> attr_map;
+    attr_map.Set("tir.noalias", tir::const_true());
+    tir::Stmt body = tir::BlockNameDeduplicator()(tir::SeqStmt::Flatten(bodies));
+    body = tir::Block({}, {}, {}, "root", std::move(body), NullOpt, alloc_buffers);
+    body = tir::BlockRealize({}, Bool(true), Downcast<tir::Block>(body));
+    return tir::PrimFunc(params, body, VoidType(), buffer_map, DictAttrs(attr_map));
+  }
+
+  /*! \brief The IRModule */
+  IRModule mod_;
+  /*! \brief The map from the GlobalVar of each PrimFunc to that of its group representative. */
+  std::unordered_map<const GlobalVarNode*, const GlobalVarNode*> canonical_gv_;
+};
+
+IRModule HorizontalFuseTIR(IRModule mod) { return HorizontalTIRFuseMutator::Transform(mod); }
+
 namespace transform {
 
 Pass FuseTIR() {
   runtime::TypedPackedFunc<IRModule(IRModule, PassContext)> pass_func =  //
-      [=](IRModule m, PassContext pc) { return relax::FuseTIR(m); };
+      [=](IRModule m, PassContext pc) {
+        bool reuse_buffers =
+            pc->GetConfig<Bool>("relax.FuseTIR.reuse_intermediate_buffers", Bool(false)).value();
+        return relax::FuseTIR(m, reuse_buffers);
+      };
   return CreateModulePass(/*pass_function=*/pass_func,  //
                           /*opt_level=*/0,              //
                           /*pass_name=*/"FuseTIR",      //
@@ -710,6 +1060,17 @@ Pass FuseTIR() {
 
 TVM_REGISTER_GLOBAL("relax.transform.FuseTIR").set_body_typed(FuseTIR);
 
+Pass HorizontalFuseTIR() {
+  runtime::TypedPackedFunc<IRModule(IRModule, PassContext)> pass_func =  //
+      [=](IRModule m, PassContext pc) { return relax::HorizontalFuseTIR(m); };
+  return CreateModulePass(/*pass_function=*/pass_func,        //
+                          /*opt_level=*/0,                    //
+                          /*pass_name=*/"HorizontalFuseTIR",  //
+                          /*required=*/{});
+}
+
+TVM_REGISTER_GLOBAL("relax.transform.HorizontalFuseTIR").set_body_typed(HorizontalFuseTIR);
+
 }  // namespace transform
 
 }  // namespace relax
@@ -189,7 +189,8 @@ namespace transform {
 Pass Normalize() {
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function f, IRModule m, PassContext pc) { return Downcast<Function>(Normalize(f)); };
-  return CreateFunctionPass(pass_func, 1, "Normalize", {});
+  return CreateFunctionPass(pass_func, 1, "Normalize", {}, /*traceable=*/false,
+                            /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("relax.transform.Normalize").set_body_typed(Normalize);
@@ -57,7 +57,8 @@ namespace transform {
 Pass ToNonDataflow() {
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function f, IRModule m, PassContext pc) { return Downcast<Function>(ToNonDataflow(f)); };
-  return CreateFunctionPass(pass_func, 0, "ToNonDataflow", {});
+  return CreateFunctionPass(pass_func, 0, "ToNonDataflow", {}, /*traceable=*/false,
+                            /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("relax.transform.ToNonDataflow").set_body_typed(ToNonDataflow);
@@ -23,7 +23,9 @@
  */
 #include <tvm/relax/tuning_api.h>
 
+#include <iterator>
 #include <set>
+#include <sstream>
 #include <thread>
 #include <unordered_map>
 
@@ -105,6 +107,18 @@ inline std::string get_database_key(int workload_idx, Target target) {
   return std::to_string(workload_idx) + "/" + target->str();
 }
 
+/*! \brief Extend a database key with the decision history of a trace (prefix). */
+inline std::string get_trace_prefix_key(const std::string& database_key, const Array<Knob>& knobs,
+                                        const Array<String>& decisions) {
+  ICHECK_EQ(knobs.size(), decisions.size());
+  std::ostringstream os;
+  os << database_key;
+  for (size_t i = 0; i < knobs.size(); ++i) {
+    os << "/" << knobs[i]->name << "=" << decisions[i];
+  }
+  return os.str();
+}
+
 /*! \brief The default database implementation, which mimics two database tables with two files.
  */
 class JSONDatabaseNode : public DatabaseNode {
@@ -124,14 +138,26 @@ class JSONDatabaseNode : public DatabaseNode {
 
   /*! \brief Measurement logs in the database */
   std::unordered_map<std::string, Array<FloatImm>> measurement_records_;
+  /*!
+   * \brief The maximum number of tuning records kept in memory for each key, -1 for unbounded.
+   * Evicted records remain in `path_tuning_record`.
+   */
+  int max_records_per_key = -1;
+  /*!
+   * \brief Output IRModules of recorded traces and of committed trace prefixes, keyed by
+   * (workload, target, decision history).
+   */
+  std::unordered_map<std::string, IRModule> trace_prefix_index_;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("path_workload", &path_workload);
     v->Visit("path_tuning_record", &path_tuning_record);
     v->Visit("path_measurement_record", &path_measurement_record);
+    v->Visit("max_records_per_key", &max_records_per_key);
     // `workloads2idx_` is not visited
     // `tuning_records_` is not visited
     // `measurement_records_` is not visited
+    // `trace_prefix_index_` is not visited
   }
 
   static constexpr const char* _type_key = "relax.tuning_api.JSONDatabase";
@@ -194,7 +220,7 @@ class JSONDatabaseNode : public DatabaseNode {
     int workload_idx = this->workloads2idx_.at(workload);
     // There may exist multiple tuning records (with different traces) for a single key pair.
     std::string key = get_database_key(workload_idx, target);
-    this->tuning_records_[key].insert(record);
+    this->AddTuningRecord(key, record);
 
     meta_schedule::JSONFileAppendLine(
         this->path_tuning_record, meta_schedule::JSONDumps(Array<ObjectRef>{
@@ -227,12 +253,68 @@ class JSONDatabaseNode : public DatabaseNode {
     int workload_idx = this->workloads2idx_.at(workload);
     return this->measurement_records_[get_database_key(workload_idx, target)];
   }
+
+  Optional<IRModule> QueryTracePrefix(const meta_schedule::Workload& workload,
+                                      const Target& target, const Array<Knob>& knobs,
+                                      const Array<String>& decisions) final {
+    auto it = this->workloads2idx_.find(workload);
+    if (it == this->workloads2idx_.end()) {
+      return NullOpt;
+    }
+    std::string key = get_trace_prefix_key(get_database_key(it->second, target), knobs, decisions);
+    auto index_it = this->trace_prefix_index_.find(key);
+    if (index_it == this->trace_prefix_index_.end()) {
+      return NullOpt;
+    }
+    return index_it->second;
+  }
+
+  void CommitTracePrefix(const meta_schedule::Workload& workload, const Target& target,
+                         const Array<Knob>& knobs, const Array<String>& decisions,
+                         const IRModule& out_mod) final {
+    std::string key = get_database_key(this->workloads2idx_.at(workload), target);
+    this->trace_prefix_index_[get_trace_prefix_key(key, knobs, decisions)] = out_mod;
+  }
+
+  /*!
+   * \brief Insert a tuning record into memory, index its trace and evict the slowest record
+   * of the key if it holds more than `max_records_per_key` records.
+   * \param key The database key of the record.
+   * \param record The tuning record to insert.
+   */
+  void AddTuningRecord(const std::string& key, const TuningRecord& record) {
+    const Trace& trace = record->trace;
+    if (trace->out_mod.defined()) {
+      this->trace_prefix_index_[get_trace_prefix_key(key, trace->knobs, trace->decisions)] =
+          trace->out_mod;
+    }
+    std::multiset<TuningRecord, SortTuningRecordByMeanRunSecs>& records =
+        this->tuning_records_[key];
+    records.insert(record);
+    if (max_records_per_key < 0 || static_cast<int>(records.size()) <= max_records_per_key) {
+      return;
+    }
+    auto worst = std::prev(records.end());
+    const Trace& evicted = (*worst)->trace;
+    auto index_it = this->trace_prefix_index_.find(
+        get_trace_prefix_key(key, evicted->knobs, evicted->decisions));
+    if (index_it != this->trace_prefix_index_.end() &&
+        index_it->second.same_as(evicted->out_mod)) {
+      this->trace_prefix_index_.erase(index_it);
+    }
+    records.erase(worst);
+  }
 };
 
 Database Database::JSONDatabase(String path_workload, String path_tuning_record,
-                                String path_measurement_record, bool allow_missing) {
+                                String path_measurement_record, bool allow_missing,
+                                int max_records_per_key) {
+  CHECK(max_records_per_key == -1 || max_records_per_key > 0)
+      << "ValueError: max_records_per_key must be -1 (unbounded) or positive, but got "
+      << max_records_per_key;
   int num_threads = std::thread::hardware_concurrency();
   ObjectPtr<JSONDatabaseNode> n = make_object<JSONDatabaseNode>();
+  n->max_records_per_key = max_records_per_key;
   // Load `n->workloads2idx_` from `path_workload`
   std::vector<meta_schedule::Workload> workloads;
   {
@@ -276,7 +358,7 @@ Database Database::JSONDatabase(String path_workload, String path_tuning_record,
 
     for (int i = 0; i < size; i++) {
       std::string key = get_database_key(workload_idxs[i], targets[i]);
-      n->tuning_records_[key].insert(records[i]);
+      n->AddTuningRecord(key, records[i]);
     }
   }
 
@@ -343,6 +425,10 @@ TVM_REGISTER_GLOBAL("relax.tuning_api.DatabaseGetTopK")
     .set_body_method<Database>(&DatabaseNode::GetTopK);
 TVM_REGISTER_GLOBAL("relax.tuning_api.DatabaseGetMeasurementRecord")
     .set_body_method<Database>(&DatabaseNode::GetMeasurementRecord);
+TVM_REGISTER_GLOBAL("relax.tuning_api.DatabaseQueryTracePrefix")
+    .set_body_method<Database>(&DatabaseNode::QueryTracePrefix);
+TVM_REGISTER_GLOBAL("relax.tuning_api.DatabaseCommitTracePrefix")
+    .set_body_method<Database>(&DatabaseNode::CommitTracePrefix);
 
 TVM_REGISTER_NODE_TYPE(JSONDatabaseNode);
 TVM_REGISTER_GLOBAL("relax.tuning_api.DatabaseJSONDatabase").set_body_typed(Database::JSONDatabase);
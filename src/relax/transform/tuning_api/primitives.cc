@@ -147,14 +147,18 @@ Trace::Trace() { data_ = make_object<TraceNode>(); }
 
 Trace::Trace(IRModule in_mod, Array<Knob> knobs, Array<String> decisions) {
   ICHECK(knobs.size() == decisions.size()) << "Size of knobs and decisions should match";
-  // Deep-copy IRModule
-  auto func_deepcopy = runtime::Registry::Get("relax.tuning_api.deepcopy_irmodule");
-  ICHECK(func_deepcopy);
-  IRModule out_mod = (*func_deepcopy)(in_mod);
-  // Apply the decision history if provided
   int size = knobs.size();
-  for (int i = 0; i < size; i++) {
-    out_mod = knobs[i]->Apply(out_mod, decisions[i]);
+  IRModule out_mod{nullptr};
+  // A trace deserialized without its input IRModule only keeps the decision history.
+  if (in_mod.defined()) {
+    // Deep-copy IRModule
+    auto func_deepcopy = runtime::Registry::Get("relax.tuning_api.deepcopy_irmodule");
+    ICHECK(func_deepcopy);
+    out_mod = (*func_deepcopy)(in_mod);
+    // Apply the decision history if provided
+    for (int i = 0; i < size; i++) {
+      out_mod = knobs[i]->Apply(out_mod, decisions[i]);
+    }
   }
 
   ObjectPtr<TraceNode> n = make_object<TraceNode>();
@@ -263,6 +267,8 @@ TVM_REGISTER_GLOBAL("relax.tuning_api.Trace")
     });
 TVM_REGISTER_GLOBAL("relax.tuning_api.TraceVerify").set_body_method<Trace>(&TraceNode::Verify);
 TVM_REGISTER_GLOBAL("relax.tuning_api.TraceAdd").set_body_method<Trace>(&TraceNode::Add);
+TVM_REGISTER_GLOBAL("relax.tuning_api.TraceAddWithOutMod")
+    .set_body_method<Trace>(&TraceNode::AddWithOutMod);
 TVM_REGISTER_GLOBAL("relax.tuning_api.TraceSetPerf").set_body_method<Trace>(&TraceNode::SetPerf);
 TVM_REGISTER_GLOBAL("relax.tuning_api.TraceSetOutMod")
     .set_body_method<Trace>(&TraceNode::SetOutMod);
@@ -19,6 +19,7 @@
 
 #include "./graph_partitioner.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace tvm {
@@ -170,6 +171,9 @@ void GraphPartitioner::MergeFromTo(Group* child, Group* parent) {
   // update the number of nodes of the parent group
   parent->num_nodes += child->num_nodes;
   child->parent = parent;
+  // append the members of the child to the parent
+  parent->last_member->next_member = child;
+  parent->last_member = child->last_member;
   // update anchor ref and pattern
   if (child->anchor_ref != nullptr) {
     ICHECK(parent->anchor_ref == nullptr);
@@ -212,6 +216,41 @@ size_t GraphPartitioner::CountNodesUptoSink_(IndexedForwardGraph::Node* src,
   return sum;
 }
 
+void GraphPartitioner::CollectGroupsUptoSink_(IndexedForwardGraph::Node* src,
+                                              IndexedForwardGraph::Node* sink,
+                                              std::unordered_set<Group*>* roots) {
+  if (src == sink || visited_.count(src)) return;
+  visited_.insert(src);
+  Group* gnode = groups_[src->index];
+  ICHECK(gnode != nullptr);
+  roots->insert(gnode->FindRoot());
+  for (auto link = src->outputs.head; link != nullptr; link = link->next) {
+    CollectGroupsUptoSink_(link->value.node, sink, roots);
+  }
+}
+
+bool GraphPartitioner::CheckFusion(IndexedForwardGraph::Node* src,
+                                   IndexedForwardGraph::Node* sink) {
+  if (fcheck_fusion_ == nullptr) return true;
+  // The same groups as CommitFuse merges: the ones on the paths from src to sink, and sink's.
+  std::unordered_set<Group*> roots{groups_[sink->index]->FindRoot()};
+  visited_.clear();
+  ICHECK(src != sink);
+  CollectGroupsUptoSink_(src, sink, &roots);
+  std::vector<IndexedForwardGraph::Node*> fused_nodes;
+  for (Group* root : roots) {
+    for (Group* member = root; member != nullptr; member = member->next_member) {
+      fused_nodes.push_back(member->gnode);
+    }
+  }
+  // Hand the nodes over in post-DFS order, as they would appear in the fused function.
+  std::sort(fused_nodes.begin(), fused_nodes.end(),
+            [](const IndexedForwardGraph::Node* lhs, const IndexedForwardGraph::Node* rhs) {
+              return lhs->index < rhs->index;
+            });
+  return fcheck_fusion_(fused_nodes, sink);
+}
+
 size_t GraphPartitioner::CountFusedNodesWithNewChild(IndexedForwardGraph::Node* child,
                                                      IndexedForwardGraph::Node* dom_parent) {
   Group* target = groups_[dom_parent->index];
@@ -227,6 +266,8 @@ void GraphPartitioner::InitGroups(const IndexedForwardGraph& graph) {
     auto* group_node = arena_->make<Group>();
     group_node->pattern = graph_node->pattern;
     group_node->root_ref = graph_node->ref;
+    group_node->gnode = graph.post_dfs_order[nid];
+    group_node->last_member = group_node;
     // set anchor ref if necessary.
     if (group_node->pattern == relay::kOutEWiseFusable) {
       group_node->anchor_ref = graph_node->ref;
@@ -267,7 +308,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
         auto fcond = [](OpPatternKind kind, bool is_sink) { return kind <= kInjective; };
         // dom_root_group can also be tuple, as in inception layers
         // CheckPath is needed to avoid fusing two intermediate tuples
-        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+        if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+            CheckFusion(graph_node, dom_node->parent->gnode)) {
           CommitFuse(graph_node, dom_node->parent->gnode);
         }
       }
@@ -290,7 +332,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
         ICHECK(dom_node->parent->gnode != nullptr);
         // The fuse can be executed if all the intermediate ops are still broadcast.
         auto fcond = [](OpPatternKind kind, bool is_sink) { return kind <= kBroadcast; };
-        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+        if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+            CheckFusion(graph_node, dom_node->parent->gnode)) {
           CommitFuse(graph_node, dom_node->parent->gnode);
         }
       }
@@ -310,7 +353,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
                     kind == kOutEWiseFusable);
           }
         };
-        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+        if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+            CheckFusion(graph_node, dom_node->parent->gnode)) {
           CommitFuse(graph_node, dom_node->parent->gnode);
         }
       }
@@ -320,7 +364,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
       if (phase != 1) continue;
       // Check if all path are injective.
       auto fcond = [](OpPatternKind kind, bool is_sink) { return kind <= kInjective; };
-      if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+      if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+          CheckFusion(graph_node, dom_node->parent->gnode)) {
         CommitFuse(graph_node, dom_node->parent->gnode);
       }
     } else {
@@ -24,6 +24,11 @@
 
 #include <tvm/relay/op_attr_types.h>
 
+#include <functional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "../../support/arena.h"
 
 namespace tvm {
@@ -154,8 +159,21 @@ class DominatorTree {
 
 class GraphPartitioner {
  public:
-  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth)
-      : arena_(arena), opt_level_(opt_level), max_fuse_depth_(max_fuse_depth) {}
+  /*!
+   * \brief The hook deciding whether a fusion allowed by the op patterns is committed.
+   * \param fused_nodes The nodes of the group that would result from the fusion.
+   * \param sink The post-dominator the nodes are fused into.
+   * \return Whether to commit the fusion.
+   */
+  using FCheckFusion = std::function<bool(
+      const std::vector<IndexedForwardGraph::Node*>& fused_nodes, IndexedForwardGraph::Node* sink)>;
+
+  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth,
+                            FCheckFusion fcheck_fusion = nullptr)
+      : arena_(arena),
+        opt_level_(opt_level),
+        max_fuse_depth_(max_fuse_depth),
+        fcheck_fusion_(std::move(fcheck_fusion)) {}
   /*!
    * \brief Group as a union find data structure.
    */
@@ -175,6 +193,12 @@ class GraphPartitioner {
      * \brief The number of nodes belonging to this group
      */
     uint32_t num_nodes{1};
+    /*! \brief The graph node this group was created for. */
+    IndexedForwardGraph::Node* gnode{nullptr};
+    /*! \brief The next group in the member list of the root, see MergeFromTo. */
+    Group* next_member{nullptr};
+    /*! \brief The last group in the member list, only valid on the root. */
+    Group* last_member{nullptr};
 
     /*!
      * \brief Find the group root, perform path compression
@@ -195,6 +219,8 @@ class GraphPartitioner {
   int opt_level_;
   /*! \brief The maximum number of operations in one fused function */
   size_t max_fuse_depth_;
+  /*! \brief The optional hook vetoing fusions, e.g. by a cost model */
+  FCheckFusion fcheck_fusion_;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
   /*! \brief internal field used for deduplication */
@@ -238,6 +264,18 @@ class GraphPartitioner {
 
   size_t CountNodesUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink);
 
+  // Internal implementation of CheckFusion
+  void CollectGroupsUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink,
+                              std::unordered_set<Group*>* roots);
+
+  /*!
+   * \brief Consult fcheck_fusion_ on the group CommitFuse(src, sink) would create.
+   * \param src The source node.
+   * \param sink The termination node.
+   * \return Whether the fusion can be committed, true if there is no hook.
+   */
+  bool CheckFusion(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink);
+
   // Count the number of nodes in a fused subgraph if child is additionally fused.
   // dom_parent is already known to be a part of the subgraph.
   // For a diamond structure, there can be multiple paths connecting child and dom_parent.
@@ -494,10 +494,41 @@ class AOTExecutorCodegen : public MixedModeVisitor {
       }));
     }
 
+    if (instrument_ops_) {
+      func_call = InstrumentFuncCall(func_name, func_call);
+    }
+
     tir::Stmt body = tir::SeqStmt({func_call});
     stmts_.push_back(body);
   }
 
+  /*!
+   * \brief Surround an operator call with the calls which let AotExecutor::Profile time it.
+   * \param func_name The name of the operator.
+   * \param func_call The call of the operator.
+   * \return The instrumented call.
+   */
+  tir::Stmt InstrumentFuncCall(const std::string& func_name, const tir::Stmt& func_call) {
+    // The workspace of main is allocated for the whole run, so it is live with the one of the
+    // operator.
+    int64_t workspace_bytes = main_workspace_bytes_;
+    if (auto info = function_metadata_.Get(func_name)) {
+      for (const auto& kv : info.value()->workspace_sizes) {
+        workspace_bytes += kv.second->value;
+      }
+    }
+    // These functions are registered in src/runtime/aot_executor/aot_executor.cc.
+    tir::Stmt start_call = tir::Evaluate(
+        tir::Call(DataType::Int(32), tir::builtin::tvm_call_packed(),
+                  {tir::StringImm("runtime.aot_executor.ProfileStartCall"),
+                   tir::StringImm(func_name)}));
+    tir::Stmt stop_call = tir::Evaluate(
+        tir::Call(DataType::Int(32), tir::builtin::tvm_call_packed(),
+                  {tir::StringImm("runtime.aot_executor.ProfileStopCall"),
+                   IntImm(DataType::Int(64), workspace_bytes)}));
+    return tir::SeqStmt({start_call, func_call, stop_call});
+  }
+
   /*!
    * \brief Copy a variable to the output. This function is mainly used in edge cases
    * when we want to return an input or a parameter.
@@ -1033,6 +1064,10 @@ class AOTExecutorCodegen : public MixedModeVisitor {
   std::unordered_map<std::string, int> io_var_names_;
   /*! \brief A set of variables that are let bound. */
   std::unordered_set<Var, ObjectPtrHash, ObjectPtrEqual> let_bound_vars_;
+  /*! \brief Whether to surround the operator calls with profiling calls. */
+  bool instrument_ops_ = false;
+  /*! \brief Size of the workspace of main, in bytes. */
+  int64_t main_workspace_bytes_ = 0;
 
  public:
   AOTExecutorCodegen(runtime::Module* mod, const Array<Target>& targets)
@@ -1048,6 +1083,9 @@ class AOTExecutorCodegen : public MixedModeVisitor {
     std::string interface_api =
         executor_config->GetAttr<String>("interface-api").value_or("packed");
     bool unpacked_api = executor_config->GetAttr<Bool>("unpacked-api").value_or(Bool(false));
+    instrument_ops_ = executor_config->GetAttr<Bool>("instrument-ops").value_or(Bool(false));
+    CHECK(!instrument_ops_ || runtime_config->name == kTvmRuntimeCpp)
+        << "instrument-ops is only supported with the c++ runtime";
 
     // Validate choice of unpacked_api and use_call_cpacked_
     if (runtime_config->name == kTvmRuntimeCrt) {
@@ -1116,6 +1154,9 @@ class AOTExecutorCodegen : public MixedModeVisitor {
     backend::FunctionInfo func_info =
         tec::UpdateMainWorkspaceSize(lowered_mod, config_, memory_plan->expr_to_storage_info);
     lowered_mod = WithAttr(lowered_mod, "main_func_info", func_info);
+    for (const auto& kv : func_info->workspace_sizes) {
+      main_workspace_bytes_ += kv.second->value;
+    }
 
     for (auto input : lowered_main_func->params) {
       input_vars_.push_back(input);
@@ -93,7 +93,8 @@ TVM_REGISTER_EXECUTOR("aot")
     .add_attr_option<Bool>("unpacked-api")
     .add_attr_option<String>("interface-api")
     .add_attr_option<Integer>("workspace-byte-alignment")
-    .add_attr_option<Integer>("constant-byte-alignment");
+    .add_attr_option<Integer>("constant-byte-alignment")
+    .add_attr_option<Bool>("instrument-ops");
 
 TVM_REGISTER_EXECUTOR("graph").add_attr_option<Bool>("link-params", Bool(false));
 
@@ -97,7 +97,7 @@ Array<meta_schedule::ExtractedTask> ExtractTask(IRModule mod, Target target,
   std::vector<int> indices(lower_results.size());
   std::iota(indices.begin(), indices.end(), 0);
 
-  if (mod_eq_name == "anchor-block") {
+  if (mod_eq_name == "anchor-block" || mod_eq_name == "anchor-block-schema") {
     std::vector<size_t> op_counts(lower_results.size());
     for (size_t i = 0; i < op_counts.size(); ++i) {
       op_counts[i] = OpCounter::GetOpCount(std::get<1>(lower_results[i]));
@@ -28,15 +28,32 @@
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/name_transforms.h>
+#include <tvm/runtime/registry.h>
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <string>
 
 #include "../meta_data.h"
 
 namespace tvm {
 namespace runtime {
 
+/*! \brief The profiling run of an AotExecutor on the calling thread. */
+struct AotProfilingRun {
+  /*! \brief The profiler, nullptr when the executor is not profiling. */
+  profiling::Profiler* profiler = nullptr;
+  Device device;
+  int64_t num_calls = 0;
+  int64_t workspace_high_water = 0;
+};
+
+static AotProfilingRun* CurrentProfilingRun() {
+  static thread_local AotProfilingRun run;
+  return &run;
+}
+
 AotExecutor::AotExecutor(tvm::runtime::Module module, const std::vector<Device>& devs)
     : module_{module}, devices_{devs} {
   auto fmetadata = module->GetFunction("get_metadata");
@@ -151,6 +168,18 @@ PackedFunc AotExecutor::GetFunction(const std::string& name,
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumInputs(); });
   } else if (name == "run") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Run(); });
+  } else if (name == "profile") {
+    return TypedPackedFunc<profiling::Report(Array<profiling::MetricCollector>)>(
+        [sptr_to_self, this](Array<profiling::MetricCollector> collectors) {
+          // We cannot send Arrays over rpc, so in order to support profiling
+          // on remotes, we accept a nullptr for collectors.
+          return this->Profile(collectors.defined() ? collectors
+                                                    : Array<profiling::MetricCollector>());
+        });
+  } else if (name == "profile_rpc") {
+    // We cannot return a Report over RPC, so it is serialized on the remote.
+    return TypedPackedFunc<std::string()>(
+        [sptr_to_self, this]() { return this->Profile({})->AsJSON(); });
   } else if (name == "get_input_index") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       CHECK(String::CanConvertFrom(args[0])) << "Input key is not a string";
@@ -181,6 +210,64 @@ void AotExecutor::Run() {
   pf.CallPacked(args, &rv);
 }
 
+profiling::Report AotExecutor::Profile(Array<profiling::MetricCollector> collectors) {
+  std::vector<profiling::MetricCollector> cs(collectors.begin(), collectors.end());
+  profiling::Profiler prof(devices_, cs, {{String("Executor"), String("AOT")}});
+
+  // warm up. 1 iteration does not seem enough.
+  for (int i = 0; i < 3; i++) {
+    Run();
+  }
+
+  AotProfilingRun* run = CurrentProfilingRun();
+  ICHECK(run->profiler == nullptr) << "Another AotExecutor is being profiled";
+  *run = AotProfilingRun();
+  run->profiler = &prof;
+  run->device = devices_[0];
+  prof.Start();
+  try {
+    Run();
+  } catch (...) {
+    run->profiler = nullptr;
+    throw;
+  }
+  prof.Stop();
+  run->profiler = nullptr;
+  CHECK_GT(run->num_calls, 0)
+      << "The model has no instrumented operator, build it with the \"instrument-ops\" option "
+      << "of the AOT executor to profile it";
+
+  profiling::Report report = prof.Report();
+  Map<String, Map<String, ObjectRef>> device_metrics;
+  for (const auto& kv : report->device_metrics) {
+    Map<String, ObjectRef> metrics = kv.second;
+    metrics.Set("Workspace High-Water (bytes)",
+                ObjectRef(make_object<profiling::CountNode>(run->workspace_high_water)));
+    device_metrics.Set(kv.first, metrics);
+  }
+  return profiling::Report(report->calls, device_metrics, report->configuration);
+}
+
+// Called by the operator calls of models built with the instrument-ops option, see
+// src/relay/backend/aot_executor_codegen.cc.
+TVM_REGISTER_GLOBAL("runtime.aot_executor.ProfileStartCall").set_body_typed([](String name) {
+  AotProfilingRun* run = CurrentProfilingRun();
+  if (run->profiler != nullptr) {
+    run->profiler->StartCall(name, run->device);
+  }
+});
+
+TVM_REGISTER_GLOBAL("runtime.aot_executor.ProfileStopCall")
+    .set_body_typed([](int64_t workspace_bytes) {
+      AotProfilingRun* run = CurrentProfilingRun();
+      if (run->profiler != nullptr) {
+        run->profiler->StopCall(
+            {{"Workspace (bytes)", ObjectRef(make_object<profiling::CountNode>(workspace_bytes))}});
+        run->num_calls++;
+        run->workspace_high_water = std::max(run->workspace_high_water, workspace_bytes);
+      }
+    });
+
 int AotExecutor::GetInputIndex(const std::string& name) {
   auto inputs = metadata_->inputs();
   for (unsigned int i = 0; i < inputs.size(); i++) {
@@ -29,6 +29,7 @@
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/profiling.h>
 
 #include <string>
 #include <vector>
@@ -53,6 +54,18 @@ class TVM_DLL AotExecutor : public ModuleNode {
 
   void Run();
 
+  /*!
+   * \brief Run the model and collect the duration and workspace size of each operator.
+   *
+   *  The model must be built with the `instrument-ops` option of the AOT executor, which
+   *  surrounds each operator call with calls to the profiler. Without it, the operator calls
+   *  cost nothing more.
+   *
+   * \param collectors Optional user defined `MetricCollector`s to use with this profiling run.
+   * \return A table of per-op runtimes and total times.
+   */
+  profiling::Report Profile(Array<profiling::MetricCollector> collectors);
+
   /*!
    * \brief Initialize the AOT executor with metadata, runtime::Module, and device.
    * \param module The module containing the compiled functions for the host
@@ -60,4 +60,7 @@
 /*! \brief Enable checks to enforce the stack allocator with a FIFO ordering. Off by default */
 // #define TVM_CRT_STACK_ALLOCATOR_ENABLE_FIFO_CHECK
 
+/*! \brief Use the TLSF allocator, which merges free blocks, instead of the page allocator. */
+// #define TVM_CRT_USE_TLSF_ALLOCATOR
+
 #endif  // TVM_RUNTIME_CRT_CRT_CONFIG_TEMPLATE_H_
@@ -984,6 +984,7 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
     TVMGraphExecutorPoolEntry pit = pool_entry[idx];
     DLDevice dev = executor->devices[0];
     uint8_t did_find_linked_param = 0;
+    executor->storage_pool[executor->storage_pool_count].is_linked_param = 0;
     if (lookup_linked_param_valid) {
       lookup_linked_param.args.values[0].v_int64 = idx;
       CHECK_EQ(lookup_linked_param.Call(&lookup_linked_param), 0, "lookup_linked_param");
@@ -0,0 +1,278 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// LINT_C_FILE
+
+/*!
+ * \file static_graph_executor.c
+ * \brief Graph executor which runs a graph table from a static arena, without allocating.
+ */
+
+#include <string.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/internal/graph_executor/graph_table.h>
+#include <tvm/runtime/crt/static_graph_executor.h>
+
+#include "crt_config.h"
+
+/*! \brief Size of the data of a tensor, in bytes. */
+static size_t TensorDataBytes(const DLTensor* tensor) {
+  size_t size = (tensor->dtype.bits * tensor->dtype.lanes + 7) / 8;
+  int idx;
+  for (idx = 0; idx < tensor->ndim; ++idx) {
+    size *= tensor->shape[idx];
+  }
+  return size;
+}
+
+/*! \brief Check a name offset points to a string of the names section. */
+static int IsValidName(const TVMGraphTableHeader* header, const char* names, uint32_t offset) {
+  return offset < header->names_bytes &&
+         memchr(names + offset, '\0', header->names_bytes - offset) != NULL;
+}
+
+/*!
+ * \brief Find the sections of a graph table and check them.
+ * \param table The graph table.
+ * \param table_size Size of the table, in bytes.
+ * \param executor The executor, which receives the sections.
+ * \return kTvmErrorNoError on success.
+ */
+static tvm_crt_error_t TVMStaticGraphExecutor_ParseTable(const void* table, size_t table_size,
+                                                         TVMStaticGraphExecutor* executor) {
+  if (((uintptr_t)table) % sizeof(uint64_t) != 0 || table_size < sizeof(TVMGraphTableHeader)) {
+    return kTvmErrorExecutorGraphTableInvalid;
+  }
+  const TVMGraphTableHeader* header = (const TVMGraphTableHeader*)table;
+  // The magic does not match on big-endian targets, which are not supported.
+  if (header->magic != kTVMGraphTableMagic || header->version != kTVMGraphTableVersion ||
+      header->alignment < sizeof(uint64_t) || header->alignment > 64 ||
+      (header->alignment & (header->alignment - 1)) != 0 ||
+      header->activation_bytes % header->alignment != 0) {
+    return kTvmErrorExecutorGraphTableInvalid;
+  }
+  uint64_t expected_size = sizeof(TVMGraphTableHeader) +
+                           (uint64_t)header->num_shape_dims * sizeof(int64_t) +
+                           (uint64_t)header->num_entries * sizeof(TVMGraphTableEntry) +
+                           (uint64_t)header->num_ops * sizeof(TVMGraphTableOp) +
+                           (uint64_t)header->num_op_args * sizeof(uint32_t) +
+                           (uint64_t)header->num_inputs * sizeof(TVMGraphTableInput) +
+                           (uint64_t)header->num_outputs * sizeof(uint32_t) + header->names_bytes;
+  if (expected_size > table_size) {
+    return kTvmErrorExecutorGraphTableInvalid;
+  }
+
+  const uint8_t* ptr = (const uint8_t*)(header + 1);
+  const int64_t* shapes = (const int64_t*)ptr;
+  ptr += header->num_shape_dims * sizeof(int64_t);
+  executor->entries = (const TVMGraphTableEntry*)ptr;
+  ptr += header->num_entries * sizeof(TVMGraphTableEntry);
+  executor->ops = (const TVMGraphTableOp*)ptr;
+  ptr += header->num_ops * sizeof(TVMGraphTableOp);
+  const uint32_t* op_args = (const uint32_t*)ptr;
+  ptr += header->num_op_args * sizeof(uint32_t);
+  executor->inputs = (const TVMGraphTableInput*)ptr;
+  ptr += header->num_inputs * sizeof(TVMGraphTableInput);
+  executor->outputs = (const uint32_t*)ptr;
+  ptr += header->num_outputs * sizeof(uint32_t);
+  executor->names = (const char*)ptr;
+  executor->header = header;
+
+  uint32_t idx;
+  for (idx = 0; idx < header->num_entries; ++idx) {
+    const TVMGraphTableEntry* entry = &executor->entries[idx];
+    if ((uint64_t)entry->shape_index + entry->ndim > header->num_shape_dims) {
+      return kTvmErrorExecutorGraphTableInvalid;
+    }
+    if (entry->offset != kTVMGraphTableExternalOffset) {
+      DLTensor tensor;
+      tensor.ndim = entry->ndim;
+      tensor.dtype.bits = (entry->dtype >> 8) & 0xff;
+      tensor.dtype.lanes = entry->dtype >> 16;
+      tensor.shape = (int64_t*)(shapes + entry->shape_index);
+      if (entry->offset % header->alignment != 0 ||
+          entry->offset + (uint64_t)TensorDataBytes(&tensor) > header->activation_bytes) {
+        return kTvmErrorExecutorGraphTableInvalid;
+      }
+    }
+  }
+  for (idx = 0; idx < header->num_ops; ++idx) {
+    const TVMGraphTableOp* op = &executor->ops[idx];
+    if ((uint64_t)op->first_arg + op->num_args > header->num_op_args ||
+        !IsValidName(header, executor->names, op->name_offset)) {
+      return kTvmErrorExecutorGraphTableInvalid;
+    }
+  }
+  for (idx = 0; idx < header->num_op_args; ++idx) {
+    if (op_args[idx] >= header->num_entries) {
+      return kTvmErrorExecutorGraphTableInvalid;
+    }
+  }
+  for (idx = 0; idx < header->num_inputs; ++idx) {
+    if (executor->inputs[idx].entry_id >= header->num_entries ||
+        !IsValidName(header, executor->names, executor->inputs[idx].name_offset)) {
+      return kTvmErrorExecutorGraphTableInvalid;
+    }
+  }
+  for (idx = 0; idx < header->num_outputs; ++idx) {
+    if (executor->outputs[idx] >= header->num_entries) {
+      return kTvmErrorExecutorGraphTableInvalid;
+    }
+  }
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TVMStaticGraphExecutor_Create(const void* table, size_t table_size,
+                                              TVMModuleHandle module_handle,
+                                              const DLDevice* devices, uint8_t* arena,
+                                              size_t arena_size,
+                                              TVMStaticGraphExecutor** executor) {
+  TVMStaticGraphExecutor parsed;
+  tvm_crt_error_t err = TVMStaticGraphExecutor_ParseTable(table, table_size, &parsed);
+  if (err != kTvmErrorNoError) {
+    return err;
+  }
+  const TVMGraphTableHeader* header = parsed.header;
+
+  // The activations come first, at the alignment of the table, then the state of the executor.
+  // Every part of the state keeps the alignment of the next one.
+  uintptr_t base = ((uintptr_t)arena + header->alignment - 1) & ~((uintptr_t)header->alignment - 1);
+  size_t state_size = sizeof(DLTensor) * header->num_entries +
+                      sizeof(TVMValue) * header->num_op_args + sizeof(TVMStaticGraphExecutor) +
+                      sizeof(TVMFunctionHandle) * header->num_ops +
+                      sizeof(int) * header->num_op_args;
+  if ((uint64_t)(base - (uintptr_t)arena) + header->activation_bytes + state_size > arena_size) {
+    return kTvmErrorExecutorArenaTooSmall;
+  }
+  uint8_t* activations = (uint8_t*)base;
+  uint8_t* ptr = activations + header->activation_bytes;
+  DLTensor* tensors = (DLTensor*)ptr;
+  ptr += sizeof(DLTensor) * header->num_entries;
+  TVMValue* arg_values = (TVMValue*)ptr;
+  ptr += sizeof(TVMValue) * header->num_op_args;
+  TVMStaticGraphExecutor* self = (TVMStaticGraphExecutor*)ptr;
+  ptr += sizeof(TVMStaticGraphExecutor);
+  *self = parsed;
+  self->module_handle = module_handle;
+  self->tensors = tensors;
+  self->arg_values = arg_values;
+  self->funcs = (TVMFunctionHandle*)ptr;
+  ptr += sizeof(TVMFunctionHandle) * header->num_ops;
+  self->arg_type_codes = (int*)ptr;
+
+  const int64_t* shapes = (const int64_t*)(header + 1);
+  uint32_t idx;
+  for (idx = 0; idx < header->num_entries; ++idx) {
+    const TVMGraphTableEntry* entry = &self->entries[idx];
+    DLTensor* tensor = &tensors[idx];
+    tensor->data =
+        entry->offset == kTVMGraphTableExternalOffset ? NULL : activations + entry->offset;
+    tensor->device = devices[0];
+    tensor->ndim = entry->ndim;
+    tensor->dtype.code = entry->dtype & 0xff;
+    tensor->dtype.bits = (entry->dtype >> 8) & 0xff;
+    tensor->dtype.lanes = entry->dtype >> 16;
+    // The shapes are never written, so they stay in the table.
+    tensor->shape = (int64_t*)(shapes + entry->shape_index);
+    tensor->strides = NULL;
+    tensor->byte_offset = 0;
+  }
+
+  const uint32_t* op_args = (const uint32_t*)(self->ops + header->num_ops);
+  for (idx = 0; idx < header->num_op_args; ++idx) {
+    arg_values[idx].v_handle = &tensors[op_args[idx]];
+    self->arg_type_codes[idx] = kTVMNDArrayHandle;
+  }
+  for (idx = 0; idx < header->num_ops; ++idx) {
+    const char* name = self->names + self->ops[idx].name_offset;
+    if (TVMModGetFunction(module_handle, name, 0, &self->funcs[idx]) != 0) {
+      return kTvmErrorFunctionNameNotFound;
+    }
+  }
+
+  *executor = self;
+  return kTvmErrorNoError;
+}
+
+int TVMStaticGraphExecutor_GetNumInputs(const TVMStaticGraphExecutor* executor) {
+  return executor->header->num_inputs;
+}
+
+int TVMStaticGraphExecutor_GetInputIndex(const TVMStaticGraphExecutor* executor,
+                                         const char* name) {
+  uint32_t idx;
+  for (idx = 0; idx < executor->header->num_inputs; ++idx) {
+    if (!strcmp(executor->names + executor->inputs[idx].name_offset, name)) {
+      return idx;
+    }
+  }
+  return -1;
+}
+
+tvm_crt_error_t TVMStaticGraphExecutor_SetInput(TVMStaticGraphExecutor* executor,
+                                                const char* name, const DLTensor* data_in) {
+  int index = TVMStaticGraphExecutor_GetInputIndex(executor, name);
+  if (index < 0) {
+    return kTvmErrorExecutorModuleNoSuchInput;
+  }
+  DLTensor* tensor = &executor->tensors[executor->inputs[index].entry_id];
+  if (TensorDataBytes(data_in) != TensorDataBytes(tensor)) {
+    return kTvmErrorFunctionCallInvalidArg;
+  }
+  tensor->data = (uint8_t*)data_in->data + data_in->byte_offset;
+  return kTvmErrorNoError;
+}
+
+int TVMStaticGraphExecutor_GetNumOutputs(const TVMStaticGraphExecutor* executor) {
+  return executor->header->num_outputs;
+}
+
+tvm_crt_error_t TVMStaticGraphExecutor_GetOutput(const TVMStaticGraphExecutor* executor,
+                                                 int32_t index, DLTensor* out) {
+  if (index < 0 || index >= executor->header->num_outputs) {
+    return kTvmErrorFunctionCallInvalidArg;
+  }
+  const DLTensor* tensor = &executor->tensors[executor->outputs[index]];
+  size_t size = TensorDataBytes(tensor);
+  if (tensor->data == NULL || TensorDataBytes(out) != size) {
+    return kTvmErrorFunctionCallInvalidArg;
+  }
+  memcpy((uint8_t*)out->data + out->byte_offset, tensor->data, size);
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TVMStaticGraphExecutor_Run(TVMStaticGraphExecutor* executor) {
+  uint32_t idx;
+  for (idx = 0; idx < executor->header->num_inputs; ++idx) {
+    if (executor->tensors[executor->inputs[idx].entry_id].data == NULL) {
+      return kTvmErrorExecutorInputNotSet;
+    }
+  }
+  for (idx = 0; idx < executor->header->num_ops; ++idx) {
+    const TVMGraphTableOp* op = &executor->ops[idx];
+    TVMValue ret_value;
+    int ret_type_code;
+    if (TVMFuncCall(executor->funcs[idx], &executor->arg_values[op->first_arg],
+                    &executor->arg_type_codes[op->first_arg], op->num_args, &ret_value,
+                    &ret_type_code) != 0) {
+      return kTvmErrorExecutorOperatorFailed;
+    }
+  }
+  return kTvmErrorNoError;
+}
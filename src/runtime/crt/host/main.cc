@@ -27,6 +27,7 @@
 #include <tvm/runtime/crt/logging.h>
 #include <tvm/runtime/crt/microtvm_rpc_server.h>
 #include <tvm/runtime/crt/page_allocator.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
 #include <unistd.h>
 
 #include <chrono>
@@ -125,8 +126,12 @@ int testonly_reset_server(TVMValue* args, int* type_codes, int num_args, TVMValu
 
 int main(int argc, char** argv) {
   g_argv = argv;
+#ifdef TVM_CRT_USE_TLSF_ALLOCATOR
+  int status = TLSFMemoryManagerCreate(&memory_manager, memory, sizeof(memory));
+#else
   int status =
       PageMemoryManagerCreate(&memory_manager, memory, sizeof(memory), 8 /* page_size_log2 */);
+#endif
   if (status != 0) {
     fprintf(stderr, "error initiailizing memory manager\n");
     return 2;
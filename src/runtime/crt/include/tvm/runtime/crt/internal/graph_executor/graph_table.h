@@ -0,0 +1,92 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/graph_table.h
+ * \brief Layout of the graph tables run by the static graph executor.
+ *
+ * The tables are produced by tvm.micro.serialize_graph_table, which documents the layout and
+ * must be kept identical. All the fields are little-endian.
+ */
+#ifndef TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_GRAPH_EXECUTOR_GRAPH_TABLE_H_
+#define TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_GRAPH_EXECUTOR_GRAPH_TABLE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief Magic number of a graph table, "GTBL". */
+#define kTVMGraphTableMagic 0x4C425447
+/*! \brief Version of the graph table layout. */
+#define kTVMGraphTableVersion 1
+/*! \brief Arena offset of the tensors bound by the application through SetInput. */
+#define kTVMGraphTableExternalOffset 0xFFFFFFFF
+
+/*! \brief The header of a graph table, followed by the sections in the order of the fields. */
+typedef struct TVMGraphTableHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t num_entries;
+  uint32_t num_ops;
+  uint32_t num_op_args;
+  uint32_t num_inputs;
+  uint32_t num_outputs;
+  uint32_t num_shape_dims;
+  uint32_t names_bytes;
+  /*! \brief Size of the activations in the arena, a multiple of alignment. */
+  uint32_t activation_bytes;
+  /*! \brief Alignment of the activations in the arena, in bytes. */
+  uint32_t alignment;
+  uint32_t reserved;
+} TVMGraphTableHeader;
+
+/*! \brief A tensor of the graph. */
+typedef struct TVMGraphTableEntry {
+  /*! \brief Offset of the data in the activations, or kTVMGraphTableExternalOffset. */
+  uint32_t offset;
+  /*! \brief DLDataType, as code | (bits << 8) | (lanes << 16). */
+  uint32_t dtype;
+  uint32_t ndim;
+  /*! \brief Index of the first dimension in the shapes section. */
+  uint32_t shape_index;
+} TVMGraphTableEntry;
+
+/*! \brief An operator, run in the order of the table. */
+typedef struct TVMGraphTableOp {
+  /*! \brief Offset of the function name in the names section. */
+  uint32_t name_offset;
+  /*! \brief Index of the first argument in the op_args section. */
+  uint32_t first_arg;
+  uint32_t num_args;
+} TVMGraphTableOp;
+
+/*! \brief An input or parameter of the graph. */
+typedef struct TVMGraphTableInput {
+  /*! \brief Offset of the name in the names section. */
+  uint32_t name_offset;
+  uint32_t entry_id;
+} TVMGraphTableInput;
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_GRAPH_EXECUTOR_GRAPH_TABLE_H_
@@ -0,0 +1,109 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file runtime/crt/include/tvm/runtime/crt/internal/memory/tlsf_allocator.h
+ * \brief Defines data types and functions used in the TLSF memory manager.
+ *     Exposed for testing.
+ */
+
+#ifndef TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_MEMORY_TLSF_ALLOCATOR_H_
+#define TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_MEMORY_TLSF_ALLOCATOR_H_
+
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#include "crt_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief Alignment of the allocated memory, in bytes. Must be a power of two. */
+#ifndef TVM_CRT_TLSF_ALIGNMENT_BYTES
+#define TVM_CRT_TLSF_ALIGNMENT_BYTES 64
+#endif
+
+/*! \brief log2 of the number of second-level lists per first-level class. */
+#define TLSF_SL_INDEX_COUNT_LOG2 4
+/*! \brief Number of second-level lists per first-level class. */
+#define TLSF_SL_INDEX_COUNT (1 << TLSF_SL_INDEX_COUNT_LOG2)
+/*! \brief Blocks smaller than (1 << TLSF_FL_INDEX_SHIFT) bytes all fall in the first class. */
+#define TLSF_FL_INDEX_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + 4)
+/*! \brief Blocks are smaller than (1 << (TLSF_FL_INDEX_MAX + 1)) bytes. */
+#define TLSF_FL_INDEX_MAX 31
+/*! \brief Number of first-level classes. */
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 2)
+
+/*!
+ * \brief The header of a block of the pool, which sits right before the memory of the block.
+ *
+ *  The blocks tile the pool, so the next block starts right after the memory of this one.
+ */
+typedef struct TLSFBlock {
+  /*! \brief The block right before this one in the pool, NULL for the first block. */
+  struct TLSFBlock* prev_phys;
+  /*! \brief The size of the memory of the block, in bytes, with kTLSFBlockFreeBit. */
+  size_t size;
+} TLSFBlock;
+
+/*! \brief The links of a free block in its free list, kept in the memory of the block. */
+typedef struct TLSFFreeLinks {
+  TLSFBlock* next;
+  TLSFBlock* prev;
+} TLSFFreeLinks;
+
+/*! \brief Marks a free block in TLSFBlock::size. */
+#define kTLSFBlockFreeBit ((size_t)1)
+
+/*!
+ * \brief TLSF memory manager.
+ *  Free blocks are kept in lists segregated by size, found through two levels of bitmaps.
+ */
+typedef struct TLSFMemoryManager {
+  // Public interface for this object.
+  MemoryManagerInterface interface;
+  // Bit i is set when a list of first-level class i is not empty.
+  uint32_t fl_bitmap;
+  // Bit j of sl_bitmap[i] is set when free_lists[i][j] is not empty.
+  uint32_t sl_bitmap[TLSF_FL_INDEX_COUNT];
+  // Free blocks, by size class.
+  TLSFBlock* free_lists[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+  // The first block of the pool.
+  TLSFBlock* first_block;
+  // The allocated block of size 0 which ends the pool.
+  TLSFBlock* sentinel;
+  // Usage statistics, except largest_free_block_bytes.
+  TLSFMemoryStats stats;
+} TLSFMemoryManager;
+
+/*!
+ * \brief Compute the size class of a block.
+ * \param size The size of the memory of the block, in bytes.
+ * \param fl Pointer which receives the first-level class.
+ * \param sl Pointer which receives the second-level class.
+ */
+void TLSF_MappingInsert(size_t size, int* fl, int* sl);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_MEMORY_TLSF_ALLOCATOR_H_
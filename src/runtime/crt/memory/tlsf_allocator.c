@@ -0,0 +1,366 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// LINT_C_FILE
+
+/*!
+ * \file tlsf_allocator.c
+ * \brief Two-Level Segregated Fit memory manager
+ *
+ * Free blocks are kept in lists by size class. The first level splits sizes by powers of two
+ * and the second level splits each power of two linearly, so a free block large enough for a
+ * request is found with two bitmap lookups. Freed blocks are merged with their free neighbors.
+ *
+ * To maximize portability, thread-safe feature has been dropped for now.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/internal/memory/tlsf_allocator.h>
+#include <tvm/runtime/crt/logging.h>
+#include <tvm/runtime/crt/platform.h>
+
+#define TLSF_ROUND_UP(qty, modulo) (((qty) + ((modulo)-1)) / (modulo) * (modulo))
+#define TLSF_ROUND_DOWN(qty, modulo) ((qty) / (modulo) * (modulo))
+
+/*! \brief Size of the header of a block. */
+#define kTLSFBlockHeaderBytes (sizeof(TLSFBlock))
+
+/*! \brief Largest block size, (1 << (TLSF_FL_INDEX_MAX + 1)) - 1 without overflowing size_t. */
+#define kTLSFMaxBlockBytes \
+  ((((size_t)1 << TLSF_FL_INDEX_MAX) - 1) + ((size_t)1 << TLSF_FL_INDEX_MAX))
+
+/*! \brief Smallest block size, which holds the free list links. */
+#define kTLSFMinBlockBytes                                                  \
+  (TLSF_ROUND_UP(sizeof(TLSFFreeLinks) + kTLSFBlockHeaderBytes,             \
+                 (size_t)TVM_CRT_TLSF_ALIGNMENT_BYTES) -                    \
+   kTLSFBlockHeaderBytes)
+
+static int TLSF_FindLastSet(size_t x) {
+  if (x == 0) {
+    return -1;
+  }
+#if defined(__GNUC__)
+  return (int)(sizeof(unsigned long long) * 8) - 1 -  // NOLINT(runtime/int)
+         __builtin_clzll((unsigned long long)x);      // NOLINT(runtime/int)
+#else
+  int bit = -1;
+  while (x != 0) {
+    x >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+static int TLSF_FindFirstSet(uint32_t x) {
+#if defined(__GNUC__)
+  return __builtin_ffs((int)x) - 1;
+#else
+  int bit;
+  for (bit = 0; bit < 32; bit++) {
+    if (x & (1U << bit)) {
+      return bit;
+    }
+  }
+  return -1;
+#endif
+}
+
+static size_t TLSF_BlockSize(const TLSFBlock* block) { return block->size & ~kTLSFBlockFreeBit; }
+
+static bool TLSF_BlockIsFree(const TLSFBlock* block) {
+  return (block->size & kTLSFBlockFreeBit) != 0;
+}
+
+static uint8_t* TLSF_BlockData(TLSFBlock* block) {
+  return (uint8_t*)block + kTLSFBlockHeaderBytes;  // NOLINT(*)
+}
+
+static TLSFBlock* TLSF_BlockFromData(void* ptr) {
+  return (TLSFBlock*)((uint8_t*)ptr - kTLSFBlockHeaderBytes);  // NOLINT(*)
+}
+
+static TLSFBlock* TLSF_BlockNext(TLSFBlock* block) {
+  return (TLSFBlock*)(TLSF_BlockData(block) + TLSF_BlockSize(block));  // NOLINT(*)
+}
+
+static TLSFFreeLinks* TLSF_BlockLinks(TLSFBlock* block) {
+  return (TLSFFreeLinks*)TLSF_BlockData(block);  // NOLINT(*)
+}
+
+void TLSF_MappingInsert(size_t size, int* fl, int* sl) {
+  if (size < ((size_t)1 << TLSF_FL_INDEX_SHIFT)) {
+    *fl = 0;
+    *sl = (int)(size / (((size_t)1 << TLSF_FL_INDEX_SHIFT) / TLSF_SL_INDEX_COUNT));
+  } else {
+    int last_set = TLSF_FindLastSet(size);
+    *sl = (int)(size >> (last_set - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+    *fl = last_set - (TLSF_FL_INDEX_SHIFT - 1);
+  }
+}
+
+static void TLSF_InsertFreeBlock(TLSFMemoryManager* mgr, TLSFBlock* block) {
+  int fl, sl;
+  size_t size = TLSF_BlockSize(block);
+  TLSF_MappingInsert(size, &fl, &sl);
+  TLSFBlock* head = mgr->free_lists[fl][sl];
+  TLSFFreeLinks* links = TLSF_BlockLinks(block);
+  links->prev = NULL;
+  links->next = head;
+  if (head != NULL) {
+    TLSF_BlockLinks(head)->prev = block;
+  }
+  mgr->free_lists[fl][sl] = block;
+  mgr->fl_bitmap |= 1U << fl;
+  mgr->sl_bitmap[fl] |= 1U << sl;
+  block->size |= kTLSFBlockFreeBit;
+  mgr->stats.free_bytes += size;
+  mgr->stats.num_free_blocks++;
+}
+
+static void TLSF_RemoveFreeBlock(TLSFMemoryManager* mgr, TLSFBlock* block) {
+  int fl, sl;
+  size_t size = TLSF_BlockSize(block);
+  TLSF_MappingInsert(size, &fl, &sl);
+  TLSFFreeLinks* links = TLSF_BlockLinks(block);
+  if (links->prev != NULL) {
+    TLSF_BlockLinks(links->prev)->next = links->next;
+  } else {
+    mgr->free_lists[fl][sl] = links->next;
+    if (links->next == NULL) {
+      mgr->sl_bitmap[fl] &= ~(1U << sl);
+      if (mgr->sl_bitmap[fl] == 0) {
+        mgr->fl_bitmap &= ~(1U << fl);
+      }
+    }
+  }
+  if (links->next != NULL) {
+    TLSF_BlockLinks(links->next)->prev = links->prev;
+  }
+  block->size &= ~kTLSFBlockFreeBit;
+  mgr->stats.free_bytes -= size;
+  mgr->stats.num_free_blocks--;
+}
+
+/*!
+ * \brief Find a free block of at least the given size.
+ *  The size is rounded up to the next size class, so any block of the class found fits. Below
+ *  (1 << TLSF_FL_INDEX_SHIFT), the classes are linear and (1 << TLSF_FL_INDEX_SHIFT) /
+ *  TLSF_SL_INDEX_COUNT bytes wide, above they are a fraction of the power of two. When there is
+ *  no block in the larger classes, the blocks of the class of the size itself are searched, so
+ *  that e.g. the whole pool can be allocated at once.
+ */
+static TLSFBlock* TLSF_FindFreeBlock(TLSFMemoryManager* mgr, size_t size) {
+  size_t round;
+  if (size < ((size_t)1 << TLSF_FL_INDEX_SHIFT)) {
+    round = ((size_t)1 << TLSF_FL_INDEX_SHIFT) / TLSF_SL_INDEX_COUNT - 1;
+  } else {
+    round = ((size_t)1 << (TLSF_FindLastSet(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+  }
+  size_t search_size = size > kTLSFMaxBlockBytes - round ? kTLSFMaxBlockBytes : size + round;
+  int fl, sl;
+  TLSF_MappingInsert(search_size, &fl, &sl);
+  uint32_t sl_map = fl < TLSF_FL_INDEX_COUNT ? mgr->sl_bitmap[fl] & (~0U << sl) : 0;
+  if (sl_map == 0) {
+    uint32_t fl_map = fl + 1 < TLSF_FL_INDEX_COUNT ? mgr->fl_bitmap & (~0U << (fl + 1)) : 0;
+    if (fl_map != 0) {
+      fl = TLSF_FindFirstSet(fl_map);
+      sl_map = mgr->sl_bitmap[fl];
+    }
+  }
+  if (sl_map != 0) {
+    sl = TLSF_FindFirstSet(sl_map);
+    return mgr->free_lists[fl][sl];
+  }
+
+  TLSF_MappingInsert(size, &fl, &sl);
+  TLSFBlock* block;
+  for (block = mgr->free_lists[fl][sl]; block != NULL; block = TLSF_BlockLinks(block)->next) {
+    if (TLSF_BlockSize(block) >= size) {
+      return block;
+    }
+  }
+  return NULL;
+}
+
+/*!
+ * \brief Allocate memory from manager
+ * \param size The size of memory
+ * \return The virtual address
+ */
+tvm_crt_error_t TLSFMemoryManager_Allocate(MemoryManagerInterface* interface, size_t num_bytes,
+                                           DLDevice dev, void** out_ptr) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+
+  *out_ptr = 0;
+  if (num_bytes > kTLSFMaxBlockBytes - TVM_CRT_TLSF_ALIGNMENT_BYTES) {
+    return kTvmErrorPlatformNoMemory;
+  }
+  // Keep the memory of the next block aligned.
+  size_t size = TLSF_ROUND_UP(num_bytes + kTLSFBlockHeaderBytes,
+                              (size_t)TVM_CRT_TLSF_ALIGNMENT_BYTES) -
+                kTLSFBlockHeaderBytes;
+  if (size < kTLSFMinBlockBytes) {
+    size = kTLSFMinBlockBytes;
+  }
+
+  TLSFBlock* block = TLSF_FindFreeBlock(mgr, size);
+  if (block == NULL) {
+#if TVM_CRT_DEBUG > 1
+    TVMLogf("insufficient memory, size=%zu, free=%zu", num_bytes, mgr->stats.free_bytes);
+#endif
+    return kTvmErrorPlatformNoMemory;
+  }
+  TLSF_RemoveFreeBlock(mgr, block);
+
+  // Return the rest of the block to the free lists when it can hold a block.
+  if (TLSF_BlockSize(block) >= size + kTLSFBlockHeaderBytes + kTLSFMinBlockBytes) {
+    TLSFBlock* rest = (TLSFBlock*)(TLSF_BlockData(block) + size);  // NOLINT(*)
+    rest->prev_phys = block;
+    rest->size = TLSF_BlockSize(block) - size - kTLSFBlockHeaderBytes;
+    TLSF_BlockNext(rest)->prev_phys = rest;
+    block->size = size;
+    TLSF_InsertFreeBlock(mgr, rest);
+  }
+
+  mgr->stats.used_bytes += TLSF_BlockSize(block);
+  mgr->stats.num_used_blocks++;
+  if (mgr->stats.used_bytes > mgr->stats.peak_used_bytes) {
+    mgr->stats.peak_used_bytes = mgr->stats.used_bytes;
+  }
+  mgr->interface.vleak_size++;
+  *out_ptr = TLSF_BlockData(block);
+#if TVM_CRT_DEBUG > 1
+  TVMLogf("allocate: addr=%p, size=%zu, vleak=%d\n", *out_ptr, TLSF_BlockSize(block),
+          mgr->interface.vleak_size);
+#endif  // TVM_CRT_DEBUG
+  return kTvmErrorNoError;
+}
+
+/*!
+ * \brief Free the memory.
+ * \param interface Pointer to this structure.
+ * \param ptr A pointer returned from TVMPlatformMemoryAllocate which should be free'd.
+ * \param dev Execution device passed to TVMPlatformMemoryAllocate. Fixed to {kDLCPU, 0}.
+ * \return kTvmErrorNoError if successful; a descriptive error code otherwise.
+ */
+tvm_crt_error_t TLSFMemoryManager_Free(MemoryManagerInterface* interface, void* ptr, DLDevice dev) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+
+  uint8_t* data = (uint8_t*)ptr;  // NOLINT(*)
+  if (data < TLSF_BlockData(mgr->first_block) || data >= TLSF_BlockData(mgr->sentinel) ||
+      ((uintptr_t)data) % TVM_CRT_TLSF_ALIGNMENT_BYTES != 0) {
+    return kTvmErrorPlatformMemoryBadFree;
+  }
+  TLSFBlock* block = TLSF_BlockFromData(ptr);
+  if (TLSF_BlockIsFree(block) || TLSF_BlockNext(block)->prev_phys != block) {
+    return kTvmErrorPlatformMemoryBadFree;
+  }
+  mgr->stats.used_bytes -= TLSF_BlockSize(block);
+  mgr->stats.num_used_blocks--;
+
+  // Merge with the free neighbors.
+  TLSFBlock* prev = block->prev_phys;
+  if (prev != NULL && TLSF_BlockIsFree(prev)) {
+    TLSF_RemoveFreeBlock(mgr, prev);
+    prev->size += kTLSFBlockHeaderBytes + TLSF_BlockSize(block);
+    block = prev;
+    TLSF_BlockNext(block)->prev_phys = block;
+  }
+  TLSFBlock* next = TLSF_BlockNext(block);
+  if (TLSF_BlockIsFree(next)) {
+    TLSF_RemoveFreeBlock(mgr, next);
+    block->size += kTLSFBlockHeaderBytes + TLSF_BlockSize(next);
+    TLSF_BlockNext(block)->prev_phys = block;
+  }
+  TLSF_InsertFreeBlock(mgr, block);
+
+  mgr->interface.vleak_size--;
+#if TVM_CRT_DEBUG > 1
+  TVMLogf("release: addr=%p, vleak=%d", ptr, mgr->interface.vleak_size);
+#endif  // TVM_CRT_DEBUG
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManagerCreate(MemoryManagerInterface** interface, uint8_t* memory_pool,
+                                        size_t memory_pool_size_bytes) {
+  uintptr_t pool_begin = (uintptr_t)memory_pool;
+  uintptr_t pool_end = pool_begin + memory_pool_size_bytes;
+
+  // The manager is at the beginning of the pool, followed by the blocks.
+  uintptr_t manager_begin = TLSF_ROUND_UP(pool_begin, sizeof(void*));
+  uintptr_t first_data =
+      TLSF_ROUND_UP(manager_begin + sizeof(TLSFMemoryManager) + kTLSFBlockHeaderBytes,
+                    (uintptr_t)TVM_CRT_TLSF_ALIGNMENT_BYTES);
+  uintptr_t sentinel_data = TLSF_ROUND_DOWN(pool_end, (uintptr_t)TVM_CRT_TLSF_ALIGNMENT_BYTES);
+  if (sentinel_data < first_data + kTLSFBlockHeaderBytes + kTLSFMinBlockBytes) {
+    return kTvmErrorPlatformNoMemory;
+  }
+  size_t first_size = sentinel_data - first_data - kTLSFBlockHeaderBytes;
+  if (first_size > kTLSFMaxBlockBytes) {
+    first_size = TLSF_ROUND_DOWN(kTLSFMaxBlockBytes + kTLSFBlockHeaderBytes,
+                                 (size_t)TVM_CRT_TLSF_ALIGNMENT_BYTES) -
+                 kTLSFBlockHeaderBytes;
+  }
+
+  TLSFMemoryManager* manager = (TLSFMemoryManager*)manager_begin;
+  memset(manager, 0, sizeof(TLSFMemoryManager));
+  *interface = &manager->interface;
+  /* handle MemoryManager member functions */
+  manager->interface.Allocate = TLSFMemoryManager_Allocate;
+  manager->interface.Free = TLSFMemoryManager_Free;
+
+  /* handle the pool, a single free block followed by the sentinel */
+  TLSFBlock* first_block = TLSF_BlockFromData((void*)first_data);
+  first_block->prev_phys = NULL;
+  first_block->size = first_size;
+  TLSFBlock* sentinel = TLSF_BlockNext(first_block);
+  sentinel->prev_phys = first_block;
+  sentinel->size = 0;
+  manager->first_block = first_block;
+  manager->sentinel = sentinel;
+  TLSF_InsertFreeBlock(manager, first_block);
+
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManagerGetStats(MemoryManagerInterface* interface,
+                                          TLSFMemoryStats* stats) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+
+  *stats = mgr->stats;
+  stats->largest_free_block_bytes = 0;
+  if (mgr->fl_bitmap != 0) {
+    // The largest free block is in the last non-empty list.
+    int fl = TLSF_FindLastSet(mgr->fl_bitmap);
+    int sl = TLSF_FindLastSet(mgr->sl_bitmap[fl]);
+    TLSFBlock* block;
+    for (block = mgr->free_lists[fl][sl]; block != NULL; block = TLSF_BlockLinks(block)->next) {
+      if (TLSF_BlockSize(block) > stats->largest_free_block_bytes) {
+        stats->largest_free_block_bytes = TLSF_BlockSize(block);
+      }
+    }
+  }
+  return kTvmErrorNoError;
+}
@@ -24,11 +24,23 @@
 
 #include <dmlc/json.h>
 #include <dmlc/memory_io.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -185,10 +197,181 @@ Map<String, NDArray> LoadParams(const std::string& param_blob) {
   dmlc::MemoryStringStream strm(const_cast<std::string*>(&param_blob));
   return LoadParams(&strm);
 }
+/*! \brief The size of the magic, the reserved word and the index size of the aligned format. */
+static constexpr uint64_t kAlignedParamsHeaderBytes = 3 * sizeof(uint64_t);
+
+static uint64_t AlignParamOffset(uint64_t offset) {
+  return (offset + kTVMAlignedParamsAlignment - 1) / kTVMAlignedParamsAlignment *
+         kTVMAlignedParamsAlignment;
+}
+
+/*! \brief Convert the little-endian data of an array from or to the host byte order. */
+static void SwapParamBytes(void* data, DLDataType dtype, size_t nbytes) {
+  if (!DMLC_IO_NO_ENDIAN_SWAP) {
+    size_t type_bytes = (dtype.bits + 7) / 8;
+    dmlc::ByteSwap(data, type_bytes, nbytes / type_bytes);
+  }
+}
+
+static uint64_t ChecksumMix(uint64_t h, uint64_t word) {
+  h ^= word * 0x9E3779B97F4A7C15ULL;
+  h = (h << 31) | (h >> 33);
+  return h * 0xBF58476D1CE4E5B9ULL;
+}
+
+static uint64_t ChecksumFinalize(uint64_t h) {
+  h ^= h >> 30;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 27;
+  h *= 0x94D049BB133111EBULL;
+  return h ^ (h >> 31);
+}
+
+static uint64_t ChecksumLoadWord(const unsigned char* p, size_t nbytes) {
+  uint64_t word = 0;
+  std::memcpy(&word, p, nbytes);
+  if (!DMLC_IO_NO_ENDIAN_SWAP) {
+    dmlc::ByteSwap(&word, sizeof(word), 1);
+  }
+  return word;
+}
+
+uint64_t ParamChecksumBlock(const void* data, size_t nbytes) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  // Four independent lanes, so that the multiplications of consecutive words overlap.
+  uint64_t h[4] = {0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL, 0xA4093822299F31D0ULL,
+                   0x082EFA98EC4E6C89ULL};
+  size_t i = 0;
+  for (; i + 4 * sizeof(uint64_t) <= nbytes; i += 4 * sizeof(uint64_t)) {
+    for (int k = 0; k < 4; ++k) {
+      h[k] = ChecksumMix(h[k], ChecksumLoadWord(p + i + k * sizeof(uint64_t), sizeof(uint64_t)));
+    }
+  }
+  for (; i < nbytes; i += sizeof(uint64_t)) {
+    h[0] = ChecksumMix(h[0], ChecksumLoadWord(p + i, std::min(sizeof(uint64_t), nbytes - i)));
+  }
+  uint64_t ret = ChecksumMix(h[0], nbytes);
+  for (int k = 1; k < 4; ++k) {
+    ret = ChecksumMix(ret, h[k]);
+  }
+  return ChecksumFinalize(ret);
+}
+
+uint64_t ParamChecksumCombine(const std::vector<uint64_t>& block_hashes) {
+  uint64_t h = 0x452821E638D01377ULL;
+  for (uint64_t block_hash : block_hashes) {
+    h = ChecksumMix(h, block_hash);
+  }
+  return ChecksumFinalize(ChecksumMix(h, block_hashes.size()));
+}
+
+uint64_t ParamChecksum(const void* data, size_t nbytes) {
+  const char* p = static_cast<const char*>(data);
+  std::vector<uint64_t> block_hashes;
+  for (size_t begin = 0; begin < nbytes; begin += kTVMParamChecksumBlockBytes) {
+    block_hashes.push_back(
+        ParamChecksumBlock(p + begin, std::min(kTVMParamChecksumBlockBytes, nbytes - begin)));
+  }
+  return ParamChecksumCombine(block_hashes);
+}
+
+static std::string SaveAlignedIndex(const std::vector<AlignedParamEntry>& entries) {
+  std::string bytes;
+  dmlc::MemoryStringStream strm(&bytes);
+  uint64_t sz = static_cast<uint64_t>(entries.size());
+  strm.Write(sz);
+  for (const auto& e : entries) {
+    strm.Write(e.name);
+    strm.Write(e.dtype);
+    strm.Write(e.shape);
+    strm.Write(e.offset);
+    strm.Write(e.nbytes);
+    strm.Write(e.checksum);
+  }
+  return bytes;
+}
+
+static std::vector<AlignedParamEntry> ParseAlignedIndex(std::string* bytes, uint64_t reserved) {
+  dmlc::MemoryStringStream strm(bytes);
+  uint64_t sz;
+  ICHECK(strm.Read(&sz)) << "Invalid parameters file format";
+  std::vector<AlignedParamEntry> entries(static_cast<size_t>(sz));
+  for (auto& e : entries) {
+    ICHECK(strm.Read(&e.name) && strm.Read(&e.dtype) && strm.Read(&e.shape) &&
+           strm.Read(&e.offset) && strm.Read(&e.nbytes))
+        << "Invalid parameters file format";
+    e.checksum = 0;
+    if (reserved & kTVMAlignedParamsChecksumFlag) {
+      ICHECK(strm.Read(&e.checksum)) << "Invalid parameters file format";
+    }
+  }
+  return entries;
+}
+
+/*!
+ * \brief Load the index of the aligned format from a stream positioned after the reserved word.
+ * \param strm The stream.
+ * \param reserved The reserved word.
+ * \param index_end Set to the offset of the end of the index from the beginning of the file.
+ * \return The index entries.
+ */
+static std::vector<AlignedParamEntry> LoadAlignedIndex(dmlc::Stream* strm, uint64_t reserved,
+                                                       uint64_t* index_end) {
+  uint64_t index_size;
+  ICHECK(strm->Read(&index_size)) << "Invalid parameters file format";
+  std::string bytes(static_cast<size_t>(index_size), '\0');
+  ICHECK_EQ(strm->Read(&bytes[0], bytes.size()), bytes.size()) << "Invalid parameters file format";
+  *index_end = kAlignedParamsHeaderBytes + index_size;
+  return ParseAlignedIndex(&bytes, reserved);
+}
+
+std::vector<AlignedParamEntry> LoadAlignedParamIndex(const char* data, size_t size,
+                                                     bool* has_checksum) {
+  dmlc::MemoryFixedSizeStream strm(const_cast<char*>(data), size);
+  uint64_t header, reserved, index_end;
+  ICHECK(strm.Read(&header) && header == kTVMAlignedNDArrayListMagic)
+      << "Invalid parameters file format";
+  ICHECK(strm.Read(&reserved)) << "Invalid parameters file format";
+  std::vector<AlignedParamEntry> entries = LoadAlignedIndex(&strm, reserved, &index_end);
+  for (const auto& e : entries) {
+    ICHECK(e.offset % kTVMAlignedParamsAlignment == 0 && e.offset >= index_end &&
+           e.offset <= size && e.nbytes <= size - e.offset)
+        << "Invalid parameters file format";
+  }
+  *has_checksum = (reserved & kTVMAlignedParamsChecksumFlag) != 0;
+  return entries;
+}
+
+/*! \brief Load the aligned format from a stream positioned after the reserved word. */
+static Map<String, NDArray> LoadAlignedParams(dmlc::Stream* strm, uint64_t reserved) {
+  uint64_t pos;
+  std::vector<AlignedParamEntry> entries = LoadAlignedIndex(strm, reserved, &pos);
+  Map<String, NDArray> params;
+  char padding[kTVMAlignedParamsAlignment];
+  for (const auto& e : entries) {
+    ICHECK(e.offset >= pos && e.offset - pos < kTVMAlignedParamsAlignment)
+        << "Invalid parameters file format";
+    size_t padding_bytes = static_cast<size_t>(e.offset - pos);
+    ICHECK_EQ(strm->Read(padding, padding_bytes), padding_bytes)
+        << "Invalid parameters file format";
+    NDArray temp = NDArray::Empty(e.shape, e.dtype, Device{kDLCPU, 0});
+    ICHECK_EQ(GetDataSize(*temp.operator->()), e.nbytes) << "Invalid parameters file format";
+    ICHECK_EQ(strm->Read(temp->data, e.nbytes), e.nbytes) << "Invalid parameters file format";
+    SwapParamBytes(temp->data, e.dtype, e.nbytes);
+    params.Set(e.name, temp);
+    pos = e.offset + e.nbytes;
+  }
+  return params;
+}
+
 Map<String, NDArray> LoadParams(dmlc::Stream* strm) {
   Map<String, NDArray> params;
   uint64_t header, reserved;
   ICHECK(strm->Read(&header)) << "Invalid parameters file format";
+  if (header == kTVMAlignedNDArrayListMagic) {
+    ICHECK(strm->Read(&reserved)) << "Invalid parameters file format";
+    return LoadAlignedParams(strm, reserved);
+  }
   ICHECK(header == kTVMNDArrayListMagic) << "Invalid parameters file format";
   ICHECK(strm->Read(&reserved)) << "Invalid parameters file format";
 
@@ -236,6 +419,222 @@ std::string SaveParams(const Map<String, NDArray>& params) {
   return bytes;
 }
 
+/*! \brief Whether the data of an array is saved in the aligned format as is. */
+static bool IsParamDataSavedAsIs(const DLTensor* tensor) {
+  return DMLC_IO_NO_ENDIAN_SWAP && tensor->device.device_type == kDLCPU &&
+         tensor->strides == nullptr && tensor->byte_offset == 0;
+}
+
+/*! \brief Get the data of an array as saved in the aligned format. */
+static std::vector<uint8_t> GetParamBytes(const DLTensor* tensor) {
+  std::vector<uint8_t> bytes(GetDataSize(*tensor));
+  ICHECK_EQ(
+      TVMArrayCopyToBytes(const_cast<DLTensor*>(tensor), dmlc::BeginPtr(bytes), bytes.size()), 0)
+      << TVMGetLastError();
+  SwapParamBytes(dmlc::BeginPtr(bytes), tensor->dtype, bytes.size());
+  return bytes;
+}
+
+void SaveParamsAligned(dmlc::Stream* strm, const Map<String, NDArray>& params) {
+  std::vector<AlignedParamEntry> entries;
+  std::vector<const DLTensor*> arrays;
+  // The checksums go in the index before the data, so the arrays not saved as is are copied to
+  // the host once for the checksum and again for the write, holding one copy at a time.
+  for (auto& p : params) {
+    const DLTensor* tensor = p.second.operator->();
+    std::vector<int64_t> shape(tensor->shape, tensor->shape + tensor->ndim);
+    uint64_t nbytes = GetDataSize(*tensor);
+    uint64_t checksum;
+    if (IsParamDataSavedAsIs(tensor)) {
+      checksum = ParamChecksum(tensor->data, nbytes);
+    } else {
+      std::vector<uint8_t> bytes = GetParamBytes(tensor);
+      checksum = ParamChecksum(dmlc::BeginPtr(bytes), nbytes);
+    }
+    entries.push_back({p.first, tensor->dtype, shape, 0, nbytes, checksum});
+    arrays.push_back(tensor);
+  }
+  // The offsets are fixed-size fields, so the size of the index does not depend on them.
+  uint64_t offset = kAlignedParamsHeaderBytes + SaveAlignedIndex(entries).size();
+  for (auto& e : entries) {
+    e.offset = AlignParamOffset(offset);
+    offset = e.offset + e.nbytes;
+  }
+  std::string index = SaveAlignedIndex(entries);
+
+  uint64_t header = kTVMAlignedNDArrayListMagic, reserved = kTVMAlignedParamsChecksumFlag;
+  uint64_t index_size = static_cast<uint64_t>(index.size());
+  strm->Write(header);
+  strm->Write(reserved);
+  strm->Write(index_size);
+  strm->Write(index.data(), index.size());
+  uint64_t pos = kAlignedParamsHeaderBytes + index_size;
+  const char padding[kTVMAlignedParamsAlignment] = {0};
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const AlignedParamEntry& e = entries[i];
+    const DLTensor* tensor = arrays[i];
+    strm->Write(padding, static_cast<size_t>(e.offset - pos));
+    if (IsParamDataSavedAsIs(tensor)) {
+      // quick path
+      strm->Write(tensor->data, e.nbytes);
+    } else {
+      std::vector<uint8_t> bytes = GetParamBytes(tensor);
+      strm->Write(dmlc::BeginPtr(bytes), bytes.size());
+    }
+    pos = e.offset + e.nbytes;
+  }
+}
+
+/*! \brief A write-only dmlc::Stream of a file. */
+class FileWriteStream : public dmlc::Stream {
+ public:
+  explicit FileWriteStream(const std::string& file_name)
+      : fs_(file_name, std::ios::out | std::ios::binary) {
+    ICHECK(!fs_.fail()) << "Cannot open " << file_name;
+  }
+  size_t Read(void* ptr, size_t size) final {
+    LOG(FATAL) << "FileWriteStream is write-only";
+    return 0;
+  }
+  void Write(const void* ptr, size_t size) final {
+    fs_.write(static_cast<const char*>(ptr), size);
+    ICHECK(!fs_.fail()) << "Failed to write the file";
+  }
+
+ private:
+  std::ofstream fs_;
+};
+
+void SaveParamsToFile(const std::string& file_name, const Map<String, NDArray>& params) {
+  FileWriteStream strm(file_name);
+  SaveParamsAligned(&strm, params);
+}
+
+MappedFile::MappedFile(const std::string& file_name) {
+#if !defined(_WIN32)
+  int fd = open(file_name.c_str(), O_RDONLY);
+  ICHECK_GE(fd, 0) << "Cannot open " << file_name;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    size_ = static_cast<size_t>(st.st_size);
+    void* data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) data_ = static_cast<char*>(data);
+  }
+  close(fd);
+  ICHECK(data_ != nullptr) << "Cannot map " << file_name;
+#else
+  LoadBinaryFromFile(file_name, &buffer_);
+  data_ = &buffer_[0];
+  size_ = buffer_.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if !defined(_WIN32)
+  munmap(data_, size_);
+#endif
+}
+
+void MappedFile::Prefetch(size_t offset, size_t nbytes) const {
+#if !defined(_WIN32)
+  // madvise needs a page-aligned address.
+  size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t begin = offset / page_size * page_size;
+  size_t end = std::min(size_, offset + nbytes);
+  if (end > begin) {
+    madvise(data_ + begin, end - begin, MADV_WILLNEED);
+  }
+#endif
+}
+
+/*! \brief Delete NDArray::Container viewing a MappedFile. */
+static void MappedNDArrayDeleter(Object* container) {
+  NDArray::Container* ptr = static_cast<NDArray::Container*>(container);
+  delete static_cast<std::shared_ptr<MappedFile>*>(ptr->manager_ctx);
+  delete ptr;
+}
+
+Map<String, NDArray> LoadParamsFromFile(const std::string& file_name) {
+  auto file = std::make_shared<MappedFile>(file_name);
+  uint64_t header = 0;
+  if (file->size() >= sizeof(header)) {
+    std::memcpy(&header, file->data(), sizeof(header));
+  }
+  // The magic only matches on little-endian hosts, which use the data as is.
+  if (header != kTVMAlignedNDArrayListMagic ||
+      reinterpret_cast<uintptr_t>(file->data()) % kTVMAlignedParamsAlignment != 0) {
+    // Deserialize from the mapping, which saves a copy of the file in memory.
+    dmlc::MemoryFixedSizeStream strm(file->data(), file->size());
+    return LoadParams(&strm);
+  }
+  bool has_checksum;
+  std::vector<AlignedParamEntry> entries =
+      LoadAlignedParamIndex(file->data(), file->size(), &has_checksum);
+  Map<String, NDArray> params;
+  for (const auto& e : entries) {
+    NDArray::Container* container =
+        new NDArray::Container(file->data() + e.offset, e.shape, e.dtype, Device{kDLCPU, 0});
+    container->SetDeleter(MappedNDArrayDeleter);
+    container->manager_ctx = new std::shared_ptr<MappedFile>(file);
+    NDArray array(GetObjectPtr<Object>(container));
+    ICHECK_EQ(GetDataSize(container->dl_tensor), e.nbytes) << "Invalid parameters file format";
+    params.Set(e.name, array);
+  }
+  return params;
+}
+
+void LoadParamsFromFile(const std::string& file_name,
+                        const std::function<NDArray(const std::string&)>& fdest,
+                        size_t chunk_bytes) {
+  ICHECK_GT(chunk_bytes, 0U);
+  std::ifstream fs(file_name, std::ios::in | std::ios::binary);
+  ICHECK(!fs.fail()) << "Cannot open " << file_name;
+  uint64_t header[3] = {0, 0, 0};
+  fs.read(reinterpret_cast<char*>(header), sizeof(header));
+  // The magic only matches on little-endian hosts, which read the data as is.
+  if (!fs || header[0] != kTVMAlignedNDArrayListMagic) {
+    fs.close();
+    for (const auto& p : LoadParamsFromFile(file_name)) {
+      NDArray dst = fdest(p.first);
+      if (dst.defined()) dst.CopyFrom(p.second);
+    }
+    return;
+  }
+  std::string index(static_cast<size_t>(header[2]), '\0');
+  fs.read(&index[0], index.size());
+  ICHECK(fs) << "Invalid parameters file format";
+  std::vector<AlignedParamEntry> entries = ParseAlignedIndex(&index, header[1]);
+
+  std::vector<char> buffer;
+  for (const auto& e : entries) {
+    NDArray dst = fdest(e.name);
+    if (!dst.defined()) continue;
+    const DLTensor* to = dst.operator->();
+    ICHECK_EQ(GetDataSize(*to), e.nbytes) << "Size mismatch of parameter " << e.name;
+    ICHECK(IsContiguous(*to)) << "Parameter " << e.name << " is not contiguous";
+    fs.seekg(static_cast<std::streamoff>(e.offset));
+    if (to->device.device_type == kDLCPU) {
+      fs.read(static_cast<char*>(to->data) + to->byte_offset, e.nbytes);
+      ICHECK(fs) << "Invalid parameters file format";
+      continue;
+    }
+    buffer.resize(static_cast<size_t>(std::min<uint64_t>(chunk_bytes, e.nbytes)));
+    for (uint64_t begin = 0; begin < e.nbytes; begin += buffer.size()) {
+      int64_t nbytes = static_cast<int64_t>(std::min<uint64_t>(buffer.size(), e.nbytes - begin));
+      fs.read(buffer.data(), nbytes);
+      ICHECK(fs) << "Invalid parameters file format";
+      DLDataType bytes_type{kDLUInt, 8, 1};
+      DLTensor from{buffer.data(), Device{kDLCPU, 0}, 1, bytes_type, &nbytes, nullptr, 0};
+      DLTensor chunk{to->data, to->device, 1,
+                     bytes_type, &nbytes, nullptr,
+                     to->byte_offset + begin};
+      DeviceAPI::Get(to->device)->CopyDataFromTo(&from, &chunk, nullptr);
+      // The buffer is reused by the next chunk.
+      DeviceAPI::Get(to->device)->StreamSync(to->device, nullptr);
+    }
+  }
+}
+
 TVM_REGISTER_GLOBAL("runtime.SaveParams").set_body_typed([](const Map<String, NDArray>& params) {
   std::string s = ::tvm::runtime::SaveParams(params);
   // copy return array so it is owned by the ret value
@@ -246,6 +645,13 @@ TVM_REGISTER_GLOBAL("runtime.SaveParams").set_body_typed([](const Map<String, ND
 TVM_REGISTER_GLOBAL("runtime.LoadParams").set_body_typed([](const String& s) {
   return ::tvm::runtime::LoadParams(s);
 });
+TVM_REGISTER_GLOBAL("runtime.SaveParamsToFile")
+    .set_body_typed([](const Map<String, NDArray>& params, const String& file_name) {
+      ::tvm::runtime::SaveParamsToFile(file_name, params);
+    });
+TVM_REGISTER_GLOBAL("runtime.LoadParamsFromFile").set_body_typed([](const String& file_name) {
+  return ::tvm::runtime::LoadParamsFromFile(file_name);
+});
 
 }  // namespace runtime
 }  // namespace tvm
@@ -27,8 +27,10 @@
 #include <tvm/runtime/container/map.h>
 #include <tvm/runtime/container/string.h>
 
+#include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "meta_data.h"
 
@@ -129,6 +131,138 @@ std::string SaveParams(const Map<String, NDArray>& params);
  * \param params Parameters to save.
  */
 void SaveParams(dmlc::Stream* strm, const Map<String, NDArray>& params);
+
+/*!
+ * \brief The magic number of the aligned parameter format.
+ *
+ *  The file starts with the magic, a reserved word of flags and the size of the index, followed
+ *  by the index (the name, dtype, shape, offset, size and checksum of each array, see
+ *  AlignedParamEntry) and the data of the arrays.
+ *  The data of each array starts at an offset aligned to kTVMAlignedParamsAlignment, so that
+ *  the arrays can be used in place once the file is mapped into memory.
+ */
+constexpr uint64_t kTVMAlignedNDArrayListMagic = 0xF7E58D4F05049CB8;
+/*! \brief The alignment of the array data in the aligned parameter format. */
+constexpr size_t kTVMAlignedParamsAlignment = 64;
+/*! \brief The flag of the reserved word telling that the index holds the checksum of each array. */
+constexpr uint64_t kTVMAlignedParamsChecksumFlag = 1;
+/*! \brief The index entry of an array in the aligned parameter format. */
+struct AlignedParamEntry {
+  std::string name;
+  DLDataType dtype;
+  std::vector<int64_t> shape;
+  /*! \brief The offset of the data from the beginning of the file. */
+  uint64_t offset;
+  uint64_t nbytes;
+  /*! \brief The ParamChecksum of the data, 0 if the file holds no checksums. */
+  uint64_t checksum;
+};
+/*!
+ * \brief Load the index of a file in the aligned parameter format.
+ * \param data The content of the file.
+ * \param size The size of the file.
+ * \param has_checksum Set to whether the index holds the checksum of each array.
+ * \return The index entries, whose data is checked to lie in the file.
+ */
+std::vector<AlignedParamEntry> LoadAlignedParamIndex(const char* data, size_t size,
+                                                     bool* has_checksum);
+
+/*!
+ * \brief The size of the blocks of the data of an array which ParamChecksum hashes separately, so
+ *  that the blocks of a large array can be verified in parallel.
+ */
+constexpr size_t kTVMParamChecksumBlockBytes = 4 << 20;
+/*!
+ * \brief Hash a block of the data of an array.
+ * \param data The block.
+ * \param nbytes The size of the block, at most kTVMParamChecksumBlockBytes.
+ * \return The hash.
+ */
+uint64_t ParamChecksumBlock(const void* data, size_t nbytes);
+/*!
+ * \brief Combine the hashes of the blocks of the data of an array into its checksum.
+ * \param block_hashes The ParamChecksumBlock of each block, in order.
+ * \return The checksum.
+ */
+uint64_t ParamChecksumCombine(const std::vector<uint64_t>& block_hashes);
+/*!
+ * \brief Compute the checksum of the data of an array in the aligned parameter format.
+ * \param data The data.
+ * \param nbytes The size of the data.
+ * \return The checksum.
+ */
+uint64_t ParamChecksum(const void* data, size_t nbytes);
+
+/*!
+ * \brief A file mapped into memory copy-on-write, or read into memory where mapping is not
+ *  supported.
+ */
+class MappedFile {
+ public:
+  /*!
+   * \brief Map a file.
+   * \param file_name The name of the file.
+   */
+  explicit MappedFile(const std::string& file_name);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  /*! \return The content of the file. */
+  char* data() const { return data_; }
+  /*! \return The size of the file. */
+  size_t size() const { return size_; }
+  /*!
+   * \brief Start reading a range of the file into memory in the background.
+   * \param offset The beginning of the range.
+   * \param nbytes The size of the range.
+   */
+  void Prefetch(size_t offset, size_t nbytes) const;
+
+ private:
+  char* data_{nullptr};
+  size_t size_{0};
+#if defined(_WIN32)
+  std::string buffer_;
+#endif
+};
+
+/*!
+ * \brief Serialize parameters to a stream in the aligned format.
+ * \param strm Stream to write to.
+ * \param params Parameters to save.
+ */
+void SaveParamsAligned(dmlc::Stream* strm, const Map<String, NDArray>& params);
+/*!
+ * \brief Save parameters to a file in the aligned format.
+ * \param file_name The name of the file.
+ * \param params Parameters to save.
+ */
+void SaveParamsToFile(const std::string& file_name, const Map<String, NDArray>& params);
+/*!
+ * \brief Load parameters from a file saved by SaveParams or SaveParamsToFile.
+ *
+ *  A file in the aligned format is mapped into memory and the returned CPU arrays view the
+ *  mapping, copy-on-write, without copying the data.
+ * \param file_name The name of the file.
+ * \return Map of parameter name to parameter value.
+ */
+Map<String, NDArray> LoadParamsFromFile(const std::string& file_name);
+/*!
+ * \brief Load parameters from a file saved by SaveParams or SaveParamsToFile into existing
+ *  arrays, which may be on any device.
+ *
+ *  The data of an array in the aligned format is copied chunk by chunk, so that only a chunk
+ *  is held in host memory at a time. Files in the format of SaveParams are loaded with
+ *  LoadParamsFromFile and then copied.
+ * \param file_name The name of the file.
+ * \param fdest Returns the contiguous array to load a parameter into given its name, or an
+ *  undefined array to skip the parameter.
+ * \param chunk_bytes The size of the chunks.
+ */
+void LoadParamsFromFile(const std::string& file_name,
+                        const std::function<NDArray(const std::string&)>& fdest,
+                        size_t chunk_bytes = 16 << 20);
 }  // namespace runtime
 }  // namespace tvm
 #endif  // TVM_RUNTIME_FILE_UTILS_H_
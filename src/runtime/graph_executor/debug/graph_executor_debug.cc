@@ -151,9 +151,9 @@ class GraphExecutorDebug : public GraphExecutor {
     // which represent inputs/parameters to the graph. Other types may be supported in the
     // future, but consideration would be needed as to how to do that over RPC before we support
     // it here.
-    if (nodes_[index].op_type != "tvm_op") {
-      CHECK_EQ(nodes_[index].op_type, "null")
-          << "Don't know how to run op type " << nodes_[index].op_type
+    if (graph_->nodes[index].op_type != "tvm_op") {
+      CHECK_EQ(graph_->nodes[index].op_type, "null")
+          << "Don't know how to run op type " << graph_->nodes[index].op_type
           << " remotely over RPC right now";
 
       // NOTE: GraphExecutorDebug expects graph nodes to have an "op" attribute of "tvm_op" or
@@ -162,7 +162,7 @@ class GraphExecutorDebug : public GraphExecutor {
     }
 
     const Device& dev = data_entry_[entry_id(index, 0)]->device;
-    TVMOpParam param = nodes_[index].param;
+    TVMOpParam param = graph_->nodes[index].param;
     std::string name = param.func_name;
     uint32_t num_inputs = param.num_inputs;
     uint32_t num_outputs = param.num_outputs;
@@ -179,7 +179,7 @@ class GraphExecutorDebug : public GraphExecutor {
     auto type_codes = std::make_unique<int[]>(num_flat_args);
     TVMArgsSetter setter(values.get(), type_codes.get());
     int offs = 0;
-    const auto& inode = nodes_[index];
+    const auto& inode = graph_->nodes[index];
     for (const auto& e : inode.inputs) {
       uint32_t eid = this->entry_id(e);
       DLTensor* arg = const_cast<DLTensor*>(data_entry_[eid].operator->());
@@ -332,11 +332,11 @@ class GraphExecutorDebug : public GraphExecutor {
       if (op_execs_[i]) {
         // get argument shapes
         std::vector<NDArray> shapes;
-        for (const auto& e : nodes_[i].inputs) {
+        for (const auto& e : graph_->nodes[i].inputs) {
           uint32_t eid = entry_id(e);
           shapes.push_back(data_entry_[eid]);
         }
-        for (uint32_t j = 0; j < nodes_[i].param.num_outputs; ++j) {
+        for (uint32_t j = 0; j < graph_->nodes[i].param.num_outputs; ++j) {
           uint32_t eid = entry_id(i, j);
           shapes.push_back(data_entry_[eid]);
         }
@@ -345,16 +345,16 @@ class GraphExecutorDebug : public GraphExecutor {
         const Device& dev = data_entry_[eid]->device;
 
         std::unordered_map<std::string, ObjectRef> metrics;
-        for (auto p : nodes_[i].param.attrs) {
+        for (auto p : graph_->nodes[i].param.attrs) {
           if (std::string(p.first).find("layout") != std::string::npos) {
             metrics[p.first] = p.second;
           }
         }
-        if (nodes_[i].param.attrs.find("hash") != nodes_[i].param.attrs.end()) {
-          metrics["Hash"] = Downcast<String>(nodes_[i].param.attrs.at("hash"));
+        if (graph_->nodes[i].param.attrs.find("hash") != graph_->nodes[i].param.attrs.end()) {
+          metrics["Hash"] = Downcast<String>(graph_->nodes[i].param.attrs.at("hash"));
         }
         metrics["Argument Shapes"] = profiling::ShapeString(shapes);
-        prof.StartCall(nodes_[i].param.func_name, dev, metrics);
+        prof.StartCall(graph_->nodes[i].param.func_name, dev, metrics);
         op_execs_[i]();
         prof.StopCall();
       }
@@ -422,7 +422,7 @@ PackedFunc GraphExecutorDebug::GetFunction(const std::string& name,
       int cooldown_interval_ms = args[5];
       int repeats_to_cooldown = args[6];
       ICHECK_GE(node_index, 0);
-      ICHECK_LT(node_index, nodes_.size());
+      ICHECK_LT(node_index, graph_->nodes.size());
       ICHECK_GT(number, 0);
       ICHECK_GT(repeat, 0);
       ICHECK_GE(min_repeat_ms, 0);
@@ -31,12 +31,18 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -56,15 +62,173 @@ constexpr auto Is2DStorage = IsTextureStorage;
 }  // namespace details
 
 /*!
- * \brief Run all the operations one by one.
+ * \brief A pool of workers which runs each operator of a graph once all the operators it depends
+ *  on are done.
+ */
+class GraphExecutor::ParallelScheduler {
+ public:
+  ParallelScheduler(int num_workers, int intra_op_threads) {
+    // By default the cores are split evenly between the workers.
+    if (intra_op_threads == 0) {
+      intra_op_threads = std::max(1, threading::MaxConcurrency() / num_workers);
+    }
+    // Each worker is pinned to its own cores when there are enough of them, otherwise the
+    // threads of all the workers may run on any core.
+    unsigned num_cpus = std::thread::hardware_concurrency();
+    bool pin = static_cast<int64_t>(num_workers) * intra_op_threads <= num_cpus;
+    for (int i = 0; i < num_workers; ++i) {
+      std::vector<unsigned int> cpus;
+      if (pin) {
+        for (int j = 0; j < intra_op_threads; ++j) {
+          cpus.push_back(i * intra_op_threads + j);
+        }
+      } else {
+        for (unsigned cpu = 0; cpu < num_cpus; ++cpu) {
+          cpus.push_back(cpu);
+        }
+      }
+      workers_.emplace_back([this, pin, intra_op_threads, cpus]() {
+        this->WorkerLoop(pin, intra_op_threads, cpus);
+      });
+    }
+  }
+
+  ~ParallelScheduler() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutdown_ = true;
+    }
+    cv_ready_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /*!
+   * \brief Run the operators and wait until all of them are done.
+   * \param op_execs The operator on each node, empty for the nodes which are not operators.
+   * \param op_succs The operators that depend on each node.
+   * \param op_num_deps The number of operators each node depends on.
+   */
+  void Run(const std::vector<std::function<void()>>& op_execs,
+           const std::vector<std::vector<uint32_t>>& op_succs,
+           const std::vector<uint32_t>& op_num_deps) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    op_execs_ = &op_execs;
+    op_succs_ = &op_succs;
+    pending_deps_ = op_num_deps;
+    num_remaining_ = 0;
+    error_ = nullptr;
+    for (uint32_t nid = 0; nid < op_execs.size(); ++nid) {
+      if (!op_execs[nid]) continue;
+      ++num_remaining_;
+      if (pending_deps_[nid] == 0) ready_.push_back(nid);
+    }
+    cv_ready_.notify_all();
+    cv_done_.wait(lock, [this]() { return num_remaining_ == 0; });
+    if (error_ != nullptr) {
+      std::exception_ptr error = error_;
+      error_ = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  void WorkerLoop(bool pin, int intra_op_threads, const std::vector<unsigned int>& cpus) {
+    {
+      // The thread pool used by the operators is local to each worker.
+      std::lock_guard<std::mutex> lock(mutex_);
+      threading::Configure(pin ? threading::ThreadGroup::kSpecifyOneCorePerThread
+                               : threading::ThreadGroup::kSpecifyThreadShareAllCore,
+                           intra_op_threads, cpus);
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_ready_.wait(lock, [this]() { return shutdown_ || !ready_.empty(); });
+      if (shutdown_) return;
+      uint32_t nid = ready_.front();
+      ready_.pop_front();
+      // Once an operator fails, the rest are only drained.
+      bool skip = error_ != nullptr;
+      lock.unlock();
+      std::exception_ptr error = nullptr;
+      if (!skip) {
+        try {
+          (*op_execs_)[nid]();
+        } catch (...) {
+          error = std::current_exception();
+        }
+      }
+      lock.lock();
+      if (error != nullptr && error_ == nullptr) {
+        error_ = error;
+      }
+      size_t num_ready = 0;
+      for (uint32_t succ : (*op_succs_)[nid]) {
+        if (--pending_deps_[succ] == 0) {
+          ready_.push_back(succ);
+          ++num_ready;
+        }
+      }
+      if (--num_remaining_ == 0) {
+        cv_done_.notify_one();
+      } else if (num_ready > 1) {
+        cv_ready_.notify_all();
+      } else if (num_ready == 1) {
+        cv_ready_.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  // The mutex guarding all the states below.
+  std::mutex mutex_;
+  std::condition_variable cv_ready_;
+  std::condition_variable cv_done_;
+  // The operators whose dependencies are all done.
+  std::deque<uint32_t> ready_;
+  // The number of dependencies of each node not done yet.
+  std::vector<uint32_t> pending_deps_;
+  // The number of operators not done yet in the current run.
+  size_t num_remaining_{0};
+  const std::vector<std::function<void()>>* op_execs_{nullptr};
+  const std::vector<std::vector<uint32_t>>* op_succs_{nullptr};
+  // The first error raised by an operator in the current run.
+  std::exception_ptr error_;
+  bool shutdown_{false};
+};
+
+GraphExecutor::~GraphExecutor() = default;
+
+/*!
+ * \brief Run all the operations one by one, or on the workers in the parallel mode.
  */
 void GraphExecutor::Run() {
+  if (parallel_scheduler_ != nullptr) {
+    parallel_scheduler_->Run(op_execs_, graph_->op_succs, graph_->op_num_deps);
+    return;
+  }
   // setup the array and requirements.
   for (size_t i = 0; i < op_execs_.size(); ++i) {
     if (op_execs_[i]) op_execs_[i]();
   }
 }
 
+void GraphExecutor::SetParallel(int num_workers, int intra_op_threads) {
+  ICHECK_GE(num_workers, 0);
+  ICHECK_GE(intra_op_threads, 0);
+  parallel_scheduler_.reset();
+  if (num_workers <= 1) return;
+  for (const Device& dev : devices_) {
+    if (dev.device_type != kDLCPU) {
+      LOG(WARNING) << "Only graphs on CPU devices are run in parallel, running the operators "
+                   << "one by one";
+      return;
+    }
+  }
+  parallel_scheduler_ = std::make_unique<ParallelScheduler>(num_workers, intra_op_threads);
+}
+
 /*!
  * \brief Initialize the graph executor with graph and device.
  * \param graph_json The execution graph.
@@ -79,7 +243,8 @@ void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module mod
                          const PackedFunc lookup_linked_param_func) {
   std::istringstream is(graph_json);
   dmlc::JSONReader reader(&is);
-  this->Load(&reader);
+  auto graph = std::make_shared<GraphDef>();
+  graph->Load(&reader);
   module_ = module;
   devices_ = devs;
   lookup_linked_param_ = lookup_linked_param_func;
@@ -87,20 +252,23 @@ void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module mod
     lookup_linked_param_ = PackedFunc(
         [this](TVMArgs args, TVMRetValue* rv) { this->DefaultLookupLinkedParam(args, rv); });
   }
-  this->SetupStorage();
-  this->SetupOpExecs();
-  for (size_t i = 0; i < input_nodes_.size(); i++) {
-    const uint32_t nid = input_nodes_[i];
-    std::string& name = nodes_[nid].name;
-    input_map_[name] = i;
-  }
-  for (size_t i = 0; i < outputs_.size(); i++) {
-    const uint32_t nid = outputs_[i].node_id;
-    std::string& name = nodes_[nid].name;
+  this->PlanStorage(graph.get());
+  SetupOpDeps(graph.get());
+  for (size_t i = 0; i < graph->input_nodes.size(); i++) {
+    const uint32_t nid = graph->input_nodes[i];
+    const std::string& name = graph->nodes[nid].name;
+    graph->input_map[name] = i;
+  }
+  for (size_t i = 0; i < graph->outputs.size(); i++) {
+    const uint32_t nid = graph->outputs[i].node_id;
+    const std::string& name = graph->nodes[nid].name;
     std::stringstream ss;
     ss << name << ":" << i;
-    output_map_[ss.str()] = i;
+    graph->output_map[ss.str()] = i;
   }
+  graph_ = std::move(graph);
+  this->SetupStorage();
+  this->SetupOpExecs();
 }
 
 /*!
@@ -109,8 +277,8 @@ void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module mod
  * \return The index of input.
  */
 int GraphExecutor::GetInputIndex(const std::string& name) {
-  auto it = input_map_.find(name);
-  if (it != input_map_.end()) {
+  auto it = graph_->input_map.find(name);
+  if (it != graph_->input_map.end()) {
     return it->second;
   }
   return -1;
@@ -123,15 +291,15 @@ int GraphExecutor::GetInputIndex(const std::string& name) {
 std::tuple<GraphExecutor::ShapeInfo, GraphExecutor::DtypeInfo> GraphExecutor::GetInputInfo() const {
   GraphExecutor::ShapeInfo shape_dict;
   GraphExecutor::DtypeInfo dtype_dict;
-  for (uint32_t nid : input_nodes_) {
-    CHECK_LE(nid, nodes_.size());
-    std::string name = nodes_[nid].name;
+  for (uint32_t nid : graph_->input_nodes) {
+    CHECK_LE(nid, graph_->nodes.size());
+    std::string name = graph_->nodes[nid].name;
     if (param_names_.find(name) == param_names_.end()) {
-      CHECK_LE(nid, attrs_.shape.size());
-      auto shape = attrs_.shape[nid];
+      CHECK_LE(nid, graph_->attrs.shape.size());
+      auto shape = graph_->attrs.shape[nid];
       shape_dict.Set(name, ShapeTuple(shape));
-      CHECK_LE(nid, attrs_.dltype.size());
-      auto dtype = attrs_.dltype[nid];
+      CHECK_LE(nid, graph_->attrs.dltype.size());
+      auto dtype = graph_->attrs.dltype[nid];
       dtype_dict.Set(name, String(dtype));
     }
   }
@@ -144,8 +312,8 @@ std::tuple<GraphExecutor::ShapeInfo, GraphExecutor::DtypeInfo> GraphExecutor::Ge
  * \return The index of output.
  */
 int GraphExecutor::GetOutputIndex(const std::string& name) {
-  auto it = output_map_.find(name);
-  if (it != output_map_.end()) {
+  auto it = graph_->output_map.find(name);
+  if (it != graph_->output_map.end()) {
     return it->second;
   }
   return -1;
@@ -156,10 +324,16 @@ int GraphExecutor::GetOutputIndex(const std::string& name) {
  * \param data_in The input data.
  */
 void GraphExecutor::SetInput(int index, DLTensor* data_in) {
-  ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
-  uint32_t eid = this->entry_id(input_nodes_[index], 0);
+  ICHECK_LT(static_cast<size_t>(index), graph_->input_nodes.size());
+  uint32_t eid = this->entry_id(graph_->input_nodes[index], 0);
   data_entry_[eid].CopyFrom(data_in);
 }
+
+void GraphExecutor::SetParam(int index, DLTensor* data_in) {
+  ICHECK_LT(static_cast<size_t>(index), graph_->input_nodes.size());
+  shared_input_names_.insert(graph_->nodes[graph_->input_nodes[index]].name);
+  this->SetInput(index, data_in);
+}
 /*!
  * \brief Check the legality of external DLTensor*.
  * \param external The external DLTensor*.
@@ -185,8 +359,8 @@ void GraphExecutor::CheckExternalDLTensor(const DLTensor* external, uint32_t eid
  * \param data_ref The input data that is referred.
  */
 void GraphExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
-  ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
-  uint32_t eid = this->entry_id(input_nodes_[index], 0);
+  ICHECK_LT(static_cast<size_t>(index), graph_->input_nodes.size());
+  uint32_t eid = this->entry_id(graph_->input_nodes[index], 0);
   // check the consistency of input
   CheckExternalDLTensor(data_ref, eid);
   // Update the data pointer for each argument of each op
@@ -200,9 +374,9 @@ void GraphExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
  * \param data_ref The output data that is referred.
  */
 void GraphExecutor::SetOutputZeroCopy(int index, DLTensor* data_ref) {
-  ICHECK_LT(static_cast<size_t>(index), outputs_.size());
+  ICHECK_LT(static_cast<size_t>(index), graph_->outputs.size());
   ICHECK_LT(static_cast<size_t>(index), output_dltensors_.size());
-  const NodeEntry& output_node = outputs_[index];
+  const NodeEntry& output_node = graph_->outputs[index];
   uint32_t output_node_eid = this->entry_id(output_node);
 
   // check the consistency of output
@@ -223,13 +397,13 @@ void GraphExecutor::SetOutputZeroCopy(int index, DLTensor* data_ref) {
  *
  * \return The number of outputs from graph.
  */
-int GraphExecutor::NumOutputs() const { return outputs_.size(); }
+int GraphExecutor::NumOutputs() const { return graph_->outputs.size(); }
 /*!
  * \brief Get the number of inputs
  *
  * \return The number of inputs to the graph.
  */
-int GraphExecutor::NumInputs() const { return input_nodes_.size(); }
+int GraphExecutor::NumInputs() const { return graph_->input_nodes.size(); }
 /*!
  * \brief Return NDArray for given input index.
  * \param index The input index.
@@ -237,8 +411,8 @@ int GraphExecutor::NumInputs() const { return input_nodes_.size(); }
  * \return NDArray corresponding to given input node index.
  */
 NDArray GraphExecutor::GetInput(int index) const {
-  ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
-  uint32_t eid = this->entry_id(input_nodes_[index], 0);
+  ICHECK_LT(static_cast<size_t>(index), graph_->input_nodes.size());
+  uint32_t eid = this->entry_id(graph_->input_nodes[index], 0);
   return data_entry_[eid];
 }
 /*!
@@ -248,8 +422,8 @@ NDArray GraphExecutor::GetInput(int index) const {
  * \return NDArray corresponding to given output node index.
  */
 NDArray GraphExecutor::GetOutput(int index) const {
-  ICHECK_LT(static_cast<size_t>(index), outputs_.size());
-  uint32_t eid = this->entry_id(outputs_[index]);
+  ICHECK_LT(static_cast<size_t>(index), graph_->outputs.size());
+  uint32_t eid = this->entry_id(graph_->outputs[index]);
   return data_entry_[eid];
 }
 /*!
@@ -258,8 +432,8 @@ NDArray GraphExecutor::GetOutput(int index) const {
  * \param data_out the output data.
  */
 void GraphExecutor::CopyOutputTo(int index, DLTensor* data_out) {
-  ICHECK_LT(static_cast<size_t>(index), outputs_.size());
-  uint32_t eid = this->entry_id(outputs_[index]);
+  ICHECK_LT(static_cast<size_t>(index), graph_->outputs.size());
+  uint32_t eid = this->entry_id(graph_->outputs[index]);
 
   // Check the shapes to avoid receiving in different dimension but same size.
   const NDArray& data = data_entry_[eid];
@@ -286,11 +460,20 @@ void GraphExecutor::LoadParams(dmlc::Stream* strm) {
     param_names_.insert(p.first);
     int in_idx = GetInputIndex(p.first);
     if (in_idx < 0) continue;
-    uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
+    uint32_t eid = this->entry_id(graph_->input_nodes[in_idx], 0);
     data_entry_[eid].CopyFrom(p.second);
   }
 }
 
+void GraphExecutor::LoadParamsFromFile(const std::string& file_name) {
+  ::tvm::runtime::LoadParamsFromFile(file_name, [this](const std::string& name) {
+    param_names_.insert(name);
+    int in_idx = GetInputIndex(name);
+    if (in_idx < 0) return NDArray();
+    return data_entry_[this->entry_id(graph_->input_nodes[in_idx], 0)];
+  });
+}
+
 void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm) {
   uint64_t header, reserved;
   ICHECK(strm->Read(&header)) << "Invalid parameters file format";
@@ -303,9 +486,10 @@ void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm)
   size_t size = static_cast<size_t>(sz);
   ICHECK(size == names.size()) << "Invalid parameters file format";
   for (size_t i = 0; i < size; ++i) {
+    shared_input_names_.insert(names[i]);
     int in_idx = GetInputIndex(names[i]);
     if (in_idx < 0) continue;
-    uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
+    uint32_t eid = this->entry_id(graph_->input_nodes[in_idx], 0);
     ICHECK_LT(eid, data_entry_.size());
     ICHECK_EQ(data_entry_[eid].use_count(), 1);
     data_entry_[eid] = other.GetInput(GetInputIndex(names[i]));
@@ -316,6 +500,52 @@ void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm)
   this->SetupOpExecs();
 }
 
+Module GraphExecutor::CreateInstance() const {
+  auto exec = make_object<GraphExecutor>();
+  exec->graph_ = graph_;
+  exec->param_names_ = param_names_;
+  exec->shared_input_names_ = shared_input_names_;
+  exec->module_ = module_;
+  exec->devices_ = devices_;
+  exec->op_funcs_ = op_funcs_;
+
+  // The parameters and the linked parameters keep their storage, the planner never shares it
+  // with other entries. The rest of the storage is allocated for the new executor.
+  std::vector<uint32_t> param_eids, input_eids;
+  std::vector<bool> shared(storage_pool_.size(), false);
+  for (uint32_t nid : graph_->input_nodes) {
+    const std::string& name = graph_->nodes[nid].name;
+    uint32_t eid = this->entry_id(nid, 0);
+    if (param_names_.count(name) || shared_input_names_.count(name)) {
+      param_eids.push_back(eid);
+      shared[graph_->attrs.storage_id[eid]] = true;
+    } else {
+      input_eids.push_back(eid);
+    }
+  }
+  for (size_t sid = 0; sid < graph_->pool_entries.size(); ++sid) {
+    if (shared[sid] || graph_->pool_entries[sid].linked_param.defined()) {
+      exec->storage_pool_.push_back(storage_pool_[sid]);
+    } else {
+      exec->storage_pool_.push_back(AllocatePoolEntry(graph_->pool_entries[sid]));
+    }
+  }
+  exec->SetupDataEntries();
+  // The parameters shared by ShareParams are not views of the storage pool.
+  for (uint32_t eid : param_eids) {
+    exec->data_entry_[eid] = data_entry_[eid];
+    exec->data_alignment_[eid] = data_alignment_[eid];
+  }
+  // The other inputs start from the values set on this executor, which includes weights that
+  // were passed to set_input rather than loaded as parameters.
+  for (uint32_t eid : input_eids) {
+    exec->data_entry_[eid].CopyFrom(data_entry_[eid]);
+  }
+  // Only the operator arguments are bound again, the functions and dependencies are shared.
+  exec->SetupOpExecs();
+  return Module(exec);
+}
+
 void GraphExecutor::LinkedNDArrayDeleter(Object* container) {
   // container is the NDArray::Container which needs to get deleted.
   // The data member points to global const memory, so it does not need deleting.
@@ -353,23 +583,25 @@ void GraphExecutor::DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv) {
   *rv = NDArray(GetObjectPtr<Object>(container));
 }
 
-void GraphExecutor::SetupStorage() {
+void GraphExecutor::PlanStorage(GraphDef* graph) const {
+  const GraphAttr& attrs = graph->attrs;
   // Grab saved optimization plan from graph.
   std::vector<DLDataType> vtype;
-  for (const std::string& s_type : attrs_.dltype) {
+  for (const std::string& s_type : attrs.dltype) {
     vtype.push_back(tvm::runtime::String2DLDataType(s_type));
   }
 
   // Size and device type of each storage pool entry.
-  std::vector<PoolEntry> pool_entry;
+  std::vector<PoolEntry>& pool_entry = graph->pool_entries;
+  pool_entry.clear();
   // Find the maximum space size.
-  for (size_t i = 0; i < attrs_.shape.size(); ++i) {
-    int storage_id = attrs_.storage_id[i];
-    std::string storage_scope = attrs_.storage_scope.empty() ? "" : attrs_.storage_scope[i];
+  for (size_t i = 0; i < attrs.shape.size(); ++i) {
+    int storage_id = attrs.storage_id[i];
+    std::string storage_scope = attrs.storage_scope.empty() ? "" : attrs.storage_scope[i];
     // Use the fallback device if no device index is available.
     int device_type = static_cast<int>(devices_[0].device_type);
-    if (!attrs_.device_index.empty()) {
-      device_type = attrs_.device_index[i];
+    if (!attrs.device_index.empty()) {
+      device_type = attrs.device_index[i];
     }
 
     uint32_t sid = static_cast<uint32_t>(storage_id);
@@ -381,7 +613,7 @@ void GraphExecutor::SetupStorage() {
     }
     TVMRetValue lookup_rv;
     {
-      std::vector<int64_t> shape_vec{attrs_.shape[i].begin(), attrs_.shape[i].end()};
+      std::vector<int64_t> shape_vec{attrs.shape[i].begin(), attrs.shape[i].end()};
       DLTensor template_tensor{nullptr,  Device{kDLCPU, 0}, static_cast<int>(shape_vec.size()),
                                vtype[i], shape_vec.data(),  nullptr,
                                0};
@@ -397,7 +629,7 @@ void GraphExecutor::SetupStorage() {
     DLDataType t = vtype[i];
     if (!details::Is2DStorage(storage_scope)) {
       size_t size = 1;
-      for (int64_t sz : attrs_.shape[i]) {
+      for (int64_t sz : attrs.shape[i]) {
         size *= static_cast<size_t>(sz);
       }
       size_t bits = t.bits * t.lanes;
@@ -409,8 +641,8 @@ void GraphExecutor::SetupStorage() {
       if (pool_entry[sid].shape.size() == 1) {
         pool_entry[sid].shape.resize(3, 0);
       }
-      size_t axis = runtime::DefaultTextureLayoutSeparator(attrs_.shape[i].size(), storage_scope);
-      auto shape = ApplyTexture2DFlattening<int64_t>(attrs_.shape[i], attrs_.shape[i].size(), axis);
+      size_t axis = runtime::DefaultTextureLayoutSeparator(attrs.shape[i].size(), storage_scope);
+      auto shape = ApplyTexture2DFlattening<int64_t>(attrs.shape[i], attrs.shape[i].size(), axis);
       pool_entry[sid].shape[0] = std::max(pool_entry[sid].shape[0], shape.height);
       pool_entry[sid].shape[1] = std::max(pool_entry[sid].shape[1], shape.width);
       CHECK(pool_entry[sid].shape[2] == 0 || pool_entry[sid].shape[2] == shape.channel)
@@ -424,39 +656,52 @@ void GraphExecutor::SetupStorage() {
       pool_entry[sid].dtype = t;
     }
   }
+}
 
+void GraphExecutor::SetupStorage() {
   // Allocate the space.
-  for (const auto& pit : pool_entry) {
-    // This for loop is very fast since there are usually only a couple of
-    // devices available on the same hardware.
-    const auto& cit = std::find_if(devices_.begin(), devices_.end(), [&pit](const Device& d) {
-      return pit.device_type == static_cast<int>(d.device_type);
-    });
-    Device dev = cit == devices_.end() ? devices_[0] : *cit;
+  for (const auto& pit : graph_->pool_entries) {
     if (pit.linked_param.defined()) {
       storage_pool_.push_back(pit.linked_param);
     } else {
-      std::vector<int64_t> shape = pit.shape;
-      if (shape.size() == 1) {
-        shape[0] = (shape[0] + 3) / 4;
-      }
-      Optional<String> mem_scope;
-      if (!pit.scope.empty()) {
-        mem_scope = String(pit.scope);
-      }
-      storage_pool_.push_back(NDArray::Empty(shape, pit.dtype, dev, mem_scope));
+      storage_pool_.push_back(AllocatePoolEntry(pit));
     }
   }
+  this->SetupDataEntries();
+}
+
+NDArray GraphExecutor::AllocatePoolEntry(const PoolEntry& pit) const {
+  // This lookup is very fast since there are usually only a couple of
+  // devices available on the same hardware.
+  const auto& cit = std::find_if(devices_.begin(), devices_.end(), [&pit](const Device& d) {
+    return pit.device_type == static_cast<int>(d.device_type);
+  });
+  Device dev = cit == devices_.end() ? devices_[0] : *cit;
+  std::vector<int64_t> shape = pit.shape;
+  if (shape.size() == 1) {
+    shape[0] = (shape[0] + 3) / 4;
+  }
+  Optional<String> mem_scope;
+  if (!pit.scope.empty()) {
+    mem_scope = String(pit.scope);
+  }
+  return NDArray::Empty(shape, pit.dtype, dev, mem_scope);
+}
 
+void GraphExecutor::SetupDataEntries() {
+  std::vector<DLDataType> vtype;
+  for (const std::string& s_type : graph_->attrs.dltype) {
+    vtype.push_back(tvm::runtime::String2DLDataType(s_type));
+  }
   // Assign the pooled entries. A unified memory pool is used to simplifiy
   // memory assignment for each node entry. The allocated memory on each device
   // is mapped to this pool.
   data_entry_.resize(num_node_entries());
   data_alignment_.resize(num_node_entries());
   for (size_t i = 0; i < data_entry_.size(); ++i) {
-    int storage_id = attrs_.storage_id[i];
+    int storage_id = graph_->attrs.storage_id[i];
     ICHECK_LT(static_cast<size_t>(storage_id), storage_pool_.size());
-    data_entry_[i] = storage_pool_[storage_id].CreateView(attrs_.shape[i], vtype[i]);
+    data_entry_[i] = storage_pool_[storage_id].CreateView(graph_->attrs.shape[i], vtype[i]);
 
     const DLTensor* tmp = data_entry_[i].operator->();
     data_alignment_[i] = details::GetDataAlignment(*tmp);
@@ -469,18 +714,18 @@ void GraphExecutor::SetupOpExecs() {
   output_dltensors_.resize(num_node_entries());
   both_output_opinput_dltensors_.resize(num_node_entries());
   std::unordered_set<uint32_t> input_node_eids;
-  for (size_t i = 0; i < input_nodes_.size(); i++) {
-    uint32_t nid = input_nodes_[i];
+  for (size_t i = 0; i < graph_->input_nodes.size(); i++) {
+    uint32_t nid = graph_->input_nodes[i];
     input_node_eids.insert(entry_id(nid, 0));
   }
   std::unordered_set<uint32_t> output_node_eids;
-  for (size_t i = 0; i < outputs_.size(); i++) {
-    output_node_eids.insert(entry_id(outputs_[i]));
+  for (size_t i = 0; i < graph_->outputs.size(); i++) {
+    output_node_eids.insert(entry_id(graph_->outputs[i]));
   }
 
   // setup the array and requirements.
   for (uint32_t nid = 0; nid < this->GetNumOfNodes(); ++nid) {
-    const auto& inode = nodes_[nid];
+    const auto& inode = graph_->nodes[nid];
     if (inode.op_type == "null") continue;
     std::vector<DLTensor> args;
     for (const auto& e : inode.inputs) {
@@ -521,6 +766,47 @@ void GraphExecutor::SetupOpExecs() {
   }
 }
 
+void GraphExecutor::SetupOpDeps(GraphDef* graph) {
+  uint32_t num_nodes = static_cast<uint32_t>(graph->nodes.size());
+  size_t num_storage = graph->pool_entries.size();
+  auto storage_id = [graph](uint32_t nid, uint32_t index) {
+    return graph->attrs.storage_id[graph->node_row_ptr[nid] + index];
+  };
+  std::vector<std::unordered_set<uint32_t>> deps(num_nodes);
+  // The last operator which wrote to each storage, and the operators which read it since.
+  std::vector<int64_t> last_writer(num_storage, -1);
+  std::vector<std::vector<uint32_t>> readers(num_storage);
+  for (uint32_t nid = 0; nid < num_nodes; ++nid) {
+    const auto& inode = graph->nodes[nid];
+    if (inode.op_type == "null") continue;
+    for (const auto& e : inode.inputs) {
+      int sid = storage_id(e.node_id, e.index);
+      if (last_writer[sid] >= 0) deps[nid].insert(static_cast<uint32_t>(last_writer[sid]));
+      readers[sid].push_back(nid);
+    }
+    for (uint32_t index = 0; index < inode.param.num_outputs; ++index) {
+      int sid = storage_id(nid, index);
+      if (last_writer[sid] >= 0) deps[nid].insert(static_cast<uint32_t>(last_writer[sid]));
+      for (uint32_t reader : readers[sid]) {
+        deps[nid].insert(reader);
+      }
+      readers[sid].clear();
+      last_writer[sid] = nid;
+    }
+    // An operator reading its own output storage does not depend on itself.
+    deps[nid].erase(nid);
+  }
+
+  graph->op_succs.assign(num_nodes, {});
+  graph->op_num_deps.assign(num_nodes, 0);
+  for (uint32_t nid = 0; nid < num_nodes; ++nid) {
+    graph->op_num_deps[nid] = static_cast<uint32_t>(deps[nid].size());
+    for (uint32_t dep : deps[nid]) {
+      graph->op_succs[dep].push_back(nid);
+    }
+  }
+}
+
 std::pair<std::function<void()>, std::shared_ptr<GraphExecutor::OpArgs>> GraphExecutor::CreateTVMOp(
     const TVMOpParam& param, const std::vector<DLTensor>& args) {
   std::shared_ptr<GraphExecutor::OpArgs> arg_ptr = std::make_shared<GraphExecutor::OpArgs>();
@@ -559,7 +845,10 @@ std::pair<std::function<void()>, std::shared_ptr<GraphExecutor::OpArgs>> GraphEx
 
   // Get compiled function from the module that contains both host and device
   // code.
-  tvm::runtime::PackedFunc pf = module_.GetFunction(param.func_name, true);
+  tvm::runtime::PackedFunc& pf = op_funcs_[param.func_name];
+  if (pf == nullptr) {
+    pf = module_.GetFunction(param.func_name, true);
+  }
   ICHECK(pf != nullptr) << "no such function in module: " << param.func_name;
 
   auto fexec = [arg_ptr, pf]() {
@@ -629,6 +918,11 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumInputs(); });
   } else if (name == "run") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Run(); });
+  } else if (name == "set_parallel") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int intra_op_threads = args.num_args > 1 ? args[1].operator int() : 0;
+      this->SetParallel(args[0], intra_op_threads);
+    });
   } else if (name == "run_from_inputs") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
@@ -661,6 +955,10 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       this->LoadParams(args[0].operator std::string());
     });
+  } else if (name == "load_params_from_file") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->LoadParamsFromFile(args[0].operator std::string());
+    });
   } else if (name == "share_params") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       const auto& module = args[0].operator Module();
@@ -669,6 +967,9 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
       dmlc::MemoryStringStream strm(const_cast<std::string*>(&param_blob));
       this->ShareParams(dynamic_cast<const GraphExecutor&>(*module.operator->()), &strm);
     });
+  } else if (name == "create_instance") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->CreateInstance(); });
   } else if (name == "get_input_index") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       CHECK(String::CanConvertFrom(args[0])) << "Input key is not a string";
@@ -71,8 +71,10 @@ class TVM_DLL GraphExecutor : public ModuleNode {
     std::vector<int> arg_tcodes;
     std::vector<int64_t> shape_data;
   };
+  class ParallelScheduler;
 
  public:
+  ~GraphExecutor();
   using ShapeInfo = Map<String, ObjectRef>;
   using DtypeInfo = Map<String, ObjectRef>;
   /*!
@@ -89,6 +91,17 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   const char* type_key() const final { return "GraphExecutor"; }
   void Run();
 
+  /*!
+   * \brief Run the operators on a pool of workers, each as soon as the operators it depends on
+   *  are done, instead of one by one.
+   * \param num_workers The number of workers, 0 or 1 to run the operators one by one.
+   * \param intra_op_threads The number of threads each worker runs an operator with, 0 to split
+   *  the cores evenly between the workers. Each worker is pinned to its own cores if there are
+   *  enough of them.
+   * \note Only graphs on CPU devices are run in parallel.
+   */
+  void SetParallel(int num_workers, int intra_op_threads);
+
   /*!
    * \brief Initialize the graph executor with graph and device.
    * \param graph_json The execution graph.
@@ -130,6 +143,15 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param data_in The input data.
    */
   void SetInput(int index, DLTensor* data_in);
+  /*!
+   * \brief set index-th input to a parameter of the graph.
+   *
+   *  Unlike the other inputs, the parameters are shared with the executors created by
+   *  CreateInstance. Unlike load_params, this does not hide the input from GetInputInfo.
+   * \param index The input index.
+   * \param data_in The parameter data.
+   */
+  void SetParam(int index, DLTensor* data_in);
   /*!
    * \brief set index-th input to the graph without copying the data
    * \param index The input index.
@@ -184,6 +206,11 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param param_blob A binary blob of parameter.
    */
   void LoadParams(const std::string& param_blob);
+  /*!
+   * \brief Load parameters from a file, directly into the storage of the executor.
+   * \param file_name The name of a file saved by SaveParams or SaveParamsToFile.
+   */
+  void LoadParamsFromFile(const std::string& file_name);
 
   /*!
    * \brief Share parameters from pre-existing GraphExecutor instance.
@@ -193,13 +220,26 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    */
   void ShareParams(const GraphExecutor& other, dmlc::Stream* strm);
 
+  /*!
+   * \brief Create another executor of the same graph, e.g. to serve requests concurrently.
+   *
+   *  The new executor reuses the parsed graph, the storage plan, the compiled functions of the
+   *  operators and the parameters of this one, and only allocates the storage of the inputs,
+   *  outputs and intermediate results, so that creating it is cheap. Since the parameters are
+   *  shared, setting a parameter on one executor changes it for all of them. The other inputs
+   *  are copied, so weights given to SetInput carry over but are not shared. The new executor
+   *  runs the operators one by one, see SetParallel.
+   * \return The new executor.
+   */
+  Module CreateInstance() const;
+
   /*!
    * \brief Get total number of nodes.
    * \return Total number of nodes.
    */
-  uint32_t GetNumOfNodes() const { return static_cast<uint32_t>(nodes_.size()); }
+  uint32_t GetNumOfNodes() const { return static_cast<uint32_t>(graph_->nodes.size()); }
 
-  std::string GetNodeName(uint32_t nid) const { return nodes_[nid].name; }
+  std::string GetNodeName(uint32_t nid) const { return graph_->nodes[nid].name; }
 
  protected:
   // Memory pool entry.
@@ -378,43 +418,92 @@ class TVM_DLL GraphExecutor : public ModuleNode {
       ICHECK_EQ(bitmask, 1 | 2 | 4) << "invalid format";
     }
   };
-  // The graph attribute fields.
-  void Load(dmlc::JSONReader* reader) {
-    reader->BeginObject();
-    int bitmask = 0;
-    std::string key;
-    while (reader->NextObjectItem(&key)) {
-      if (key == "nodes") {
-        reader->Read(&nodes_);
-        bitmask |= 1;
-      } else if (key == "arg_nodes") {
-        reader->Read(&input_nodes_);
-        bitmask |= 2;
-      } else if (key == "node_row_ptr") {
-        reader->Read(&node_row_ptr_);
-        bitmask |= 4;
-      } else if (key == "heads") {
-        reader->Read(&outputs_);
-        bitmask |= 8;
-      } else if (key == "attrs") {
-        reader->Read(&attrs_);
-        bitmask |= 16;
-      } else if (key == "metadata") {
-        break;
-      } else {
-        LOG(FATAL) << "key " << key << " is not supported";
+  /*!
+   * \brief The parsed graph and its storage plan. They are built by Init and only read
+   *  afterwards, so the executors created by CreateInstance share them.
+   */
+  struct GraphDef {
+    /*! \brief The graph nodes. */
+    std::vector<Node> nodes;
+    /*! \brief The argument nodes. */
+    std::vector<uint32_t> input_nodes;
+    /*! \brief Map of input names to input indices. */
+    std::unordered_map<std::string, uint32_t> input_map;
+    /*! \brief Map of output names to output indices. */
+    std::unordered_map<std::string, uint32_t> output_map;
+    /*! \brief Used for quick entry indexing. */
+    std::vector<uint32_t> node_row_ptr;
+    /*! \brief Output entries. */
+    std::vector<NodeEntry> outputs;
+    /*! \brief Additional graph attributes. */
+    GraphAttr attrs;
+    /*! \brief The storage plan, one pool entry per storage_id. */
+    std::vector<PoolEntry> pool_entries;
+    /*! \brief The operators that depend on each node, see SetupOpDeps. */
+    std::vector<std::vector<uint32_t>> op_succs;
+    /*! \brief The number of operators each node depends on. */
+    std::vector<uint32_t> op_num_deps;
+
+    // The graph attribute fields.
+    void Load(dmlc::JSONReader* reader) {
+      reader->BeginObject();
+      int bitmask = 0;
+      std::string key;
+      while (reader->NextObjectItem(&key)) {
+        if (key == "nodes") {
+          reader->Read(&nodes);
+          bitmask |= 1;
+        } else if (key == "arg_nodes") {
+          reader->Read(&input_nodes);
+          bitmask |= 2;
+        } else if (key == "node_row_ptr") {
+          reader->Read(&node_row_ptr);
+          bitmask |= 4;
+        } else if (key == "heads") {
+          reader->Read(&outputs);
+          bitmask |= 8;
+        } else if (key == "attrs") {
+          reader->Read(&attrs);
+          bitmask |= 16;
+        } else if (key == "metadata") {
+          break;
+        } else {
+          LOG(FATAL) << "key " << key << " is not supported";
+        }
       }
+      ICHECK_EQ(bitmask, 1 | 2 | 4 | 8 | 16) << "invalid format";
     }
-    ICHECK_EQ(bitmask, 1 | 2 | 4 | 8 | 16) << "invalid format";
-  }
+  };
   /*! \brief PackedFunc to lookup a linked paramter from a local Module. */
   void DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv);
   /*! \brief Delete NDArray::Container with linked (i.e. static) data. */
   static void LinkedNDArrayDeleter(Object* container);
+  /*!
+   * \brief Plan the storage of the graph.
+   * \param graph The graph, whose pool_entries are set.
+   */
+  void PlanStorage(GraphDef* graph) const;
   /*! \brief Setup the temporal storage */
   void SetupStorage();
+  /*!
+   * \brief Allocate the storage of a pool entry.
+   * \param pit The pool entry.
+   * \return The allocated storage.
+   */
+  NDArray AllocatePoolEntry(const PoolEntry& pit) const;
+  /*! \brief Setup the data entries as views of the storage pool. */
+  void SetupDataEntries();
   /*! \brief Setup the executors. */
   void SetupOpExecs();
+  /*!
+   * \brief Setup the dependencies between the operators for the parallel mode.
+   *
+   *  Besides the data dependencies, an operator depends on every operator that used the
+   *  storage it writes to before, since the storage plan shares storage between entries
+   *  whose lifetimes do not overlap in the serial order.
+   * \param graph The graph, whose op_succs and op_num_deps are set.
+   */
+  static void SetupOpDeps(GraphDef* graph);
   /*!
    * \brief Check the legality of external DLTensor*.
    * \param external The external DLTensor*.
@@ -430,33 +519,28 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::pair<std::function<void()>, std::shared_ptr<OpArgs>> CreateTVMOp(
       const TVMOpParam& attrs, const std::vector<DLTensor>& args);
   // Get node entry index.
-  uint32_t entry_id(uint32_t nid, uint32_t index) const { return node_row_ptr_[nid] + index; }
+  uint32_t entry_id(uint32_t nid, uint32_t index) const {
+    return graph_->node_row_ptr[nid] + index;
+  }
   // Get node entry index.
   uint32_t entry_id(const NodeEntry& e) const { return entry_id(e.node_id, e.index); }
   // Number of node entries.
-  uint32_t num_node_entries() const { return node_row_ptr_.back(); }
-  /*! \brief The graph nodes. */
-  std::vector<Node> nodes_;
-  /*! \brief The argument nodes. */
-  std::vector<uint32_t> input_nodes_;
+  uint32_t num_node_entries() const { return graph_->node_row_ptr.back(); }
+  /*! \brief The parsed graph and storage plan, shared with the executors of CreateInstance. */
+  std::shared_ptr<const GraphDef> graph_;
   /*! \brief The parameter names. */
   std::unordered_set<std::string> param_names_;
-  /*! \brief Map of input names to input indices. */
-  std::unordered_map<std::string, uint32_t> input_map_;
-  /*! \brief Map of output names to output indices. */
-  std::unordered_map<std::string, uint32_t> output_map_;
+  /*!
+   * \brief The names of the inputs that are shared with the executors created by CreateInstance
+   *  besides param_names_, i.e. those set by SetParam or ShareParams.
+   */
+  std::unordered_set<std::string> shared_input_names_;
   /*! \brief Used for quick node input DLTensor* lookup given an input eid. */
   std::vector<std::vector<DLTensor*>> input_dltensors_;
   /*! \brief Used for quick node output DLTensor* lookup given an output eid. */
   std::vector<std::vector<DLTensor*>> output_dltensors_;
   /*! \brief Used for quick node(both model output and op input) DLTensor* lookup given an eid. */
   std::vector<std::vector<DLTensor*>> both_output_opinput_dltensors_;
-  /*! \brief Used for quick entry indexing. */
-  std::vector<uint32_t> node_row_ptr_;
-  /*! \brief Output entries. */
-  std::vector<NodeEntry> outputs_;
-  /*! \brief Additional graph attributes. */
-  GraphAttr attrs_;
   /*! \brief The code module that contains both host and device code. */
   tvm::runtime::Module module_;
   /*! \brief Execution context of all devices including the host. */
@@ -469,6 +553,10 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::vector<size_t> data_alignment_;
   /*! \brief Operator on each node. */
   std::vector<std::function<void()>> op_execs_;
+  /*! \brief The compiled functions of the operators looked up from module_, by name. */
+  std::unordered_map<std::string, PackedFunc> op_funcs_;
+  /*! \brief The workers running the operators in the parallel mode, nullptr in the serial mode. */
+  std::unique_ptr<ParallelScheduler> parallel_scheduler_;
   /*! \brief Linked parameter lookup function. */
   PackedFunc lookup_linked_param_;
   /*! \brief Module's _lookup_linked_param function, used by DefaultLookupLinkedParam. */
@@ -119,7 +119,7 @@ class TVM_DLL GraphExecutorFactory : public runtime::ModuleNode {
     for (const auto& key : keys) {
       int in_idx = graph_executor->GetInputIndex(key);
       if (in_idx >= 0) {
-        graph_executor->SetInput(in_idx, const_cast<DLTensor*>(value[key].operator->()));
+        graph_executor->SetParam(in_idx, const_cast<DLTensor*>(value[key].operator->()));
       }
     }
   }
@@ -55,4 +55,7 @@
 
 // #define TVM_CRT_FRAMER_ENABLE_LOGS
 
+/*! \brief Use the TLSF allocator, which merges free blocks, instead of the page allocator. */
+// #define TVM_CRT_USE_TLSF_ALLOCATOR
+
 #endif  // TVM_RUNTIME_MICRO_CRT_CONFIG_H_
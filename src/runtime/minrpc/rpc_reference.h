@@ -58,6 +58,22 @@ enum class RPCCode : int {
   kDevCreateStream,
   kDevFreeStream,
   kDevSetStream,
+  // Streamed copy into the remote. It is not a syscall, but is appended here so that the codes
+  // above are unchanged for peers which do not know about it.
+  kCopyToRemoteStream,
+  // Copy into the remote through the content-addressed copy cache of the server.
+  kCopyToRemoteCached,
+  // Copies whose payload is compressed with zstd.
+  kCopyToRemoteCompressed,
+  kCopyFromRemoteCompressed,
+};
+
+/*! \brief The flags of a kCopyToRemoteStream block. */
+enum RPCCopyStreamFlag : uint64_t {
+  /*! \brief The block starts a new stream. */
+  kRPCCopyStreamBegin = 1,
+  /*! \brief The remote replies once the block and all the blocks before it are copied. */
+  kRPCCopyStreamAck = 2,
 };
 
 /*!
@@ -122,6 +138,14 @@ inline const char* RPCCodeToString(RPCCode code) {
       return "kCopyAmongRemote";
     case RPCCode::kDevAllocDataWithScope:
       return "kDevAllocDataWithScope";
+    case RPCCode::kCopyToRemoteStream:
+      return "kCopyToRemoteStream";
+    case RPCCode::kCopyToRemoteCached:
+      return "kCopyToRemoteCached";
+    case RPCCode::kCopyToRemoteCompressed:
+      return "kCopyToRemoteCompressed";
+    case RPCCode::kCopyFromRemoteCompressed:
+      return "kCopyFromRemoteCompressed";
     default:
       return "";
   }
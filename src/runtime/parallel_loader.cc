@@ -0,0 +1,224 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file parallel_loader.cc
+ */
+#include "parallel_loader.h"
+
+#include <dmlc/memory_io.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "file_utils.h"
+
+namespace tvm {
+namespace runtime {
+
+/*! \return The last profile of a ParallelLoader saved by the calling thread. */
+static std::string* LastLoadProfile() {
+  static thread_local std::string profile = "{}";
+  return &profile;
+}
+
+/*! \brief Copy a block of host memory into an array. */
+static void CopyBlockToArray(const NDArray& dst, size_t offset, const char* src, size_t nbytes) {
+  const DLTensor* to = dst.operator->();
+  if (to->device.device_type == kDLCPU) {
+    std::memcpy(static_cast<char*>(to->data) + to->byte_offset + offset, src, nbytes);
+    return;
+  }
+  int64_t shape = static_cast<int64_t>(nbytes);
+  DLDataType bytes_type{kDLUInt, 8, 1};
+  DLTensor from{const_cast<char*>(src), Device{kDLCPU, 0}, 1, bytes_type, &shape, nullptr, 0};
+  DLTensor block{to->data, to->device, 1,
+                 bytes_type, &shape,   nullptr,
+                 to->byte_offset + offset};
+  DeviceAPI::Get(to->device)->CopyDataFromTo(&from, &block, nullptr);
+  // The source may be released once Run returns.
+  DeviceAPI::Get(to->device)->StreamSync(to->device, nullptr);
+}
+
+ParallelLoader::ParallelLoader(int num_threads)
+    : num_threads_(num_threads > 0 ? num_threads : threading::MaxConcurrency()),
+      start_(std::chrono::steady_clock::now()) {}
+
+void ParallelLoader::Add(std::string name, NDArray dst, const void* src,
+                         std::optional<uint64_t> checksum) {
+  ICHECK(dst.IsContiguous()) << "Array " << name << " is not contiguous";
+  size_t nbytes = GetDataSize(*dst.operator->());
+  tasks_.push_back({std::move(name), std::move(dst), static_cast<const char*>(src), nbytes,
+                    checksum});
+}
+
+void ParallelLoader::Run() {
+  auto start = std::chrono::steady_clock::now();
+  // The blocks of all the arrays, as (task index, block index) pairs.
+  std::vector<std::pair<size_t, size_t>> blocks;
+  std::vector<std::vector<uint64_t>> block_hashes(tasks_.size());
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    size_t num_blocks =
+        (tasks_[i].nbytes + kTVMParamChecksumBlockBytes - 1) / kTVMParamChecksumBlockBytes;
+    block_hashes[i].resize(num_blocks);
+    for (size_t j = 0; j < num_blocks; ++j) {
+      blocks.emplace_back(i, j);
+    }
+  }
+
+  std::atomic<size_t> next_block{0};
+  std::mutex mutex;
+  std::exception_ptr error;
+  double verify_sec = 0, copy_sec = 0;
+  auto fworker = [this, &blocks, &block_hashes, &next_block, &mutex, &error, &verify_sec,
+                  &copy_sec]() {
+    std::chrono::duration<double> verify_time(0), copy_time(0);
+    for (size_t i = next_block++; i < blocks.size(); i = next_block++) {
+      const Task& task = tasks_[blocks[i].first];
+      size_t offset = blocks[i].second * kTVMParamChecksumBlockBytes;
+      size_t nbytes = std::min(kTVMParamChecksumBlockBytes, task.nbytes - offset);
+      try {
+        auto t0 = std::chrono::steady_clock::now();
+        if (task.checksum.has_value()) {
+          block_hashes[blocks[i].first][blocks[i].second] =
+              ParamChecksumBlock(task.src + offset, nbytes);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        CopyBlockToArray(task.dst, offset, task.src + offset, nbytes);
+        auto t2 = std::chrono::steady_clock::now();
+        verify_time += t1 - t0;
+        copy_time += t2 - t1;
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) error = std::current_exception();
+        // Stop the other threads.
+        next_block = blocks.size();
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    verify_sec += verify_time.count();
+    copy_sec += copy_time.count();
+  };
+
+  int num_workers = static_cast<int>(std::min<size_t>(num_threads_, blocks.size()));
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_workers; ++i) {
+    threads.emplace_back(fworker);
+  }
+  fworker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  std::vector<Task> tasks = std::move(tasks_);
+  tasks_.clear();
+  if (error) std::rethrow_exception(error);
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    if (tasks[i].checksum.has_value()) {
+      CHECK_EQ(ParamChecksumCombine(block_hashes[i]), tasks[i].checksum.value())
+          << "Checksum mismatch of array " << tasks[i].name << ", the file is corrupted";
+    }
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  this->AddPhaseTime("verify", verify_sec);
+  this->AddPhaseTime("copy", copy_sec);
+  this->AddPhaseTime("run", elapsed.count());
+}
+
+void ParallelLoader::AddPhaseTime(const std::string& phase, double seconds) {
+  phase_sec_[phase] += seconds;
+}
+
+std::string ParallelLoader::GetProfileJSON() const {
+  std::chrono::duration<double> total = std::chrono::steady_clock::now() - start_;
+  std::ostringstream os;
+  os << "{";
+  for (const auto& kv : phase_sec_) {
+    os << "\"" << kv.first << "\": " << kv.second << ", ";
+  }
+  os << "\"num_threads\": " << num_threads_ << ", \"total\": " << total.count() << "}";
+  return os.str();
+}
+
+void ParallelLoader::SaveProfile() const { *LastLoadProfile() = GetProfileJSON(); }
+
+Map<String, NDArray> LoadParamsParallel(const std::string& file_name, int num_threads) {
+  ParallelLoader loader(num_threads);
+  std::unique_ptr<MappedFile> file;
+  {
+    LoadPhaseTimer timer(&loader, "map");
+    file = std::make_unique<MappedFile>(file_name);
+    file->Prefetch(0, file->size());
+  }
+  uint64_t header = 0;
+  if (file->size() >= sizeof(header)) {
+    std::memcpy(&header, file->data(), sizeof(header));
+  }
+  Map<String, NDArray> params;
+  // The magic only matches on little-endian hosts, which use the data as is.
+  if (header != kTVMAlignedNDArrayListMagic) {
+    LoadPhaseTimer timer(&loader, "copy");
+    dmlc::MemoryFixedSizeStream strm(file->data(), file->size());
+    params = LoadParams(&strm);
+  } else {
+    bool has_checksum;
+    std::vector<AlignedParamEntry> entries;
+    {
+      LoadPhaseTimer timer(&loader, "parse");
+      entries = LoadAlignedParamIndex(file->data(), file->size(), &has_checksum);
+    }
+    {
+      LoadPhaseTimer timer(&loader, "allocate");
+      for (const auto& e : entries) {
+        NDArray array = NDArray::Empty(e.shape, e.dtype, Device{kDLCPU, 0});
+        ICHECK_EQ(GetDataSize(*array.operator->()), e.nbytes) << "Invalid parameters file format";
+        std::optional<uint64_t> checksum;
+        if (has_checksum) checksum = e.checksum;
+        loader.Add(e.name, array, file->data() + e.offset, checksum);
+        params.Set(e.name, array);
+      }
+    }
+    loader.Run();
+  }
+  loader.SaveProfile();
+  return params;
+}
+
+TVM_REGISTER_GLOBAL("runtime.LoadParamsParallel")
+    .set_body_typed([](const String& file_name, int num_threads) {
+      return LoadParamsParallel(file_name, num_threads);
+    });
+
+TVM_REGISTER_GLOBAL("runtime.GetLoadProfile").set_body_typed([]() {
+  return *LastLoadProfile();
+});
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file parallel_loader.h
+ * \brief Copy the arrays of a model out of memory with a pool of threads.
+ */
+#ifndef TVM_RUNTIME_PARALLEL_LOADER_H_
+#define TVM_RUNTIME_PARALLEL_LOADER_H_
+
+#include <tvm/runtime/container/map.h>
+#include <tvm/runtime/ndarray.h>
+
+#include <chrono>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Copies arrays out of host memory, e.g. a mapped file, with a pool of threads.
+ *
+ *  The data of each array is split in blocks of kTVMParamChecksumBlockBytes. The threads take
+ *  the blocks one at a time, hash them to verify the checksum of the array if it has one, and
+ *  copy them into the array, which may be on any device.
+ *
+ *  The time spent in each phase is recorded, together with the phases of the caller such as
+ *  mapping and parsing the file, see LoadPhaseTimer.
+ */
+class ParallelLoader {
+ public:
+  /*!
+   * \brief Create a loader.
+   * \param num_threads The number of threads, 0 for the number of cores.
+   */
+  explicit ParallelLoader(int num_threads = 0);
+
+  /*!
+   * \brief Add an array to copy.
+   * \param name The name of the array, used in error messages.
+   * \param dst The contiguous array to copy into.
+   * \param src The data in host byte order, which must stay valid until Run returns.
+   * \param checksum The ParamChecksum of the data to verify, if any.
+   */
+  void Add(std::string name, NDArray dst, const void* src,
+           std::optional<uint64_t> checksum = std::nullopt);
+
+  /*! \brief Copy the arrays added since the last call, and verify their checksums. */
+  void Run();
+
+  /*!
+   * \brief Add to the time spent in a phase.
+   * \param phase The name of the phase.
+   * \param seconds The time in seconds.
+   */
+  void AddPhaseTime(const std::string& phase, double seconds);
+
+  /*!
+   * \brief Get the time spent in each phase.
+   * \return A JSON object of the seconds spent in each phase. The "verify" and "copy" phases are
+   *  summed over the threads, "run" is the wall time of Run and "total" is the wall time since
+   *  the loader was created.
+   */
+  std::string GetProfileJSON() const;
+
+  /*! \brief Keep the profile as the last one of the calling thread, see runtime.GetLoadProfile. */
+  void SaveProfile() const;
+
+ private:
+  /*! \brief An array to copy. */
+  struct Task {
+    std::string name;
+    NDArray dst;
+    const char* src;
+    size_t nbytes;
+    std::optional<uint64_t> checksum;
+  };
+  /*! \brief The number of threads. */
+  int num_threads_;
+  /*! \brief The arrays to copy in the next Run. */
+  std::vector<Task> tasks_;
+  /*! \brief The seconds spent in each phase. */
+  std::map<std::string, double> phase_sec_;
+  /*! \brief The time the loader was created. */
+  std::chrono::steady_clock::time_point start_;
+};
+
+/*! \brief Adds the wall time of its scope to a phase of a ParallelLoader. */
+class LoadPhaseTimer {
+ public:
+  /*!
+   * \brief Start timing.
+   * \param loader The loader.
+   * \param phase The name of the phase.
+   */
+  LoadPhaseTimer(ParallelLoader* loader, std::string phase)
+      : loader_(loader), phase_(std::move(phase)), start_(std::chrono::steady_clock::now()) {}
+  ~LoadPhaseTimer() {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+    loader_->AddPhaseTime(phase_, elapsed.count());
+  }
+
+ private:
+  ParallelLoader* loader_;
+  std::string phase_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/*!
+ * \brief Load parameters from a file saved by SaveParams or SaveParamsToFile into CPU arrays.
+ *
+ *  The file is mapped and prefetched, and the arrays of the aligned format are copied out of it
+ *  and their checksums verified with a ParallelLoader. Files in the format of SaveParams are
+ *  deserialized on the calling thread.
+ * \param file_name The name of the file.
+ * \param num_threads The number of threads, 0 for the number of cores.
+ * \return Map of parameter name to parameter value.
+ */
+Map<String, NDArray> LoadParamsParallel(const std::string& file_name, int num_threads = 0);
+
+}  // namespace runtime
+}  // namespace tvm
+#endif  // TVM_RUNTIME_PARALLEL_LOADER_H_
@@ -30,6 +30,7 @@
 #include <sstream>
 
 #include "../file_utils.h"
+#include "../parallel_loader.h"
 
 namespace tvm {
 namespace runtime {
@@ -243,24 +244,35 @@ void Executable::SaveToFile(const std::string& file_name, const std::string& for
 Module Executable::LoadFromBinary(void* stream) {
   std::string code;
   static_cast<dmlc::Stream*>(stream)->Read(&code);
-  dmlc::MemoryStringStream strm(&code);
+  return Executable::LoadFromMemory(&code[0], code.size());
+}
+
+Module Executable::LoadFromMemory(char* data, size_t size) {
+  ParallelLoader loader;
+  dmlc::MemoryFixedSizeStream strm(data, size);
 
   ObjectPtr<Executable> exec = make_object<Executable>();
 
-  // Load header.
-  LoadHeader(&strm);
+  {
+    LoadPhaseTimer timer(&loader, "parse");
 
-  // Global section.
-  exec->LoadGlobalSection(&strm);
+    // Load header.
+    LoadHeader(&strm);
 
-  // Constant section.
-  exec->LoadConstantSection(&strm);
+    // Global section.
+    exec->LoadGlobalSection(&strm);
 
-  // Packedfunc names section.
-  exec->LoadPackedFuncNames(&strm);
+    // Constant section, whose arrays are copied in parallel below.
+    exec->LoadConstantSection(&strm, data, size, &loader);
 
-  // Code section.
-  exec->LoadCodeSection(&strm);
+    // Packedfunc names section.
+    exec->LoadPackedFuncNames(&strm);
+
+    // Code section.
+    exec->LoadCodeSection(&strm);
+  }
+  loader.Run();
+  loader.SaveProfile();
 
   return Module(exec);
 }
@@ -269,11 +281,14 @@ TVM_REGISTER_GLOBAL("runtime.module.loadbinary_relax.Executable")
     .set_body_typed(Executable::LoadFromBinary);
 
 Module Executable::LoadFromFile(const std::string& file_name) {
-  std::string data;
-  runtime::LoadBinaryFromFile(file_name, &data);
-  dmlc::MemoryStringStream reader(&data);
-  dmlc::Stream* strm = &reader;
-  return Executable::LoadFromBinary(reinterpret_cast<void*>(strm));
+  // The file holds the code as written by SaveToBinary, a string which is used in place.
+  MappedFile file(file_name);
+  file.Prefetch(0, file.size());
+  dmlc::MemoryFixedSizeStream strm(file.data(), file.size());
+  uint64_t size;
+  STREAM_CHECK(strm.Read(&size), "header");
+  STREAM_CHECK(size <= file.size() - sizeof(size), "header");
+  return Executable::LoadFromMemory(file.data() + sizeof(size), static_cast<size_t>(size));
 }
 
 TVM_REGISTER_GLOBAL("runtime.module.loadfile_relax.Executable")
@@ -359,7 +374,47 @@ void Executable::LoadGlobalSection(dmlc::Stream* strm) {
   }
 }
 
-void Executable::LoadConstantSection(dmlc::Stream* strm) {
+/*!
+ * \brief Read the header of an NDArray saved by SaveDLTensor and add its data to a loader
+ *  instead of copying it.
+ * \param strm The stream over the memory at base.
+ * \param base The memory the stream reads, which must stay valid until the loader runs.
+ * \param nbytes The size of the memory at base.
+ * \param loader The loader.
+ * \return The array, which holds its data once the loader runs.
+ */
+NDArray LoadNDArrayDeferred(dmlc::SeekStream* strm, const char* base, size_t nbytes,
+                            ParallelLoader* loader) {
+  uint64_t header, reserved;
+  STREAM_CHECK(strm->Read(&header), "constant");
+  STREAM_CHECK(strm->Read(&reserved), "constant");
+  STREAM_CHECK(header == kTVMNDArrayMagic, "constant");
+  Device dev;
+  int ndim;
+  DLDataType dtype;
+  STREAM_CHECK(strm->Read(&dev), "constant");
+  STREAM_CHECK(strm->Read(&ndim), "constant");
+  STREAM_CHECK(strm->Read(&dtype), "constant");
+  STREAM_CHECK(dev.device_type == kDLCPU && ndim >= 0, "constant");
+  std::vector<int64_t> shape(ndim);
+  if (ndim != 0) {
+    STREAM_CHECK(strm->ReadArray(&shape[0], ndim), "constant");
+  }
+  NDArray ret = NDArray::Empty(ShapeTuple(shape), dtype, dev);
+  int64_t data_byte_size;
+  STREAM_CHECK(strm->Read(&data_byte_size), "constant");
+  STREAM_CHECK(static_cast<size_t>(data_byte_size) == GetDataSize(*ret.operator->()), "constant");
+  // The stream does not clamp seeks, so the data is checked to lie within the memory.
+  size_t offset = strm->Tell();
+  STREAM_CHECK(offset <= nbytes && static_cast<size_t>(data_byte_size) <= nbytes - offset,
+               "constant");
+  strm->Seek(offset + data_byte_size);
+  loader->Add("constant", ret, base + offset);
+  return ret;
+}
+
+void Executable::LoadConstantSection(dmlc::SeekStream* strm, const char* base, size_t nbytes,
+                                     ParallelLoader* loader) {
   uint64_t sz;
   // Load the number of constants.
   STREAM_CHECK(strm->Read(&sz, sizeof(sz)), "constant");
@@ -372,7 +427,12 @@ void Executable::LoadConstantSection(dmlc::Stream* strm) {
     int constant_type;
     STREAM_CHECK(strm->Read(&constant_type, sizeof(constant_type)), "constant");
     if (constant_type == ConstantType::kNDArray) {
-      ndarray.Load(strm);
+      // The data of the arrays is used as is on little-endian hosts only.
+      if (DMLC_IO_NO_ENDIAN_SWAP) {
+        ndarray = LoadNDArrayDeferred(strm, base, nbytes, loader);
+      } else {
+        ndarray.Load(strm);
+      }
       TVMRetValue cell;
       cell = ndarray;
       this->constants.push_back(cell);
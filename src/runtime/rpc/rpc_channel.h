@@ -31,6 +31,14 @@
 namespace tvm {
 namespace runtime {
 
+/*! \brief A buffer in a vectored send, see RPCChannel::SendV. */
+struct RPCIOVec {
+  /*! \brief The data pointer. */
+  const void* data;
+  /*! \brief The size of the data. */
+  size_t size;
+};
+
 /*!
  * \brief Abstract channel interface used to create RPCEndpoint.
  */
@@ -53,6 +61,25 @@ class RPCChannel {
    * \return The actual bytes received.
    */
   virtual size_t Recv(void* data, size_t size) = 0;
+  /*!
+   * \brief Send a sequence of buffers over to the channel, in order.
+   *
+   *  The default implementation sends the buffers one by one, channels
+   *  backed by a file descriptor override it with a single writev.
+   *
+   * \param iov The buffers.
+   * \param iovcnt The number of buffers.
+   * \return The actual bytes sent.
+   */
+  virtual size_t SendV(const RPCIOVec* iov, int iovcnt) {
+    size_t nsend = 0;
+    for (int i = 0; i < iovcnt; ++i) {
+      size_t n = Send(iov[i].data, iov[i].size);
+      nsend += n;
+      if (n != iov[i].size) break;
+    }
+    return nsend;
+  }
 };
 
 /*!
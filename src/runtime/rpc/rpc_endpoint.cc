@@ -28,24 +28,138 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
+#if TVM_RPC_USE_ZSTD
+#include <zstd.h>
+#include <zstd_errors.h>
+#endif
 
 #include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
 #include <memory>
+#include <random>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "../../support/arena.h"
 #include "../../support/ring_buffer.h"
+#include "../../support/sha256.h"
 #include "../object_internal.h"
 #include "rpc_local_session.h"
 
 namespace tvm {
 namespace runtime {
 
+bool IsRPCCopyCacheKey(const std::string& key) {
+  // 64 hex digits, '-' and at most the 20 decimal digits of a uint64_t.
+  constexpr size_t kHashDigits = 64;
+  if (key.size() < kHashDigits + 2 || key.size() > kHashDigits + 21 || key[kHashDigits] != '-') {
+    return false;
+  }
+  for (size_t i = 0; i < key.size(); ++i) {
+    char c = key[i];
+    bool is_digit = c >= '0' && c <= '9';
+    if (i < kHashDigits ? !(is_digit || (c >= 'a' && c <= 'f')) : i > kHashDigits && !is_digit) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string RPCCopyCacheKey(const void* data, uint64_t nbytes) {
+  return support::SHA256Digest(data, nbytes) + "-" + std::to_string(nbytes);
+}
+
+/*!
+ * \brief Get the path of an entry in the copy cache of the server.
+ * \param key The content key of the entry, checked by IsRPCCopyCacheKey.
+ * \return The path, or an empty string if the server has no copy cache.
+ */
+static std::string RPCCopyCachePath(const std::string& key) {
+  ICHECK(IsRPCCopyCacheKey(key));
+  const PackedFunc* f = Registry::Get("tvm.rpc.server.copy_cache_dir");
+  if (f == nullptr) return "";
+  std::string cache_dir = (*f)();
+  return cache_dir + "/" + key;
+}
+
+/*! \brief Load the entry of the copy cache at path, return whether it exists. */
+static bool RPCCopyCacheLoad(const std::string& path, char* data, uint64_t nbytes) {
+  std::ifstream fs(path, std::ios::in | std::ios::binary);
+  if (!fs) return false;
+  fs.read(data, nbytes);
+  return static_cast<uint64_t>(fs.gcount()) == nbytes;
+}
+
+/*! \brief Store an entry into the copy cache at path. */
+static void RPCCopyCacheStore(const std::string& path, const char* data, uint64_t nbytes) {
+  // Write to a temporary file first so that a partial entry is never loaded. The name is
+  // unique because the forked servers can store the same entry at the same time.
+  std::ostringstream temp_name;
+  temp_name << path << "." << std::hex << std::random_device()() << std::random_device()()
+            << ".tmp";
+  std::string temp_path = temp_name.str();
+  {
+    std::ofstream fs(temp_path, std::ios::out | std::ios::binary);
+    fs.write(data, nbytes);
+    if (!fs) {
+      LOG(WARNING) << "Failed to write RPC copy cache entry " << temp_path;
+      std::remove(temp_path.c_str());
+      return;
+    }
+  }
+  std::rename(temp_path.c_str(), path.c_str());
+}
+
+/*!
+ * \brief Compress the payload of a copy with zstd.
+ * \param data The payload.
+ * \param nbytes The size of the payload.
+ * \param out Where the compressed payload is written.
+ * \param capacity The size of out.
+ * \param level The zstd compression level.
+ * \return The size of the compressed payload, or 0 if it does not fit in capacity.
+ */
+static uint64_t RPCCompress(const void* data, uint64_t nbytes, void* out, uint64_t capacity,
+                            int level) {
+#if TVM_RPC_USE_ZSTD
+  size_t ret = ZSTD_compress(out, capacity, data, nbytes, level);
+  if (ZSTD_isError(ret)) {
+    ICHECK_EQ(ZSTD_getErrorCode(ret), ZSTD_error_dstSize_tooSmall)
+        << "Failed to compress an RPC copy: " << ZSTD_getErrorName(ret);
+    return 0;
+  }
+  return ret;
+#else
+  return 0;
+#endif
+}
+
+/*!
+ * \brief Decompress the payload of a copy compressed by RPCCompress.
+ * \param compressed The compressed payload.
+ * \param compressed_bytes The size of the compressed payload.
+ * \param out Where the payload is written.
+ * \param nbytes The size of the payload.
+ */
+static void RPCDecompress(const void* compressed, uint64_t compressed_bytes, void* out,
+                          uint64_t nbytes) {
+#if TVM_RPC_USE_ZSTD
+  size_t ret = ZSTD_decompress(out, nbytes, compressed, compressed_bytes);
+  ICHECK(!ZSTD_isError(ret)) << "Failed to decompress an RPC copy: " << ZSTD_getErrorName(ret);
+  ICHECK_EQ(ret, nbytes) << "The decompressed RPC copy has the wrong size";
+#else
+  LOG(FATAL) << "Compressed RPC copies require the runtime to be built with zstd";
+#endif
+}
+
 /*!
  * Event-driven state-machine based handlers for RPCEndpoint.
  *
@@ -93,7 +207,56 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
   }
 
   /*! \return Whether we are ready to handle next request. */
-  bool Ready() const { return reader_->bytes_available() >= pending_request_bytes_; }
+  bool Ready() const {
+    if (state_ == kRecvPayload) {
+      return payload_bytes_ == 0 || reader_->bytes_available() != 0;
+    }
+    return reader_->bytes_available() >= pending_request_bytes_;
+  }
+
+  /*!
+   * \brief Receive the payload of the current packet directly into its destination.
+   * \param frecv A receive function handle.
+   * \tparam FRecv A function with signature size_t (void* data, size_t size);
+   * \return The number of bytes received, 0 if no payload is being received.
+   */
+  template <typename FRecv>
+  size_t RecvPayloadWithCallback(FRecv frecv) {
+    if (state_ != kRecvPayload || payload_bytes_ == 0 || reader_->bytes_available() != 0) {
+      return 0;
+    }
+    size_t n = frecv(payload_ptr_, payload_bytes_);
+    payload_ptr_ += n;
+    payload_bytes_ -= n;
+    return n;
+  }
+
+  /*! \return Whether a payload is waiting for bytes from the channel. */
+  bool PayloadBytesNeeded() const {
+    return state_ == kRecvPayload && payload_bytes_ != 0 && reader_->bytes_available() == 0;
+  }
+
+  /*!
+   * \brief Set where the payload of the next kCopyAck is received directly.
+   * \param data The destination.
+   * \param nbytes The size of the payload.
+   */
+  void SetCopyAckTarget(void* data, uint64_t nbytes) {
+    copy_ack_target_ = static_cast<char*>(data);
+    copy_ack_target_bytes_ = nbytes;
+    copy_ack_landed_ = false;
+  }
+
+  /*!
+   * \brief Clear the target of the kCopyAck payload.
+   * \return Whether the payload was received into the target.
+   */
+  bool ResetCopyAckTarget() {
+    bool landed = copy_ack_landed_;
+    copy_ack_target_ = nullptr;
+    copy_ack_landed_ = false;
+    return landed;
+  }
 
   /*! \return Whether we can perform a clean shutdown */
   bool CanCleanShutdown() const { return state_ == kRecvPacketNumBytes; }
@@ -123,7 +286,14 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
         case kRecvPacketNumBytes: {
           uint64_t packet_nbytes;
           ICHECK(this->Read(&packet_nbytes));
-          if (packet_nbytes != 0) {
+          if (packet_nbytes >= kRPCZeroCopyMinBytes && !async_server_mode_ &&
+              DMLC_IO_NO_ENDIAN_SWAP) {
+            // Large packets may carry a payload which can bypass the reader,
+            // look at the header first.
+            packet_nbytes_ = packet_nbytes;
+            this->SwitchToState(kRecvPacketHeader);
+            this->RequestBytes(kPacketHeaderPeekBytes);
+          } else if (packet_nbytes != 0) {
             this->SwitchToState(kProcessPacket);
             this->RequestBytes(packet_nbytes);
           } else {
@@ -131,6 +301,24 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
           }
           break;
         }
+        case kRecvPacketHeader: {
+          this->HandlePacketHeader();
+          break;
+        }
+        case kRecvPayload: {
+          size_t n = std::min(payload_bytes_, reader_->bytes_available());
+          if (n != 0) {
+            reader_->Read(payload_ptr_, n);
+            payload_ptr_ += n;
+            payload_bytes_ -= n;
+          }
+          if (payload_bytes_ == 0) {
+            auto payload_done = std::move(payload_done_);
+            payload_done_ = nullptr;
+            payload_done();
+          }
+          break;
+        }
         case kProcessPacket: {
           this->HandleProcessPacket(setreturn);
           break;
@@ -232,6 +420,8 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
   enum State {
     kInitHeader,
     kRecvPacketNumBytes,
+    kRecvPacketHeader,
+    kRecvPayload,
     kProcessPacket,
     kWaitForAsyncCallback,
     kReturnReceived,
@@ -248,6 +438,20 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
   bool async_server_mode_{false};
   // Internal arena
   support::Arena arena_;
+  // The number of header bytes looked at before deciding how to receive a large packet.
+  static constexpr size_t kPacketHeaderPeekBytes = 256;
+  // The size of the large packet being received.
+  uint64_t packet_nbytes_{0};
+  // The destination of the payload being received directly, and its remaining size.
+  char* payload_ptr_{nullptr};
+  size_t payload_bytes_{0};
+  // Called once the whole payload is received.
+  std::function<void()> payload_done_;
+  // The destination of the payload of the next kCopyAck.
+  char* copy_ack_target_{nullptr};
+  uint64_t copy_ack_target_bytes_{0};
+  // Whether the payload of the kCopyAck was received into copy_ack_target_.
+  bool copy_ack_landed_{false};
 
   // State switcher
   void SwitchToState(State state) {
@@ -285,6 +489,75 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
     }
   }
 
+  // Handler for the header of a large packet.
+  void HandlePacketHeader() {
+    // The fixed leading fields of a copy packet: code, data handle, device and ndim.
+    constexpr size_t kNDimOffset = sizeof(int32_t) + sizeof(uint64_t) + sizeof(DLDevice);
+    char head[kNDimOffset + sizeof(int32_t)];
+    reader_->Peek(head, sizeof(head));
+    int32_t cdata;
+    std::memcpy(&cdata, head, sizeof(cdata));
+    RPCCode code = static_cast<RPCCode>(cdata);
+
+    bool is_stream = code == RPCCode::kCopyToRemoteStream;
+    if ((code == RPCCode::kCopyToRemote || is_stream) && !client_mode_) {
+      DLTensor header;
+      header.data = nullptr;
+      std::memcpy(&header.ndim, head + kNDimOffset, sizeof(header.ndim));
+      uint64_t header_bytes = RemoteCopyCalculatePacketOverheadSize(&header, code, 0) +
+                              (is_stream ? sizeof(uint64_t) : 0);
+      if (header.ndim >= 0 && header_bytes <= kPacketHeaderPeekBytes) {
+        this->Read(&code);
+        DLTensor* arr = RPCReference::ReceiveDLTensor(this);
+        uint64_t data_bytes;
+        this->Read(&data_bytes);
+        uint64_t flags = 0;
+        if (is_stream) {
+          this->Read(&flags);
+        }
+        ICHECK_EQ(header_bytes + data_bytes, packet_nbytes_);
+        char* dptr = this->CopyToRemoteDest(arr, data_bytes);
+        auto fdone = [this, is_stream, arr, dptr, data_bytes, flags]() {
+          if (is_stream) {
+            this->FinishCopyToRemoteStream(arr, dptr, data_bytes, flags);
+          } else {
+            this->FinishCopyToRemote(arr, dptr, data_bytes);
+          }
+        };
+        this->BeginRecvPayload(dptr, data_bytes, fdone);
+        return;
+      }
+    } else if (code == RPCCode::kCopyAck && client_mode_ && copy_ack_target_ != nullptr) {
+      this->Read(&code);
+      ICHECK_EQ(packet_nbytes_ - sizeof(cdata), copy_ack_target_bytes_);
+      copy_ack_landed_ = true;
+      this->BeginRecvPayload(copy_ack_target_, copy_ack_target_bytes_,
+                             [this]() { this->SwitchToState(kCopyAckReceived); });
+      return;
+    }
+    // Receive the rest of the packet through the reader. The header bytes looked at are still
+    // pending, so the state is switched without the invariant check of SwitchToState.
+    state_ = kProcessPacket;
+    this->RequestBytes(packet_nbytes_ - kPacketHeaderPeekBytes);
+  }
+
+  /*!
+   * \brief Receive the rest of the current packet into dptr, without passing through the reader.
+   * \param dptr The destination.
+   * \param nbytes The size of the payload.
+   * \param fdone Called once the whole payload is received.
+   */
+  void BeginRecvPayload(char* dptr, uint64_t nbytes, std::function<void()> fdone) {
+    // The bytes of the payload already requested are still in the reader.
+    size_t nbuffered = pending_request_bytes_;
+    pending_request_bytes_ = 0;
+    reader_->Read(dptr, nbuffered);
+    payload_ptr_ = dptr + nbuffered;
+    payload_bytes_ = nbytes - nbuffered;
+    payload_done_ = std::move(fdone);
+    this->SwitchToState(kRecvPayload);
+  }
+
   // Handler for read code.
   void HandleProcessPacket(RPCSession::FEncodeReturn setreturn) {
     RPCCode code = RPCCode::kNone;
@@ -368,6 +641,8 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
    * \param setreturn The function to encode return.
    */
   void HandleReturn(RPCCode code, RPCSession::FEncodeReturn setreturn) {
+    // A return ends the request, the payload of a kCopyAck is no longer expected.
+    copy_ack_target_ = nullptr;
     TVMArgs args = RecvPackedSeq();
     if (code == RPCCode::kException) {
       // switch to the state before sending exception.
@@ -431,28 +706,33 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
     DLTensor* arr = RPCReference::ReceiveDLTensor(this);
     uint64_t data_bytes;
     this->Read(&data_bytes);
-    size_t elem_bytes = (arr->dtype.bits * arr->dtype.lanes + 7) / 8;
-    auto* sess = GetServingSession();
+    char* dptr = this->CopyToRemoteDest(arr, data_bytes);
+    this->ReadArray(dptr, data_bytes);
+    this->FinishCopyToRemote(arr, dptr, data_bytes);
+  }
 
+  /*! \return Where the payload of a copy into arr is received. */
+  char* CopyToRemoteDest(DLTensor* arr, uint64_t data_bytes) {
     // When session is local, we can directly treat handle
     // as the cpu pointer without allocating a temp space.
-    if (arr->device.device_type == kDLCPU && sess->IsLocalSession()) {
-      char* dptr = reinterpret_cast<char*>(arr->data) + arr->byte_offset;
-      this->ReadArray(dptr, data_bytes);
+    if (arr->device.device_type == kDLCPU && GetServingSession()->IsLocalSession()) {
+      return reinterpret_cast<char*>(arr->data) + arr->byte_offset;
+    }
+    return this->ArenaAlloc<char>(data_bytes);
+  }
 
-      if (!DMLC_IO_NO_ENDIAN_SWAP) {
-        dmlc::ByteSwap(dptr, elem_bytes, data_bytes / elem_bytes);
-      }
+  /*! \brief Complete a copy into arr once its payload is received into dptr. */
+  void FinishCopyToRemote(DLTensor* arr, char* dptr, uint64_t data_bytes) {
+    size_t elem_bytes = (arr->dtype.bits * arr->dtype.lanes + 7) / 8;
+    auto* sess = GetServingSession();
+
+    if (!DMLC_IO_NO_ENDIAN_SWAP) {
+      dmlc::ByteSwap(dptr, elem_bytes, data_bytes / elem_bytes);
+    }
+    if (arr->device.device_type == kDLCPU && sess->IsLocalSession()) {
       this->ReturnVoid();
       this->SwitchToState(kRecvPacketNumBytes);
     } else {
-      char* temp_data = this->ArenaAlloc<char>(data_bytes);
-      this->ReadArray(temp_data, data_bytes);
-
-      if (!DMLC_IO_NO_ENDIAN_SWAP) {
-        dmlc::ByteSwap(temp_data, elem_bytes, data_bytes / elem_bytes);
-      }
-
       auto on_copy_complete = [this](RPCCode status, TVMArgs args) {
         if (status == RPCCode::kException) {
           this->ReturnException(args.values[0].v_str);
@@ -463,11 +743,195 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
         }
       };
 
+      this->SwitchToState(kWaitForAsyncCallback);
+      sess->AsyncCopyToRemote(static_cast<void*>(dptr), arr, data_bytes, on_copy_complete);
+    }
+  }
+
+  void HandleCopyToRemoteStream() {
+    DLTensor* arr = RPCReference::ReceiveDLTensor(this);
+    uint64_t data_bytes;
+    this->Read(&data_bytes);
+    uint64_t flags;
+    this->Read(&flags);
+    char* dptr = this->CopyToRemoteDest(arr, data_bytes);
+    this->ReadArray(dptr, data_bytes);
+    this->FinishCopyToRemoteStream(arr, dptr, data_bytes, flags);
+  }
+
+  /*! \brief Complete a block of a streamed copy into arr once it is received into dptr. */
+  void FinishCopyToRemoteStream(DLTensor* arr, char* dptr, uint64_t data_bytes, uint64_t flags) {
+    size_t elem_bytes = (arr->dtype.bits * arr->dtype.lanes + 7) / 8;
+    auto* sess = GetServingSession();
+
+    if (flags & kRPCCopyStreamBegin) {
+      copy_stream_error_.clear();
+    }
+    // Only the blocks which request an acknowledgement are replied to. The reply covers all the
+    // blocks of the stream so far, and carries the first error among them if any.
+    auto on_copy_complete = [this, flags](RPCCode status, TVMArgs args) {
+      if (status == RPCCode::kException && copy_stream_error_.empty()) {
+        copy_stream_error_ = args.values[0].v_str;
+      }
+      if (flags & kRPCCopyStreamAck) {
+        if (copy_stream_error_.empty()) {
+          this->ReturnVoid();
+        } else {
+          this->ReturnException(copy_stream_error_.c_str());
+          copy_stream_error_.clear();
+        }
+      }
+      this->SwitchToState(kRecvPacketNumBytes);
+    };
+
+    if (!DMLC_IO_NO_ENDIAN_SWAP) {
+      dmlc::ByteSwap(dptr, elem_bytes, data_bytes / elem_bytes);
+    }
+    if (arr->device.device_type == kDLCPU && sess->IsLocalSession()) {
+      on_copy_complete(RPCCode::kReturn, TVMArgs(nullptr, nullptr, 0));
+    } else {
+      this->SwitchToState(kWaitForAsyncCallback);
+      sess->AsyncCopyToRemote(static_cast<void*>(dptr), arr, data_bytes, on_copy_complete);
+    }
+  }
+
+  void HandleCopyToRemoteCached() {
+    DLTensor* arr = RPCReference::ReceiveDLTensor(this);
+    uint64_t data_bytes;
+    this->Read(&data_bytes);
+    uint64_t key_len;
+    this->Read(&key_len);
+    std::string key(key_len, '\0');
+    this->ReadArray(dmlc::BeginPtr(key), key_len);
+    uint64_t with_data;
+    this->Read(&with_data);
+    size_t elem_bytes = (arr->dtype.bits * arr->dtype.lanes + 7) / 8;
+    auto* sess = GetServingSession();
+
+    // The cache keeps the bytes in the byte order of the wire.
+    char* temp_data = this->ArenaAlloc<char>(data_bytes);
+    if (with_data) {
+      this->ReadArray(temp_data, data_bytes);
+    }
+    // The key names a file of the server, so only the keys made by the client are accepted.
+    if (!IsRPCCopyCacheKey(key)) {
+      this->ReturnException("Invalid RPC copy cache key");
+      this->SwitchToState(kRecvPacketNumBytes);
+      return;
+    }
+    // The bytes must match their key, or a later copy would load what another client sent.
+    if (with_data && RPCCopyCacheKey(temp_data, data_bytes) != key) {
+      this->ReturnException("RPC copy cache key does not match the data");
+      this->SwitchToState(kRecvPacketNumBytes);
+      return;
+    }
+    std::string path = RPCCopyCachePath(key);
+    bool found = true;
+    if (with_data) {
+      if (!path.empty()) {
+        RPCCopyCacheStore(path, temp_data, data_bytes);
+      }
+    } else {
+      found = !path.empty() && RPCCopyCacheLoad(path, temp_data, data_bytes);
+    }
+
+    // Return whether the copy is done, which is false when the entry is not in the cache.
+    auto f_return = [this](bool done) {
+      TVMValue ret_value;
+      ret_value.v_int64 = done;
+      int ret_tcode = kDLInt;
+      this->ReturnPackedSeq(TVMArgs(&ret_value, &ret_tcode, 1));
+    };
+    if (!found) {
+      f_return(false);
+      this->SwitchToState(kRecvPacketNumBytes);
+      return;
+    }
+    if (!DMLC_IO_NO_ENDIAN_SWAP) {
+      dmlc::ByteSwap(temp_data, elem_bytes, data_bytes / elem_bytes);
+    }
+
+    if (arr->device.device_type == kDLCPU && sess->IsLocalSession()) {
+      char* dptr = reinterpret_cast<char*>(arr->data) + arr->byte_offset;
+      std::memcpy(dptr, temp_data, data_bytes);
+      f_return(true);
+      this->SwitchToState(kRecvPacketNumBytes);
+    } else {
+      auto on_copy_complete = [this, f_return](RPCCode status, TVMArgs args) {
+        if (status == RPCCode::kException) {
+          this->ReturnException(args.values[0].v_str);
+        } else {
+          f_return(true);
+        }
+        this->SwitchToState(kRecvPacketNumBytes);
+      };
+
       this->SwitchToState(kWaitForAsyncCallback);
       sess->AsyncCopyToRemote(static_cast<void*>(temp_data), arr, data_bytes, on_copy_complete);
     }
   }
 
+  void HandleCopyToRemoteCompressed() {
+    DLTensor* arr = RPCReference::ReceiveDLTensor(this);
+    uint64_t data_bytes;
+    this->Read(&data_bytes);
+    uint64_t compressed_bytes;
+    this->Read(&compressed_bytes);
+    char* compressed = this->ArenaAlloc<char>(compressed_bytes);
+    this->ReadArray(compressed, compressed_bytes);
+    char* dptr = this->CopyToRemoteDest(arr, data_bytes);
+    RPCDecompress(compressed, compressed_bytes, dptr, data_bytes);
+    this->FinishCopyToRemote(arr, dptr, data_bytes);
+  }
+
+  void HandleCopyFromRemoteCompressed() {
+    DLTensor* arr = RPCReference::ReceiveDLTensor(this);
+    uint64_t data_bytes;
+    this->Read(&data_bytes);
+    int64_t level;
+    this->Read(&level);
+    size_t elem_bytes = (arr->dtype.bits * arr->dtype.lanes + 7) / 8;
+    auto* sess = GetServingSession();
+    // Return whether the payload is compressed, and the payload, which is sent as is when it
+    // does not get smaller.
+    auto f_return = [this, level](char* dptr, uint64_t num_bytes) {
+      char* compressed = this->ArenaAlloc<char>(num_bytes);
+      uint64_t compressed_bytes =
+          RPCCompress(dptr, num_bytes, compressed, num_bytes, static_cast<int>(level));
+      TVMByteArray payload;
+      payload.data = compressed_bytes != 0 ? compressed : dptr;
+      payload.size = compressed_bytes != 0 ? compressed_bytes : num_bytes;
+      TVMValue ret_values[2];
+      int ret_tcodes[2] = {kDLInt, kTVMBytes};
+      ret_values[0].v_int64 = compressed_bytes != 0;
+      ret_values[1].v_handle = &payload;
+      this->ReturnPackedSeq(TVMArgs(ret_values, ret_tcodes, 2));
+      this->SwitchToState(kRecvPacketNumBytes);
+    };
+
+    if (arr->device.device_type == kDLCPU && sess->IsLocalSession() && DMLC_IO_NO_ENDIAN_SWAP) {
+      f_return(reinterpret_cast<char*>(arr->data) + arr->byte_offset, data_bytes);
+    } else {
+      char* temp_data = this->ArenaAlloc<char>(data_bytes);
+      auto on_copy_complete = [this, elem_bytes, data_bytes, temp_data, f_return](RPCCode status,
+                                                                                  TVMArgs args) {
+        if (status == RPCCode::kException) {
+          this->ReturnException(args.values[0].v_str);
+          this->SwitchToState(kRecvPacketNumBytes);
+        } else {
+          // endian aware handling
+          if (!DMLC_IO_NO_ENDIAN_SWAP) {
+            dmlc::ByteSwap(temp_data, elem_bytes, data_bytes / elem_bytes);
+          }
+          f_return(temp_data, data_bytes);
+        }
+      };
+
+      this->SwitchToState(kWaitForAsyncCallback);
+      sess->AsyncCopyFromRemote(arr, static_cast<void*>(temp_data), data_bytes, on_copy_complete);
+    }
+  }
+
   // Handle for packed call.
   void HandleNormalCallFunc() {
     uint64_t call_handle;
@@ -619,6 +1083,8 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
   std::string* remote_key_;
   // function to flush the writer.
   std::function<void()> flush_writer_;
+  // The first error of the current kCopyToRemoteStream stream not reported yet.
+  std::string copy_stream_error_;
 };
 
 RPCCode RPCEndpoint::HandleUntilReturnEvent(bool client_mode, RPCSession::FEncodeReturn setreturn) {
@@ -628,7 +1094,7 @@ RPCCode RPCEndpoint::HandleUntilReturnEvent(bool client_mode, RPCSession::FEncod
                   << " to be active, but the connection was previously closed";
   while (code != RPCCode::kReturn && code != RPCCode::kShutdown && code != RPCCode::kCopyAck) {
     while (writer_.bytes_available() != 0) {
-      writer_.ReadWithCallback(
+      bytes_sent_ += writer_.ReadWithCallback(
           [this](const void* data, size_t size) { return channel_->Send(data, size); },
           writer_.bytes_available());
     }
@@ -636,6 +1102,7 @@ RPCCode RPCEndpoint::HandleUntilReturnEvent(bool client_mode, RPCSession::FEncod
     if (bytes_needed != 0) {
       size_t n = reader_.WriteWithCallback(
           [this](void* data, size_t size) { return channel_->Recv(data, size); }, bytes_needed);
+      bytes_received_ += n;
       if (n == 0) {
         if (handler_->CanCleanShutdown()) {
           return RPCCode::kShutdown;
@@ -643,12 +1110,39 @@ RPCCode RPCEndpoint::HandleUntilReturnEvent(bool client_mode, RPCSession::FEncod
           LOG(FATAL) << "Channel closes before we get needed bytes";
         }
       }
+    } else if (handler_->PayloadBytesNeeded()) {
+      size_t n = handler_->RecvPayloadWithCallback(
+          [this](void* data, size_t size) { return channel_->Recv(data, size); });
+      bytes_received_ += n;
+      if (n == 0) {
+        LOG(FATAL) << "Channel closes before we get needed bytes";
+      }
     }
     code = handler_->HandleNextEvent(client_mode, false, setreturn);
   }
   return code;
 }
 
+void RPCEndpoint::FlushWriterWithPayload(const void* payload, uint64_t nbytes) {
+  // The packet header is small, move it out of the ring buffer.
+  std::vector<char> header(writer_.bytes_available());
+  writer_.Read(header.data(), header.size());
+  RPCIOVec iov[2] = {{header.data(), header.size()}, {payload, nbytes}};
+  int begin = 0;
+  while (begin < 2) {
+    size_t n = channel_->SendV(iov + begin, 2 - begin);
+    bytes_sent_ += n;
+    while (begin < 2 && n >= iov[begin].size) {
+      n -= iov[begin].size;
+      ++begin;
+    }
+    if (begin < 2) {
+      iov[begin].data = static_cast<const char*>(iov[begin].data) + n;
+      iov[begin].size -= n;
+    }
+  }
+}
+
 void RPCEndpoint::Init() {
   // callback to flush the writer.
   auto flush_writer = [this]() {
@@ -656,6 +1150,7 @@ void RPCEndpoint::Init() {
       size_t n = writer_.ReadWithCallback(
           [this](const void* data, size_t size) { return channel_->Send(data, size); },
           writer_.bytes_available());
+      bytes_sent_ += n;
       if (n == 0) break;
     }
   };
@@ -820,7 +1315,11 @@ void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes)
   handler_->Write(code);
   RPCReference::SendDLTensor(handler_, to);
   handler_->Write(nbytes);
-  handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+  if (nbytes >= kRPCZeroCopyMinBytes) {
+    FlushWriterWithPayload(from_bytes, nbytes);
+  } else {
+    handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+  }
   ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kReturn);
 }
 
@@ -840,12 +1339,232 @@ void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes
   handler_->Write(code);
   RPCReference::SendDLTensor(handler_, from);
   handler_->Write(nbytes);
+  handler_->SetCopyAckTarget(to_bytes, nbytes);
   ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kCopyAck);
 
-  handler_->ReadArray(reinterpret_cast<char*>(to_bytes), nbytes);
+  if (!handler_->ResetCopyAckTarget()) {
+    handler_->ReadArray(reinterpret_cast<char*>(to_bytes), nbytes);
+  }
   handler_->FinishCopyAck();
 }
 
+void RPCEndpoint::CopyToRemoteStream(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                                     uint64_t block_size, int window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RPCCode code = RPCCode::kCopyToRemoteStream;
+  ICHECK_GT(block_size, 0U);
+  ICHECK_GT(window, 0);
+
+  uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
+  ICHECK_LE(to->byte_offset + nbytes, tensor_total_size_bytes)
+      << "CopyToRemote: overflow in tensor size: (byte_offset=" << to->byte_offset
+      << ", nbytes=" << nbytes << ", tensor_total_size=" << tensor_total_size_bytes << ")";
+
+  const uint64_t base_offset = to->byte_offset;
+  const uint64_t num_blocks = (nbytes + block_size - 1) / block_size;
+  const uint64_t ack_interval = std::max(window / 2, 1);
+  // The number of blocks covered by each acknowledgement that is not received yet.
+  std::deque<uint64_t> pending_acks;
+  uint64_t num_acked_blocks = 0;
+  std::string error;
+
+  auto f_wait_ack = [&]() {
+    ICHECK(!pending_acks.empty());
+    RPCCode ret = RPCCode::kReturn;
+    try {
+      ret = HandleUntilReturnEvent(true, [](TVMArgs) {});
+    } catch (const Error& e) {
+      // Keep receiving the acknowledgements in flight so that the channel stays in sync.
+      if (error.empty()) error = e.what();
+    }
+    ICHECK(ret == RPCCode::kReturn) << "code=" << RPCCodeToString(ret);
+    num_acked_blocks = pending_acks.front();
+    pending_acks.pop_front();
+  };
+
+  for (uint64_t i = 0; i < num_blocks && error.empty(); ++i) {
+    while (i - num_acked_blocks >= static_cast<uint64_t>(window) && error.empty()) {
+      f_wait_ack();
+    }
+    if (!error.empty()) break;
+
+    uint64_t offset = i * block_size;
+    uint64_t size = std::min(block_size, nbytes - offset);
+    uint64_t flags = 0;
+    if (i == 0) flags |= kRPCCopyStreamBegin;
+    if ((i + 1) % ack_interval == 0 || i + 1 == num_blocks) flags |= kRPCCopyStreamAck;
+
+    to->byte_offset = base_offset + offset;
+    uint64_t packet_nbytes =
+        RemoteCopyCalculatePacketOverheadSize(to, code, size) + sizeof(flags) + size;
+    handler_->Write(packet_nbytes);
+    handler_->Write(code);
+    RPCReference::SendDLTensor(handler_, to);
+    handler_->Write(size);
+    handler_->Write(flags);
+    if (size >= kRPCZeroCopyMinBytes) {
+      FlushWriterWithPayload(reinterpret_cast<char*>(from_bytes) + offset, size);
+    } else {
+      handler_->WriteArray(reinterpret_cast<char*>(from_bytes) + offset, size);
+    }
+    if (flags & kRPCCopyStreamAck) {
+      pending_acks.push_back(i + 1);
+    }
+  }
+  while (!pending_acks.empty()) {
+    f_wait_ack();
+  }
+  to->byte_offset = base_offset;
+  if (!error.empty()) {
+    LOG(FATAL) << error;
+  }
+}
+
+void RPCEndpoint::CopyFromRemoteStream(DLTensor* from, void* to_bytes, uint64_t nbytes,
+                                       uint64_t block_size, int window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RPCCode code = RPCCode::kCopyFromRemote;
+  ICHECK_GT(block_size, 0U);
+  ICHECK_GT(window, 0);
+
+  uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*from));
+  ICHECK_LE(from->byte_offset + nbytes, tensor_total_size_bytes)
+      << "CopyFromRemote: overflow in tensor size: (byte_offset=" << from->byte_offset
+      << ", nbytes=" << nbytes << ", tensor_total_size=" << tensor_total_size_bytes << ")";
+
+  const uint64_t base_offset = from->byte_offset;
+  const uint64_t num_blocks = (nbytes + block_size - 1) / block_size;
+  uint64_t num_requested_blocks = 0;
+  std::string error;
+
+  // The server handles the requests in order, so the data of the blocks arrive in order as well.
+  for (uint64_t i = 0; i < num_blocks; ++i) {
+    while (error.empty() && num_requested_blocks < std::min(num_blocks, i + window)) {
+      uint64_t offset = num_requested_blocks * block_size;
+      uint64_t size = std::min(block_size, nbytes - offset);
+      from->byte_offset = base_offset + offset;
+      handler_->Write(RemoteCopyCalculatePacketOverheadSize(from, code, size));
+      handler_->Write(code);
+      RPCReference::SendDLTensor(handler_, from);
+      handler_->Write(size);
+      ++num_requested_blocks;
+    }
+    if (i >= num_requested_blocks) break;
+
+    uint64_t offset = i * block_size;
+    uint64_t size = std::min(block_size, nbytes - offset);
+    try {
+      handler_->SetCopyAckTarget(reinterpret_cast<char*>(to_bytes) + offset, size);
+      RPCCode ret = HandleUntilReturnEvent(true, [](TVMArgs) {});
+      ICHECK(ret == RPCCode::kCopyAck) << "code=" << RPCCodeToString(ret);
+      if (!handler_->ResetCopyAckTarget()) {
+        handler_->ReadArray(reinterpret_cast<char*>(to_bytes) + offset, size);
+      }
+      handler_->FinishCopyAck();
+    } catch (const Error& e) {
+      // Keep receiving the replies of the requests in flight so that the channel stays in sync.
+      if (error.empty()) error = e.what();
+    }
+  }
+  from->byte_offset = base_offset;
+  if (!error.empty()) {
+    LOG(FATAL) << error;
+  }
+}
+
+bool RPCEndpoint::CopyToRemoteCached(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                                     const std::string& key, bool with_data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RPCCode code = RPCCode::kCopyToRemoteCached;
+
+  uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
+  ICHECK_LE(to->byte_offset + nbytes, tensor_total_size_bytes)
+      << "CopyToRemote: overflow in tensor size: (byte_offset=" << to->byte_offset
+      << ", nbytes=" << nbytes << ", tensor_total_size=" << tensor_total_size_bytes << ")";
+
+  uint64_t key_len = key.length();
+  uint64_t with_data_flag = with_data;
+  uint64_t packet_nbytes = RemoteCopyCalculatePacketOverheadSize(to, code, nbytes) +
+                           sizeof(key_len) + key_len + sizeof(with_data_flag) +
+                           (with_data ? nbytes : 0);
+
+  handler_->Write(packet_nbytes);
+  handler_->Write(code);
+  RPCReference::SendDLTensor(handler_, to);
+  handler_->Write(nbytes);
+  handler_->Write(key_len);
+  handler_->WriteArray(key.data(), key_len);
+  handler_->Write(with_data_flag);
+  if (with_data) {
+    handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+  }
+  bool done = false;
+  code = HandleUntilReturnEvent(true, [&done](TVMArgs args) {
+    ICHECK_EQ(args.size(), 1);
+    int64_t ret = args[0];
+    done = ret != 0;
+  });
+  ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+  return done;
+}
+
+void RPCEndpoint::CopyToRemoteCompressed(const void* compressed, uint64_t compressed_bytes,
+                                         DLTensor* to, uint64_t nbytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RPCCode code = RPCCode::kCopyToRemoteCompressed;
+
+  uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
+  ICHECK_LE(to->byte_offset + nbytes, tensor_total_size_bytes)
+      << "CopyToRemote: overflow in tensor size: (byte_offset=" << to->byte_offset
+      << ", nbytes=" << nbytes << ", tensor_total_size=" << tensor_total_size_bytes << ")";
+
+  uint64_t packet_nbytes = RemoteCopyCalculatePacketOverheadSize(to, code, nbytes) +
+                           sizeof(compressed_bytes) + compressed_bytes;
+  handler_->Write(packet_nbytes);
+  handler_->Write(code);
+  RPCReference::SendDLTensor(handler_, to);
+  handler_->Write(nbytes);
+  handler_->Write(compressed_bytes);
+  handler_->WriteArray(static_cast<const char*>(compressed), compressed_bytes);
+  code = HandleUntilReturnEvent(true, [](TVMArgs) {});
+  ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+}
+
+uint64_t RPCEndpoint::CopyFromRemoteCompressed(DLTensor* from, void* to_bytes, uint64_t nbytes,
+                                               int level) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RPCCode code = RPCCode::kCopyFromRemoteCompressed;
+
+  uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*from));
+  ICHECK_LE(from->byte_offset + nbytes, tensor_total_size_bytes)
+      << "CopyFromRemote: overflow in tensor size: (byte_offset=" << from->byte_offset
+      << ", nbytes=" << nbytes << ", tensor_total_size=" << tensor_total_size_bytes << ")";
+
+  int64_t level_field = level;
+  uint64_t packet_nbytes =
+      RemoteCopyCalculatePacketOverheadSize(from, code, nbytes) + sizeof(level_field);
+  handler_->Write(packet_nbytes);
+  handler_->Write(code);
+  RPCReference::SendDLTensor(handler_, from);
+  handler_->Write(nbytes);
+  handler_->Write(level_field);
+  uint64_t payload_bytes = 0;
+  code = HandleUntilReturnEvent(true, [to_bytes, nbytes, &payload_bytes](TVMArgs args) {
+    ICHECK_EQ(args.size(), 2);
+    int64_t compressed = args[0];
+    const auto* payload = static_cast<const TVMByteArray*>(args.values[1].v_handle);
+    if (compressed) {
+      RPCDecompress(payload->data, payload->size, to_bytes, nbytes);
+    } else {
+      ICHECK_EQ(payload->size, nbytes);
+      std::memcpy(to_bytes, payload->data, nbytes);
+    }
+    payload_bytes = payload->size;
+  });
+  ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+  return payload_bytes;
+}
+
 // SysCallEventHandler functions
 void RPCGetGlobalFunc(RPCSession* handler, TVMArgs args, TVMRetValue* rv) {
   std::string name = args[0];
@@ -983,6 +1702,18 @@ void RPCEndpoint::EventHandler::HandleSyscall(RPCCode code) {
     case RPCCode::kCopyAmongRemote:
       SysCallHandler(RPCCopyAmongRemote);
       break;
+    case RPCCode::kCopyToRemoteStream:
+      this->HandleCopyToRemoteStream();
+      break;
+    case RPCCode::kCopyToRemoteCached:
+      this->HandleCopyToRemoteCached();
+      break;
+    case RPCCode::kCopyToRemoteCompressed:
+      this->HandleCopyToRemoteCompressed();
+      break;
+    case RPCCode::kCopyFromRemoteCompressed:
+      this->HandleCopyFromRemoteCompressed();
+      break;
     default:
       LOG(FATAL) << "Unknown event " << static_cast<int>(code);
   }
@@ -1013,55 +1744,24 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
   }
 
   void CopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) final {
-    RPCCode code = RPCCode::kCopyToRemote;
-    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_to, code, nbytes);
-    uint64_t rpc_max_size = GetRPCMaxTransferSize();
-    ICHECK_GT(rpc_max_size, overhead) << "CopyToRemote: Invalid block size!";
-    const uint64_t block_size = rpc_max_size - overhead;
-    uint64_t block_count = 0;
-    const uint64_t num_blocks = nbytes / block_size;
-    void* from_bytes;
-
-    for (block_count = 0; block_count < num_blocks; block_count++) {
-      remote_to->byte_offset = block_count * block_size;
-      from_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, block_size);
-    }
-
-    const uint64_t remainder_bytes = nbytes % block_size;
-    if (remainder_bytes != 0) {
-      remote_to->byte_offset = block_count * block_size;
-      from_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, remainder_bytes);
+    auto tstart = std::chrono::steady_clock::now();
+    if (!CopyToRemoteCached(local_from_bytes, remote_to, nbytes) &&
+        !CopyToRemoteCompressed(local_from_bytes, remote_to, nbytes)) {
+      CopyToRemoteBlocks(local_from_bytes, remote_to, nbytes);
     }
+    copy_to_remote_bytes_ += nbytes;
+    copy_time_sec_ +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count();
   }
 
   void CopyFromRemote(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes) final {
-    RPCCode code = RPCCode::kCopyFromRemote;
-    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_from, code, nbytes);
-    uint64_t rpc_max_size = GetRPCMaxTransferSize();
-    ICHECK_GT(rpc_max_size, overhead) << "CopyFromRemote: Invalid block size!";
-    const uint64_t block_size = rpc_max_size - overhead;
-    uint64_t block_count = 0;
-    const uint64_t num_blocks = nbytes / block_size;
-    void* to_bytes;
-
-    for (block_count = 0; block_count < num_blocks; block_count++) {
-      remote_from->byte_offset = block_count * block_size;
-      to_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
-      endpoint_->CopyFromRemote(remote_from, to_bytes, block_size);
-    }
-
-    const uint64_t remainder_bytes = nbytes % block_size;
-    if (remainder_bytes != 0) {
-      remote_from->byte_offset = block_count * block_size;
-      to_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
-      endpoint_->CopyFromRemote(remote_from, to_bytes, remainder_bytes);
+    auto tstart = std::chrono::steady_clock::now();
+    if (!CopyFromRemoteCompressed(remote_from, local_to_bytes, nbytes)) {
+      CopyFromRemoteBlocks(remote_from, local_to_bytes, nbytes);
     }
+    copy_from_remote_bytes_ += nbytes;
+    copy_time_sec_ +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - tstart).count();
   }
 
   void FreeHandle(void* handle, int type_code) final {
@@ -1131,7 +1831,243 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
 
   void Shutdown() final { endpoint_->Shutdown(); }
 
+  /*!
+   * \brief Set how large copies are streamed to and from the remote.
+   * \param window The number of blocks in flight, 0 to disable streaming.
+   * \param block_bytes The size of each block in bytes.
+   */
+  void SetCopyStream(int window, uint64_t block_bytes) {
+    ICHECK_GE(window, 0);
+    ICHECK_GT(block_bytes, 0U);
+    copy_stream_window_ = window;
+    copy_stream_block_bytes_ = block_bytes;
+  }
+
+  /*!
+   * \brief Set the minimum size of the copies sent through the copy cache of the server.
+   * \param min_bytes The minimum size in bytes, 0 to disable the cache.
+   */
+  void SetCopyCache(uint64_t min_bytes) { copy_cache_min_bytes_ = min_bytes; }
+
+  /*!
+   * \brief Set the compression of the copies to and from the remote.
+   * \param level The zstd compression level, 0 to disable compression.
+   * \param min_bytes The minimum size in bytes of the copies to compress.
+   */
+  void SetCopyCompression(int level, uint64_t min_bytes) {
+#if !TVM_RPC_USE_ZSTD
+    CHECK_EQ(level, 0) << "Compressed RPC copies require the runtime to be built with zstd";
+#endif
+    copy_compression_level_ = level;
+    copy_compression_min_bytes_ = min_bytes;
+  }
+
+  /*! \return The transfer statistics of the session as a JSON string. */
+  std::string GetTransferStats() {
+    std::ostringstream os;
+    os << "{\"bytes_sent\": " << endpoint_->bytes_sent()
+       << ", \"bytes_received\": " << endpoint_->bytes_received()
+       << ", \"copy_to_remote_bytes\": " << copy_to_remote_bytes_
+       << ", \"copy_from_remote_bytes\": " << copy_from_remote_bytes_
+       << ", \"cache_hit_bytes\": " << cache_hit_bytes_
+       << ", \"compressed_copy_bytes\": " << compressed_copy_bytes_
+       << ", \"compressed_payload_bytes\": " << compressed_payload_bytes_
+       << ", \"copy_time_sec\": " << copy_time_sec_ << "}";
+    return os.str();
+  }
+
  private:
+  /*!
+   * \brief Copy to the remote through the copy cache of the server.
+   *
+   *  The data is first referenced by its content key and only sent when the server misses.
+   * \return Whether the copy is done, false if the cache does not apply.
+   */
+  bool CopyToRemoteCached(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) {
+    if (copy_cache_min_bytes_ == 0 || nbytes < copy_cache_min_bytes_ || !UseCopyCache()) {
+      return false;
+    }
+    // The whole copy goes in a single packet.
+    uint64_t overhead =
+        RemoteCopyCalculatePacketOverheadSize(remote_to, RPCCode::kCopyToRemoteCached, nbytes);
+    if (overhead + nbytes > GetRPCMaxTransferSize()) {
+      return false;
+    }
+    std::string key = RPCCopyCacheKey(local_from_bytes, nbytes);
+    if (endpoint_->CopyToRemoteCached(local_from_bytes, remote_to, nbytes, key, false)) {
+      cache_hit_bytes_ += nbytes;
+      return true;
+    }
+    return endpoint_->CopyToRemoteCached(local_from_bytes, remote_to, nbytes, key, true);
+  }
+
+  /*!
+   * \brief Copy to the remote in blocks compressed with zstd. The blocks which do not get
+   *  smaller are sent as is.
+   * \return Whether the copy is done, false if compression does not apply.
+   */
+  bool CopyToRemoteCompressed(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) {
+    if (!UseCopyCompression(nbytes)) {
+      return false;
+    }
+    // A compressed block is smaller than the block, so it fits in a packet.
+    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(
+                            remote_to, RPCCode::kCopyToRemoteCompressed, nbytes) +
+                        sizeof(uint64_t);
+    uint64_t rpc_max_size = GetRPCMaxTransferSize();
+    ICHECK_GT(rpc_max_size, overhead) << "CopyToRemote: Invalid block size!";
+    const uint64_t block_size = std::min(kRPCCopyCompressBlockBytes, rpc_max_size - overhead);
+    std::vector<char> compressed(block_size);
+    for (uint64_t offset = 0; offset < nbytes; offset += block_size) {
+      uint64_t size = std::min(block_size, nbytes - offset);
+      char* from_bytes = static_cast<char*>(local_from_bytes) + offset;
+      remote_to->byte_offset = offset;
+      uint64_t compressed_bytes =
+          RPCCompress(from_bytes, size, compressed.data(), size, copy_compression_level_);
+      if (compressed_bytes != 0) {
+        endpoint_->CopyToRemoteCompressed(compressed.data(), compressed_bytes, remote_to, size);
+      } else {
+        endpoint_->CopyToRemote(from_bytes, remote_to, size);
+      }
+      compressed_copy_bytes_ += size;
+      compressed_payload_bytes_ += compressed_bytes != 0 ? compressed_bytes : size;
+    }
+    return true;
+  }
+
+  /*!
+   * \brief Copy from the remote in blocks compressed with zstd by the server.
+   * \return Whether the copy is done, false if compression does not apply.
+   */
+  bool CopyFromRemoteCompressed(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes) {
+    if (!UseCopyCompression(nbytes)) {
+      return false;
+    }
+    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(
+        remote_from, RPCCode::kCopyFromRemoteCompressed, nbytes);
+    uint64_t rpc_max_size = GetRPCMaxTransferSize();
+    ICHECK_GT(rpc_max_size, overhead) << "CopyFromRemote: Invalid block size!";
+    const uint64_t block_size = std::min(kRPCCopyCompressBlockBytes, rpc_max_size - overhead);
+    for (uint64_t offset = 0; offset < nbytes; offset += block_size) {
+      uint64_t size = std::min(block_size, nbytes - offset);
+      remote_from->byte_offset = offset;
+      compressed_payload_bytes_ += endpoint_->CopyFromRemoteCompressed(
+          remote_from, static_cast<char*>(local_to_bytes) + offset, size, copy_compression_level_);
+      compressed_copy_bytes_ += size;
+    }
+    return true;
+  }
+
+  /*! \return Whether a copy of nbytes is compressed, which requires the support of the server. */
+  bool UseCopyCompression(uint64_t nbytes) {
+    if (copy_compression_level_ == 0 || nbytes < copy_compression_min_bytes_) {
+      return false;
+    }
+    if (copy_compression_supported_ < 0) {
+      PackedFuncHandle rpc_func = GetFunction("tvm.rpc.server.SupportCopyCompression");
+      copy_compression_supported_ = rpc_func != nullptr;
+      if (rpc_func != nullptr) {
+        FreeHandle(rpc_func, kTVMPackedFuncHandle);
+      }
+    }
+    return copy_compression_supported_ != 0;
+  }
+
+  /*! \return Whether the server has a copy cache. */
+  bool UseCopyCache() {
+    if (copy_cache_supported_ < 0) {
+      PackedFuncHandle rpc_func = GetFunction("tvm.rpc.server.copy_cache_dir");
+      copy_cache_supported_ = rpc_func != nullptr;
+      if (rpc_func != nullptr) {
+        FreeHandle(rpc_func, kTVMPackedFuncHandle);
+      }
+    }
+    return copy_cache_supported_ != 0;
+  }
+
+  /*! \return Whether large copies are streamed, which requires the support of the server. */
+  bool UseCopyStream() {
+    if (copy_stream_window_ == 0) {
+      return false;
+    }
+    if (copy_stream_supported_ < 0) {
+      PackedFuncHandle rpc_func = GetFunction("tvm.rpc.server.SupportCopyStream");
+      copy_stream_supported_ = rpc_func != nullptr;
+      if (rpc_func != nullptr) {
+        FreeHandle(rpc_func, kTVMPackedFuncHandle);
+      }
+    }
+    return copy_stream_supported_ != 0;
+  }
+
+  /*! \brief Copy to the remote in blocks that fit in the maximum transfer size. */
+  void CopyToRemoteBlocks(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) {
+    RPCCode code = RPCCode::kCopyToRemote;
+    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_to, code, nbytes);
+    uint64_t rpc_max_size = GetRPCMaxTransferSize();
+    ICHECK_GT(rpc_max_size, overhead) << "CopyToRemote: Invalid block size!";
+    const uint64_t block_size = rpc_max_size - overhead;
+    if (nbytes > copy_stream_block_bytes_ && UseCopyStream()) {
+      // The stream blocks carry an extra flags field.
+      uint64_t stream_block_size =
+          std::min(copy_stream_block_bytes_, block_size - sizeof(uint64_t));
+      endpoint_->CopyToRemoteStream(local_from_bytes, remote_to, nbytes, stream_block_size,
+                                    copy_stream_window_);
+      return;
+    }
+    uint64_t block_count = 0;
+    const uint64_t num_blocks = nbytes / block_size;
+    void* from_bytes;
+
+    for (block_count = 0; block_count < num_blocks; block_count++) {
+      remote_to->byte_offset = block_count * block_size;
+      from_bytes = reinterpret_cast<void*>(
+          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
+      endpoint_->CopyToRemote(from_bytes, remote_to, block_size);
+    }
+
+    const uint64_t remainder_bytes = nbytes % block_size;
+    if (remainder_bytes != 0) {
+      remote_to->byte_offset = block_count * block_size;
+      from_bytes = reinterpret_cast<void*>(
+          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
+      endpoint_->CopyToRemote(from_bytes, remote_to, remainder_bytes);
+    }
+  }
+
+  /*! \brief Copy from the remote in blocks that fit in the maximum transfer size. */
+  void CopyFromRemoteBlocks(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes) {
+    RPCCode code = RPCCode::kCopyFromRemote;
+    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_from, code, nbytes);
+    uint64_t rpc_max_size = GetRPCMaxTransferSize();
+    ICHECK_GT(rpc_max_size, overhead) << "CopyFromRemote: Invalid block size!";
+    const uint64_t block_size = rpc_max_size - overhead;
+    if (nbytes > copy_stream_block_bytes_ && UseCopyStream()) {
+      endpoint_->CopyFromRemoteStream(remote_from, local_to_bytes, nbytes,
+                                      std::min(copy_stream_block_bytes_, block_size),
+                                      copy_stream_window_);
+      return;
+    }
+    uint64_t block_count = 0;
+    const uint64_t num_blocks = nbytes / block_size;
+    void* to_bytes;
+
+    for (block_count = 0; block_count < num_blocks; block_count++) {
+      remote_from->byte_offset = block_count * block_size;
+      to_bytes = reinterpret_cast<void*>(
+          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
+      endpoint_->CopyFromRemote(remote_from, to_bytes, block_size);
+    }
+
+    const uint64_t remainder_bytes = nbytes % block_size;
+    if (remainder_bytes != 0) {
+      remote_from->byte_offset = block_count * block_size;
+      to_bytes = reinterpret_cast<void*>(
+          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
+      endpoint_->CopyFromRemote(remote_from, to_bytes, remainder_bytes);
+    }
+  }
+
   uint64_t GetRPCMaxTransferSize() {
     if (rpc_chunk_max_size_bytes_ > 0) {
       return (uint64_t)rpc_chunk_max_size_bytes_;
@@ -1155,12 +2091,67 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
 
   std::shared_ptr<RPCEndpoint> endpoint_;
   int64_t rpc_chunk_max_size_bytes_ = -1;
+  // Whether the server handles kCopyToRemoteStream, -1 if not queried yet.
+  int copy_stream_supported_ = -1;
+  // Streaming is opt-in until measured to pay off on the links it is used over.
+  int copy_stream_window_ = 0;
+  uint64_t copy_stream_block_bytes_ = kRPCCopyStreamBlockBytes;
+  // Whether the server has a copy cache, -1 if not queried yet.
+  int copy_cache_supported_ = -1;
+  uint64_t copy_cache_min_bytes_ = 0;
+  // Whether the server handles compressed copies, -1 if not queried yet.
+  int copy_compression_supported_ = -1;
+  int copy_compression_level_ = 0;
+  uint64_t copy_compression_min_bytes_ = 0;
+  // Transfer statistics.
+  uint64_t copy_to_remote_bytes_ = 0;
+  uint64_t copy_from_remote_bytes_ = 0;
+  uint64_t cache_hit_bytes_ = 0;
+  uint64_t compressed_copy_bytes_ = 0;
+  uint64_t compressed_payload_bytes_ = 0;
+  double copy_time_sec_ = 0;
 };
 
 std::shared_ptr<RPCSession> CreateClientSession(std::shared_ptr<RPCEndpoint> endpoint) {
   return std::make_shared<RPCClientSession>(endpoint);
 }
 
+// Marks that the server handles kCopyToRemoteStream.
+TVM_REGISTER_GLOBAL("tvm.rpc.server.SupportCopyStream").set_body_typed([]() { return true; });
+
+#if TVM_RPC_USE_ZSTD
+// Marks that the server handles kCopyToRemoteCompressed and kCopyFromRemoteCompressed.
+TVM_REGISTER_GLOBAL("tvm.rpc.server.SupportCopyCompression").set_body_typed([]() {
+  return true;
+});
+#endif
+
+static RPCClientSession* GetClientSession(Module sess) {
+  auto* client_sess = dynamic_cast<RPCClientSession*>(RPCModuleGetSession(sess).get());
+  ICHECK(client_sess != nullptr) << "Expect a remote session";
+  return client_sess;
+}
+
+TVM_REGISTER_GLOBAL("rpc.SessSetCopyStream")
+    .set_body_typed([](Module sess, int window, int64_t block_bytes) {
+      GetClientSession(sess)->SetCopyStream(window, static_cast<uint64_t>(block_bytes));
+    });
+
+TVM_REGISTER_GLOBAL("rpc.SessSetCopyCache").set_body_typed([](Module sess, int64_t min_bytes) {
+  ICHECK_GE(min_bytes, 0);
+  GetClientSession(sess)->SetCopyCache(static_cast<uint64_t>(min_bytes));
+});
+
+TVM_REGISTER_GLOBAL("rpc.SessSetCopyCompression")
+    .set_body_typed([](Module sess, int level, int64_t min_bytes) {
+      ICHECK_GE(min_bytes, 0);
+      GetClientSession(sess)->SetCopyCompression(level, static_cast<uint64_t>(min_bytes));
+    });
+
+TVM_REGISTER_GLOBAL("rpc.SessGetTransferStats").set_body_typed([](Module sess) {
+  return GetClientSession(sess)->GetTransferStats();
+});
+
 uint64_t RemoteCopyCalculatePacketOverheadSize(DLTensor* tensor, RPCCode code, uint64_t nbytes) {
   uint64_t shape_bytes = tensor->ndim * sizeof(int64_t);
   uint64_t to_data = reinterpret_cast<uint64_t>(static_cast<uint8_t*>(tensor->data));
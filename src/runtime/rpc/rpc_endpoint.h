@@ -49,6 +49,16 @@ const int kRPCSuccess = kRPCMagic + 0;
 // cannot found matched key in server
 const int kRPCMismatch = kRPCMagic + 2;
 
+/*! \brief The size of the blocks a large copy between client and server is streamed in. */
+const uint64_t kRPCCopyStreamBlockBytes = 1 << 20;
+/*! \brief The size of the blocks a compressed copy is split into, each compressed on its own. */
+const uint64_t kRPCCopyCompressBlockBytes = 4 << 20;
+/*!
+ * \brief The minimum size of a copy payload that is sent from and received into the user buffer
+ *  directly, instead of passing through the ring buffers of the endpoint.
+ */
+const uint64_t kRPCZeroCopyMinBytes = 64 << 10;
+
 /*! \brief Enumeration code for the RPC tracker */
 enum class TrackerCode : int {
   kFail = -1,
@@ -162,6 +172,65 @@ class RPCEndpoint {
    * \param type_hint Hint of content data type.
    */
   void CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes);
+  /*!
+   * \brief Copy bytes into remote array content as a stream of blocks.
+   *
+   *  Up to \p window blocks are sent without waiting for the remote. The remote acknowledges
+   *  every window / 2 blocks at once, so that the copy is not bound by the round-trip latency.
+   * \param from_bytes The source host data.
+   * \param to The target array.
+   * \param nbytes The size of the memory in bytes.
+   * \param block_size The size of each block in bytes.
+   * \param window The maximum number of unacknowledged blocks.
+   */
+  void CopyToRemoteStream(void* from_bytes, DLTensor* to, uint64_t nbytes, uint64_t block_size,
+                          int window);
+  /*!
+   * \brief Copy bytes from remote array content as a stream of blocks.
+   *
+   *  Up to \p window block requests are sent without waiting for the data of earlier blocks.
+   * \param from The source array.
+   * \param to_bytes The target host data.
+   * \param nbytes The size of the memory in bytes.
+   * \param block_size The size of each block in bytes.
+   * \param window The maximum number of outstanding block requests.
+   */
+  void CopyFromRemoteStream(DLTensor* from, void* to_bytes, uint64_t nbytes, uint64_t block_size,
+                            int window);
+  /*!
+   * \brief Copy bytes into remote array content through the copy cache of the server.
+   * \param from_bytes The source host data.
+   * \param to The target array.
+   * \param nbytes The size of the memory in bytes.
+   * \param key The content key of the bytes in the cache.
+   * \param with_data Whether to send the bytes and store them in the cache. Otherwise only the key
+   *  is sent, and the server copies the bytes it cached before.
+   * \return Whether the copy is done, which is false when the key is not in the cache.
+   */
+  bool CopyToRemoteCached(void* from_bytes, DLTensor* to, uint64_t nbytes, const std::string& key,
+                          bool with_data);
+  /*!
+   * \brief Copy bytes compressed with zstd into remote array content.
+   * \param compressed The compressed bytes.
+   * \param compressed_bytes The size of the compressed bytes.
+   * \param to The target array.
+   * \param nbytes The size of the memory in bytes, once decompressed.
+   */
+  void CopyToRemoteCompressed(const void* compressed, uint64_t compressed_bytes, DLTensor* to,
+                              uint64_t nbytes);
+  /*!
+   * \brief Copy bytes from remote array content, compressed by the server.
+   * \param from The source array.
+   * \param to_bytes The target host data.
+   * \param nbytes The size of the memory in bytes.
+   * \param level The compression level of the server.
+   * \return The number of payload bytes received, less than nbytes when compressed.
+   */
+  uint64_t CopyFromRemoteCompressed(DLTensor* from, void* to_bytes, uint64_t nbytes, int level);
+  /*! \return The number of bytes sent to the channel. */
+  uint64_t bytes_sent() const { return bytes_sent_; }
+  /*! \return The number of bytes received from the channel. */
+  uint64_t bytes_received() const { return bytes_received_; }
 
   /*!
    * \brief Call a remote defined system function with arguments.
@@ -189,6 +258,8 @@ class RPCEndpoint {
   // Handle events until receives a return
   // Also flushes channels so that the function advances.
   RPCCode HandleUntilReturnEvent(bool client_mode, RPCSession::FEncodeReturn setreturn);
+  // Flush the packet header in the writer together with its payload in a vectored send.
+  void FlushWriterWithPayload(const void* payload, uint64_t nbytes);
   // Initalization
   void Init();
   // Internal channel.
@@ -208,6 +279,8 @@ class RPCEndpoint {
   std::string remote_key_;
   // Invoked when the RPC session is terminated
   TypedPackedFunc<void()> fcleanup_;
+  // The number of bytes sent to and received from the channel.
+  uint64_t bytes_sent_{0}, bytes_received_{0};
 };
 
 /*!
@@ -223,6 +296,23 @@ inline TVMRetValue RPCEndpoint::SysCallRemote(RPCCode code, Args&&... args) {
   return syscall_remote_(static_cast<int>(code), std::forward<Args>(args)...);
 }
 
+/*!
+ * \brief Get the key of bytes in the RPC copy cache: their SHA-256 digest in 64 lowercase hex
+ *  digits, '-' and their size in decimal.
+ * \param data The bytes.
+ * \param nbytes The number of bytes.
+ * \return The key.
+ */
+std::string RPCCopyCacheKey(const void* data, uint64_t nbytes);
+
+/*!
+ * \brief Whether a key of the RPC copy cache has the form made by RPCCopyCacheKey. The key
+ *  names a file of the server.
+ * \param key The key.
+ * \return Whether the key is valid.
+ */
+bool IsRPCCopyCacheKey(const std::string& key);
+
 /*!
  * \brief Calculates overhead size of a CopyToRemote packet.
  * \param to DLTensor to copy.
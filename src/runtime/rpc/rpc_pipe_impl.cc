@@ -27,11 +27,13 @@
 #include <errno.h>
 #include <signal.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <tvm/runtime/registry.h>
 #include <unistd.h>
 
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include "../../support/pipe.h"
 #include "rpc_endpoint.h"
@@ -63,6 +65,19 @@ class PipeChannel final : public RPCChannel {
     return static_cast<size_t>(n);
   }
 
+  size_t SendV(const RPCIOVec* iov, int iovcnt) final {
+    std::vector<struct iovec> vec(iovcnt);
+    for (int i = 0; i < iovcnt; ++i) {
+      vec[i].iov_base = const_cast<void*>(iov[i].data);
+      vec[i].iov_len = iov[i].size;
+    }
+    ssize_t n = writev(writefd_, vec.data(), iovcnt);
+    if (n == -1) {
+      LOG(FATAL) << "Pipe write error";
+    }
+    return static_cast<size_t>(n);
+  }
+
   void Close() {
     close(readfd_);
     close(writefd_);
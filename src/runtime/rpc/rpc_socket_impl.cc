@@ -24,6 +24,7 @@
 #include <tvm/runtime/registry.h>
 
 #include <memory>
+#include <vector>
 
 #include "../../support/socket.h"
 #include "rpc_endpoint.h"
@@ -60,6 +61,21 @@ class SockChannel final : public RPCChannel {
     return static_cast<size_t>(n);
   }
 
+#if !defined(_WIN32)
+  size_t SendV(const RPCIOVec* iov, int iovcnt) final {
+    std::vector<struct iovec> vec(iovcnt);
+    for (int i = 0; i < iovcnt; ++i) {
+      vec[i].iov_base = const_cast<void*>(iov[i].data);
+      vec[i].iov_len = iov[i].size;
+    }
+    ssize_t n = sock_.SendV(vec.data(), iovcnt);
+    if (n == -1) {
+      support::Socket::Error("SockChannel::SendV");
+    }
+    return static_cast<size_t>(n);
+  }
+#endif
+
  private:
   support::TCPSocket sock_;
 };
@@ -102,6 +102,20 @@ class RingBuffer {
     head_ptr_ = (head_ptr_ + size) % ring_.size();
     bytes_available_ -= size;
   }
+  /*!
+   * \brief Copy data from the head of the buffer without consuming it.
+   *  size must be smaller than this->bytes_available()
+   * \param data the data pointer.
+   * \param size The number of bytes to copy.
+   */
+  void Peek(void* data, size_t size) const {
+    ICHECK_GE(bytes_available_, size);
+    size_t ncopy = std::min(size, ring_.size() - head_ptr_);
+    memcpy(data, &ring_[0] + head_ptr_, ncopy);
+    if (ncopy < size) {
+      memcpy(reinterpret_cast<char*>(data) + ncopy, &ring_[0], size - ncopy);
+    }
+  }
   /*!
    * \brief Read data from buffer with and put them to non-blocking send function.
    *
@@ -46,6 +46,7 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif
 #include <tvm/runtime/logging.h>
@@ -502,6 +503,18 @@ class TCPSocket : public Socket {
     return RetryCallOnEINTR(
         [&]() { return send(sockfd, buf, static_cast<sock_size_t>(len), flag); });
   }
+#ifndef _WIN32
+  /*!
+   * \brief send a sequence of buffers using the socket in a single call
+   * \param iov the buffers
+   * \param iovcnt the number of buffers
+   * \return size of data actually sent
+   *         return -1 if error occurs
+   */
+  ssize_t SendV(const struct iovec* iov, int iovcnt) {
+    return RetryCallOnEINTR([&]() { return writev(sockfd, iov, iovcnt); });
+  }
+#endif
   /*!
    * \brief receive data using the socket
    * \param buf_ the pointer to the buffer
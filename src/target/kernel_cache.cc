@@ -0,0 +1,238 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file target/kernel_cache.cc
+ * \brief Persistent cache of the object code of compiled PrimFuncs.
+ */
+#include "kernel_cache.h"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <tvm/ir/transform.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/registry.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#include <sys/utime.h>
+#else
+#include <dirent.h>
+#include <utime.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "../support/sha256.h"
+
+namespace tvm {
+namespace codegen {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("codegen.kernel_cache_dir", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("codegen.kernel_cache_max_bytes", Integer);
+
+/*! \brief The file extension of cache entries. */
+static constexpr const char* kCacheEntryExt = ".o";
+
+/*! \brief The version of the compiler stack that produced a cache entry. */
+static std::string CompilerVersion() {
+  std::string version = TVM_VERSION;
+#ifdef TVM_LLVM_VERSION
+  version += "/llvm-" + std::to_string(TVM_LLVM_VERSION);
+#endif
+  return version;
+}
+
+static std::string EntryPath(const std::string& cache_dir, const std::string& key) {
+  return cache_dir + "/" + key + kCacheEntryExt;
+}
+
+/*! \brief Create a directory and its parents, return whether it exists afterwards. */
+static bool MakeDirs(const std::string& dir) {
+  for (size_t pos = dir.find_first_of("/\\", 1);; pos = dir.find_first_of("/\\", pos + 1)) {
+    std::string prefix = dir.substr(0, pos);
+#ifdef _WIN32
+    int ret = _mkdir(prefix.c_str());
+#else
+    int ret = mkdir(prefix.c_str(), 0777);
+#endif
+    if (ret != 0 && errno != EEXIST) return false;
+    if (pos == std::string::npos) return true;
+  }
+}
+
+/*! \brief An entry of the cache directory: its modification time, size and path. */
+using CacheEntry = std::tuple<int64_t, int64_t, std::string>;
+
+/*! \brief List the entries of the cache directory. */
+static std::vector<CacheEntry> ListEntries(const std::string& cache_dir) {
+  std::vector<CacheEntry> entries;
+  const std::string ext = kCacheEntryExt;
+  auto is_entry = [&ext](const std::string& name) {
+    return name.size() > ext.size() && name.compare(name.size() - ext.size(), ext.size(), ext) == 0;
+  };
+#ifdef _WIN32
+  _finddata64_t info;
+  intptr_t handle = _findfirst64((cache_dir + "/*").c_str(), &info);
+  if (handle == -1) return entries;
+  do {
+    if (!(info.attrib & _A_SUBDIR) && is_entry(info.name)) {
+      entries.emplace_back(info.time_write, info.size, cache_dir + "/" + info.name);
+    }
+  } while (_findnext64(handle, &info) == 0);
+  _findclose(handle);
+#else
+  DIR* dir = opendir(cache_dir.c_str());
+  if (dir == nullptr) return entries;
+  while (dirent* d = readdir(dir)) {
+    std::string path = cache_dir + "/" + d->d_name;
+    struct stat info;
+    if (is_entry(d->d_name) && stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+      entries.emplace_back(info.st_mtime, info.st_size, path);
+    }
+  }
+  closedir(dir);
+#endif
+  return entries;
+}
+
+KernelCache* KernelCache::Global() {
+  static KernelCache* inst = new KernelCache();
+  return inst;
+}
+
+std::string KernelCache::GetKey(const tir::PrimFunc& func, const Target& target) {
+  // The configs of the cache itself do not change the generated code.
+  Map<String, ObjectRef> config;
+  for (const auto& kv : transform::PassContext::Current()->config) {
+    if (kv.first != "codegen.kernel_cache_dir" && kv.first != "codegen.kernel_cache_max_bytes") {
+      config.Set(kv.first, kv.second);
+    }
+  }
+  std::ostringstream os;
+  os << func->GetAttr<String>(tvm::attr::kGlobalSymbol).value() << "|" << std::hex
+     << StructuralHash()(func) << "|" << StructuralHash()(config) << "|" << target->str() << "|"
+     << CompilerVersion();
+  std::string context = os.str();
+  return support::SHA256Digest(context.data(), context.size());
+}
+
+bool KernelCache::Lookup(const std::string& cache_dir, const std::string& key,
+                         std::string* object) {
+  std::string path = EntryPath(cache_dir, key);
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ifstream fs(path, std::ios::in | std::ios::binary);
+  if (!fs) {
+    ++num_misses_;
+    return false;
+  }
+  object->assign(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+  // Refresh the modification time, which serves as the LRU timestamp.
+#ifdef _WIN32
+  _utime(path.c_str(), nullptr);
+#else
+  utime(path.c_str(), nullptr);
+#endif
+  ++num_hits_;
+  return true;
+}
+
+void KernelCache::Insert(const std::string& cache_dir, const std::string& key,
+                         const std::string& object) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!MakeDirs(cache_dir)) {
+    LOG(WARNING) << "Cannot create kernel cache directory " << cache_dir;
+    return;
+  }
+  // Write to a temporary file first so that concurrent readers never see a partial entry. The
+  // name is unique because other processes may store the same entry at the same time.
+  std::string path = EntryPath(cache_dir, key);
+  std::ostringstream tmp_name;
+  tmp_name << path << "." << std::hex << std::random_device()() << std::random_device()()
+           << ".tmp";
+  std::string tmp_path = tmp_name.str();
+  {
+    std::ofstream fs(tmp_path, std::ios::out | std::ios::binary);
+    fs.write(object.data(), object.size());
+    if (!fs) {
+      LOG(WARNING) << "Failed to write kernel cache entry " << tmp_path;
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return;
+  }
+  ++num_insertions_;
+}
+
+void KernelCache::Evict(const std::string& cache_dir, int64_t max_bytes) {
+  if (max_bytes < 0) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<CacheEntry> entries = ListEntries(cache_dir);
+  int64_t total_bytes = 0;
+  for (const CacheEntry& entry : entries) {
+    total_bytes += std::get<1>(entry);
+  }
+  std::sort(entries.begin(), entries.end());
+  for (const CacheEntry& entry : entries) {
+    if (total_bytes <= max_bytes) {
+      break;
+    }
+    if (std::remove(std::get<2>(entry).c_str()) == 0) {
+      total_bytes -= std::get<1>(entry);
+      ++num_evictions_;
+    }
+  }
+}
+
+Map<String, Integer> KernelCache::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto make_count = [](int64_t value) { return Integer(IntImm(DataType::Int(64), value)); };
+  return {{"hits", make_count(num_hits_)},
+          {"misses", make_count(num_misses_)},
+          {"insertions", make_count(num_insertions_)},
+          {"evictions", make_count(num_evictions_)}};
+}
+
+void KernelCache::ResetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  num_hits_ = num_misses_ = num_insertions_ = num_evictions_ = 0;
+}
+
+TVM_REGISTER_GLOBAL("target.KernelCacheGetStats").set_body_typed([]() {
+  return KernelCache::Global()->GetStats();
+});
+TVM_REGISTER_GLOBAL("target.KernelCacheResetStats").set_body_typed([]() {
+  KernelCache::Global()->ResetStats();
+});
+
+}  // namespace codegen
+}  // namespace tvm
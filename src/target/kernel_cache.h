@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file target/kernel_cache.h
+ * \brief Persistent cache of the object code of compiled PrimFuncs.
+ */
+#ifndef TVM_TARGET_KERNEL_CACHE_H_
+#define TVM_TARGET_KERNEL_CACHE_H_
+
+#include <tvm/runtime/container/map.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/function.h>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace tvm {
+namespace codegen {
+
+/*!
+ * \brief An on-disk cache of the object code that LLVM generates for each PrimFunc.
+ *
+ * Entries are keyed by the StructuralHash and global symbol of the PrimFunc, the target, the
+ * configs of the PassContext and the compiler version, so that changing one kernel of a model
+ * only misses for that kernel. They are stored as one object file per entry in the directory
+ * given by the PassContext config "codegen.kernel_cache_dir", and the least recently used
+ * entries are evicted once the directory exceeds "codegen.kernel_cache_max_bytes".
+ *
+ * \note Two PrimFuncs only share an entry if their 64-bit structural hashes collide while every
+ *  other part of the key is the same.
+ */
+class KernelCache {
+ public:
+  /*! \return The process-wide kernel cache. */
+  static KernelCache* Global();
+
+  /*!
+   * \brief Compute the cache key of a PrimFunc.
+   * \param func The PrimFunc, with its global symbol.
+   * \param target The target the PrimFunc is built for.
+   * \return The cache key.
+   */
+  static std::string GetKey(const tir::PrimFunc& func, const Target& target);
+
+  /*!
+   * \brief Look up the object code of a PrimFunc.
+   * \param cache_dir The cache directory.
+   * \param key The cache key.
+   * \param object Where the object code is written.
+   * \return Whether the entry was found.
+   */
+  bool Lookup(const std::string& cache_dir, const std::string& key, std::string* object);
+
+  /*!
+   * \brief Store the object code of a PrimFunc into the cache.
+   * \param cache_dir The cache directory.
+   * \param key The cache key.
+   * \param object The object code.
+   */
+  void Insert(const std::string& cache_dir, const std::string& key, const std::string& object);
+
+  /*!
+   * \brief Evict the least recently used entries until the directory fits in max_bytes.
+   * \param cache_dir The cache directory.
+   * \param max_bytes The maximum total size of the entries, -1 for unbounded.
+   */
+  void Evict(const std::string& cache_dir, int64_t max_bytes);
+
+  /*! \return The hit/miss/insertion/eviction counters of the cache. */
+  Map<String, Integer> GetStats();
+
+  /*! \brief Reset all the counters. */
+  void ResetStats();
+
+ private:
+  /*! \brief The mutex guarding the counters and the cache directory. */
+  std::mutex mutex_;
+  /*! \brief The number of lookups served from the cache. */
+  int64_t num_hits_ = 0;
+  /*! \brief The number of lookups not served from the cache. */
+  int64_t num_misses_ = 0;
+  /*! \brief The number of entries written. */
+  int64_t num_insertions_ = 0;
+  /*! \brief The number of entries evicted. */
+  int64_t num_evictions_ = 0;
+};
+
+}  // namespace codegen
+}  // namespace tvm
+#endif  // TVM_TARGET_KERNEL_CACHE_H_
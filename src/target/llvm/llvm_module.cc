@@ -41,13 +41,18 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Object/ObjectFile.h>
+#include <llvm/Support/Error.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 #include <tvm/ir/module.h>
+#include <tvm/ir/transform.h>
 #include <tvm/relay/runtime.h>
 #include <tvm/runtime/container/array.h>
 #include <tvm/runtime/container/string.h>
@@ -57,6 +62,7 @@
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/support/with.h>
 #include <tvm/target/codegen.h>
 #include <tvm/target/target.h>
@@ -67,12 +73,14 @@
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "../../runtime/file_utils.h"
 #include "../../runtime/library_module.h"
 #include "../func_registry_generator.h"
+#include "../kernel_cache.h"
 #include "codegen_blob.h"
 #include "codegen_cpu.h"
 #include "codegen_llvm.h"
@@ -85,6 +93,8 @@ using runtime::PackedFunc;
 using runtime::TVMArgs;
 using runtime::TVMRetValue;
 
+TVM_REGISTER_PASS_CONFIG_OPTION("codegen.llvm.num_shards", Integer);
+
 class LLVMModuleNode final : public runtime::ModuleNode {
  public:
   ~LLVMModuleNode();
@@ -107,6 +117,14 @@ class LLVMModuleNode final : public runtime::ModuleNode {
  private:
   void LazyInitJIT();
   bool IsCompatibleWithHost(const llvm::TargetMachine* tm) const;
+  std::unique_ptr<llvm::Module> CodeGen(const IRModule& mod, const Target& target,
+                                        LLVMTarget* llvm_target);
+  std::unique_ptr<llvm::Module> CodeGenSharded(const std::vector<PrimFunc>& funcs,
+                                               const std::string& entry_func,
+                                               const Target& target, int num_shards);
+  void InitObjects(const std::vector<PrimFunc>& funcs, const std::string& entry_func,
+                   const Target& target, const std::string& cache_dir);
+  llvm::Module* GetIRModule();
   void* GetGlobalAddr(const std::string& name, const LLVMTarget& llvm_target) const;
   void* GetFunctionAddr(const std::string& name, const LLVMTarget& llvm_target) const;
 
@@ -123,6 +141,16 @@ class LLVMModuleNode final : public runtime::ModuleNode {
   std::unique_ptr<llvm::Module> module_owning_ptr_;
   /* \brief names of the functions declared in this module */
   Array<String> function_names_;
+  // The lowered module and its target, kept when the functions are loaded as object code from
+  // the kernel cache, so that the IR is only generated when the module is saved or printed.
+  IRModule mod_;
+  Target target_;
+  // The object code of the functions, until the JIT loads it.
+  std::vector<std::string> objects_;
+  // The global symbols defined by the object code.
+  std::unordered_set<std::string> object_symbols_;
+  // The IR generated on demand for a module loaded as object code.
+  std::unique_ptr<llvm::Module> ir_module_;
 };
 
 LLVMModuleNode::~LLVMModuleNode() {
@@ -170,6 +198,7 @@ PackedFunc LLVMModuleNode::GetFunction(const std::string& name,
 
 void LLVMModuleNode::SaveToFile(const std::string& file_name, const std::string& format) {
   std::string fmt = runtime::GetFileFormat(file_name, format);
+  llvm::Module* module = GetIRModule();
   std::error_code ecode;
 #if TVM_LLVM_VERSION <= 70
   llvm::raw_fd_ostream dest(file_name, ecode, llvm::sys::fs::F_None);
@@ -178,11 +207,11 @@ void LLVMModuleNode::SaveToFile(const std::string& file_name, const std::string&
 #endif
   ICHECK_EQ(ecode.value(), 0) << "Cannot open file: " << file_name << " " << ecode.message();
   if (fmt == "o" || fmt == "obj") {
-    With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
+    With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module));
 #if TVM_LLVM_VERSION <= 60
-    std::unique_ptr<llvm::Module> m = llvm::CloneModule(module_);
+    std::unique_ptr<llvm::Module> m = llvm::CloneModule(module);
 #else
-    std::unique_ptr<llvm::Module> m = llvm::CloneModule(*module_);
+    std::unique_ptr<llvm::Module> m = llvm::CloneModule(*module);
 #endif
     llvm::legacy::PassManager pass;
     llvm::TargetMachine* tm = llvm_target->GetOrCreateTargetMachine();
@@ -198,11 +227,11 @@ void LLVMModuleNode::SaveToFile(const std::string& file_name, const std::string&
 #endif
     pass.run(*m);
   } else if (fmt == "s" || fmt == "asm") {
-    With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
+    With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module));
 #if TVM_LLVM_VERSION <= 60
-    std::unique_ptr<llvm::Module> m = llvm::CloneModule(module_);
+    std::unique_ptr<llvm::Module> m = llvm::CloneModule(module);
 #else
-    std::unique_ptr<llvm::Module> m = llvm::CloneModule(*module_);
+    std::unique_ptr<llvm::Module> m = llvm::CloneModule(*module);
 #endif
     llvm::legacy::PassManager pass;
     llvm::TargetMachine* tm = llvm_target->GetOrCreateTargetMachine();
@@ -219,12 +248,12 @@ void LLVMModuleNode::SaveToFile(const std::string& file_name, const std::string&
 #endif
     pass.run(*m);
   } else if (fmt == "ll") {
-    module_->print(dest, nullptr);
+    module->print(dest, nullptr);
   } else if (fmt == "bc") {
 #if TVM_LLVM_VERSION <= 60
-    llvm::WriteBitcodeToFile(module_, dest);
+    llvm::WriteBitcodeToFile(module, dest);
 #else
-    llvm::WriteBitcodeToFile(*module_, dest);
+    llvm::WriteBitcodeToFile(*module, dest);
 #endif
   } else {
     LOG(FATAL) << "Do not know how to save file " << file_name << " with format=\'" << format
@@ -239,16 +268,17 @@ void LLVMModuleNode::SaveToBinary(dmlc::Stream* stream) {
 
 std::string LLVMModuleNode::GetSource(const std::string& format) {
   std::string fmt = runtime::GetFileFormat("", format);
+  llvm::Module* module = GetIRModule();
   std::string type_str;
   llvm::SmallString<256> str;
   llvm::raw_svector_ostream rso(str);
 
   if (fmt == "s" || fmt == "asm") {
-    With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
+    With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module));
 #if TVM_LLVM_VERSION <= 60
-    std::unique_ptr<llvm::Module> m = llvm::CloneModule(module_);
+    std::unique_ptr<llvm::Module> m = llvm::CloneModule(module);
 #else
-    std::unique_ptr<llvm::Module> m = llvm::CloneModule(*module_);
+    std::unique_ptr<llvm::Module> m = llvm::CloneModule(*module);
 #endif
     llvm::legacy::PassManager pass;
     llvm::TargetMachine* tm = llvm_target->GetOrCreateTargetMachine();
@@ -267,8 +297,8 @@ std::string LLVMModuleNode::GetSource(const std::string& format) {
   } else if (fmt == "" || fmt == "ll") {
     std::string type_str;
     llvm::raw_string_ostream rso(type_str);
-    ICHECK(module_ != nullptr);
-    module_->print(rso, nullptr);
+    ICHECK(module != nullptr);
+    module->print(rso, nullptr);
     return rso.str();
   } else {
     LOG(FATAL) << "Do not know how to get source code with format: " << format << "\'";
@@ -276,19 +306,9 @@ std::string LLVMModuleNode::GetSource(const std::string& format) {
   return "";
 }
 
-void LLVMModuleNode::Init(const IRModule& mod, const Target& target) {
-  llvm_instance_ = std::make_unique<LLVMInstance>();
-  With<LLVMTarget> llvm_target(*llvm_instance_, target);
-  llvm::TargetMachine* tm = llvm_target->GetOrCreateTargetMachine();
-  std::unique_ptr<CodeGenLLVM> cg = CodeGenLLVM::Create(llvm_target.get());
-
-  std::vector<PrimFunc> funcs;
-  std::string entry_func;
-  relay::Runtime runtime =
-      mod->GetAttr<relay::Runtime>(tvm::attr::kRuntime).value_or(relay::Runtime::Create("cpp"));
-  bool system_lib = runtime->GetAttr<Bool>("system-lib").value_or(Bool(false));
-  bool target_c_runtime = runtime->name == "crt";
-
+/*! \brief Collect the PrimFuncs of mod and the global symbol of its entry function. */
+static void CollectPrimFuncs(const IRModule& mod, std::vector<PrimFunc>* funcs,
+                             std::string* entry_func) {
   for (auto kv : mod->functions) {
     if (!kv.second->IsInstance<PrimFuncNode>()) {
       // (@jroesch): we relax constraints here, Relay functions will just be ignored.
@@ -298,39 +318,244 @@ void LLVMModuleNode::Init(const IRModule& mod, const Target& target) {
     auto f = Downcast<PrimFunc>(kv.second);
     auto global_symbol = f->GetAttr<String>(tvm::attr::kGlobalSymbol);
     ICHECK(global_symbol.defined());
-    function_names_.push_back(global_symbol.value());
     if (f->HasNonzeroAttr(tir::attr::kIsEntryFunc)) {
-      entry_func = global_symbol.value();
+      *entry_func = global_symbol.value();
     }
-    funcs.push_back(f);
+    funcs->push_back(f);
   }
-  // TODO(@jroesch): follow up on this condition.
-  // ICHECK(funcs.size() > 0);
-  // TODO(tqchen): remove the entry function behavior as it does not
-  // makes sense when we start to use multiple modules.
-  cg->Init("TVMMod", llvm_target.get(), system_lib, system_lib, target_c_runtime);
-  cg->SetFastMathFlags(llvm_target->GetFastMathFlags());
-
-  cg->AddFunctionsOrdered(funcs.begin(), funcs.end());
-  if (entry_func.length() != 0) {
-    cg->AddMainFunction(entry_func);
+}
+
+/*!
+ * \brief Whether the functions of mod can be generated separately. This is limited to the plain
+ *  library mode: system-lib and CRT modules register all functions from a single startup
+ *  function, and command line options of the target are process-wide LLVM state that cannot be
+ *  applied concurrently.
+ */
+static bool IsPlainLibrary(const IRModule& mod, const Target& target) {
+  relay::Runtime runtime =
+      mod->GetAttr<relay::Runtime>(tvm::attr::kRuntime).value_or(relay::Runtime::Create("cpp"));
+  bool system_lib = runtime->GetAttr<Bool>("system-lib").value_or(Bool(false));
+  return !system_lib && runtime->name != "crt" &&
+         target->GetAttr<Array<String>>("cl-opt").value_or({}).empty();
+}
+
+/*! \brief Emit the object code of an optimized module. */
+static std::string EmitObjectCode(llvm::Module* module, llvm::TargetMachine* tm) {
+  llvm::SmallString<0> buffer;
+  llvm::raw_svector_ostream os(buffer);
+  llvm::legacy::PassManager pass;
+#if TVM_LLVM_VERSION <= 60
+  ICHECK(tm->addPassesToEmitFile(pass, os, llvm::TargetMachine::CGFT_ObjectFile) == 0)
+      << "Cannot emit target CGFT_ObjectFile";
+#elif TVM_LLVM_VERSION <= 90
+  ICHECK(tm->addPassesToEmitFile(pass, os, nullptr, llvm::TargetMachine::CGFT_ObjectFile) == 0)
+      << "Cannot emit target CGFT_ObjectFile";
+#else
+  ICHECK(tm->addPassesToEmitFile(pass, os, nullptr, llvm::CGFT_ObjectFile) == 0)
+      << "Cannot emit target CGFT_ObjectFile";
+#endif
+  pass.run(*module);
+  return std::string(buffer.begin(), buffer.end());
+}
+
+/*! \brief Whether bytes hold an object file that LLVM can load. */
+static bool IsObjectCode(const std::string& bytes) {
+  llvm::Expected<std::unique_ptr<llvm::object::ObjectFile>> object_file =
+      llvm::object::ObjectFile::createObjectFile(llvm::MemoryBufferRef(bytes, "kernel"));
+  if (!object_file) {
+    llvm::consumeError(object_file.takeError());
+    return false;
   }
+  return true;
+}
+
+void LLVMModuleNode::Init(const IRModule& mod, const Target& target) {
+  llvm_instance_ = std::make_unique<LLVMInstance>();
+  With<LLVMTarget> llvm_target(*llvm_instance_, target);
+  llvm::TargetMachine* tm = llvm_target->GetOrCreateTargetMachine();
 
-  module_owning_ptr_ = cg->Finish();
+  std::vector<PrimFunc> funcs;
+  std::string entry_func;
+  CollectPrimFuncs(mod, &funcs, &entry_func);
+  for (const PrimFunc& f : funcs) {
+    function_names_.push_back(f->GetAttr<String>(tvm::attr::kGlobalSymbol).value());
+  }
+  // With the kernel cache, the JIT runs the object code of each function as is, and the IR is
+  // generated again only to save the module. The cache is thus limited to modules for the host,
+  // except on Windows, where the weak globals that the functions share are COMDATs.
+  std::string cache_dir = transform::PassContext::Current()
+                              ->GetConfig<String>("codegen.kernel_cache_dir", String(""))
+                              .value();
+  if (!cache_dir.empty() && IsPlainLibrary(mod, target) && !tm->getTargetTriple().isOSWindows() &&
+      IsCompatibleWithHost(tm)) {
+    mod_ = mod;
+    target_ = target;
+    InitObjects(funcs, entry_func, target, cache_dir);
+    module_owning_ptr_ = std::make_unique<llvm::Module>("TVMMod", *llvm_target->GetContext());
+    module_owning_ptr_->setTargetTriple(tm->getTargetTriple().str());
+    module_owning_ptr_->setDataLayout(tm->createDataLayout());
+    llvm_target->SetTargetMetadata(module_owning_ptr_.get());
+  } else {
+    module_owning_ptr_ = CodeGen(mod, target, llvm_target.get());
+  }
   module_ = module_owning_ptr_.get();
-  llvm_target->SetTargetMetadata(module_);
-  module_->addModuleFlag(llvm::Module::Override, "Debug Info Version",
-                         llvm::DEBUG_METADATA_VERSION);
+}
+
+std::unique_ptr<llvm::Module> LLVMModuleNode::CodeGen(const IRModule& mod, const Target& target,
+                                                      LLVMTarget* llvm_target) {
+  llvm::TargetMachine* tm = llvm_target->GetOrCreateTargetMachine();
+
+  std::vector<PrimFunc> funcs;
+  std::string entry_func;
+  CollectPrimFuncs(mod, &funcs, &entry_func);
+  relay::Runtime runtime =
+      mod->GetAttr<relay::Runtime>(tvm::attr::kRuntime).value_or(relay::Runtime::Create("cpp"));
+  bool system_lib = runtime->GetAttr<Bool>("system-lib").value_or(Bool(false));
+  bool target_c_runtime = runtime->name == "crt";
+
+  int num_shards = transform::PassContext::Current()
+                       ->GetConfig<Integer>("codegen.llvm.num_shards", Integer(1))
+                       .value()
+                       .IntValue();
+  num_shards = std::min<int>(num_shards, funcs.size());
+  std::unique_ptr<llvm::Module> module;
+  if (num_shards > 1 && IsPlainLibrary(mod, target)) {
+    module = CodeGenSharded(funcs, entry_func, target, num_shards);
+  } else {
+    std::unique_ptr<CodeGenLLVM> cg = CodeGenLLVM::Create(llvm_target);
+    // TODO(@jroesch): follow up on this condition.
+    // ICHECK(funcs.size() > 0);
+    // TODO(tqchen): remove the entry function behavior as it does not
+    // makes sense when we start to use multiple modules.
+    cg->Init("TVMMod", llvm_target, system_lib, system_lib, target_c_runtime);
+    cg->SetFastMathFlags(llvm_target->GetFastMathFlags());
+
+    cg->AddFunctionsOrdered(funcs.begin(), funcs.end());
+    if (entry_func.length() != 0) {
+      cg->AddMainFunction(entry_func);
+    }
+
+    module = cg->Finish();
+  }
+  llvm_target->SetTargetMetadata(module.get());
+  module->addModuleFlag(llvm::Module::Override, "Debug Info Version",
+                        llvm::DEBUG_METADATA_VERSION);
 
   if (tm->getTargetTriple().isOSDarwin()) {
-    module_->addModuleFlag(llvm::Module::Override, "Dwarf Version", 2);
+    module->addModuleFlag(llvm::Module::Override, "Dwarf Version", 2);
   }
 
   std::string verify_errors_storage;
   llvm::raw_string_ostream verify_errors(verify_errors_storage);
-  LOG_IF(FATAL, llvm::verifyModule(*module_, &verify_errors))
+  LOG_IF(FATAL, llvm::verifyModule(*module, &verify_errors))
       << "LLVM module verification failed with the following errors: \n"
       << verify_errors.str();
+  return module;
+}
+
+void LLVMModuleNode::InitObjects(const std::vector<PrimFunc>& funcs, const std::string& entry_func,
+                                 const Target& target, const std::string& cache_dir) {
+  KernelCache* cache = KernelCache::Global();
+  std::vector<std::string> keys;
+  std::vector<int> misses;
+  objects_.resize(funcs.size());
+  for (size_t i = 0; i < funcs.size(); ++i) {
+    keys.push_back(KernelCache::GetKey(funcs[i], target));
+    // A damaged entry is generated again and overwritten.
+    if (!cache->Lookup(cache_dir, keys[i], &objects_[i]) || !IsObjectCode(objects_[i])) {
+      misses.push_back(i);
+    }
+  }
+  // Each missing function is generated, optimized and emitted in its own LLVMInstance, like a
+  // shard of CodeGenSharded.
+  int num_threads = transform::PassContext::Current()
+                        ->GetConfig<Integer>("codegen.llvm.num_shards", Integer(1))
+                        .value()
+                        .IntValue();
+  num_threads = std::max(1, std::min<int>(num_threads, misses.size()));
+  support::parallel_for_dynamic(0, misses.size(), num_threads, [&](int thread_id, int i) {
+    const PrimFunc& f = funcs[misses[i]];
+    LLVMInstance llvm_instance;
+    With<LLVMTarget> llvm_target(llvm_instance, target);
+    std::unique_ptr<CodeGenLLVM> cg = CodeGenLLVM::Create(llvm_target.get());
+    cg->Init("TVMMod", llvm_target.get(), false, false, false);
+    cg->SetFastMathFlags(llvm_target->GetFastMathFlags());
+    cg->AddFunction(f);
+    if (f->GetAttr<String>(tvm::attr::kGlobalSymbol).value() == entry_func) {
+      cg->AddMainFunction(entry_func);
+    }
+    std::unique_ptr<llvm::Module> module = cg->Finish();
+    objects_[misses[i]] = EmitObjectCode(module.get(), llvm_target->GetOrCreateTargetMachine());
+  });
+  for (int i : misses) {
+    cache->Insert(cache_dir, keys[i], objects_[i]);
+  }
+  if (!misses.empty()) {
+    int64_t max_bytes = transform::PassContext::Current()
+                            ->GetConfig<Integer>("codegen.kernel_cache_max_bytes",
+                                                 Integer(IntImm(DataType::Int(64), 1LL << 30)))
+                            .value()
+                            ->value;
+    cache->Evict(cache_dir, max_bytes);
+  }
+}
+
+llvm::Module* LLVMModuleNode::GetIRModule() {
+  if (!mod_.defined()) {
+    return module_;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ir_module_ == nullptr) {
+    With<LLVMTarget> llvm_target(*llvm_instance_, target_);
+    ir_module_ = CodeGen(mod_, target_, llvm_target.get());
+  }
+  return ir_module_.get();
+}
+
+std::unique_ptr<llvm::Module> LLVMModuleNode::CodeGenSharded(const std::vector<PrimFunc>& funcs,
+                                                             const std::string& entry_func,
+                                                             const Target& target,
+                                                             int num_shards) {
+  // Each shard is generated and optimized in its own LLVMInstance (i.e. LLVMContext), so that
+  // shards can be processed concurrently. The optimized shards are carried over to the
+  // context of this module as bitcode and linked into a single llvm::Module.
+  std::vector<std::vector<PrimFunc>> shard_funcs(num_shards);
+  for (size_t i = 0; i < funcs.size(); ++i) {
+    shard_funcs[i % num_shards].push_back(funcs[i]);
+  }
+  std::vector<std::string> shard_bitcodes(num_shards);
+  support::parallel_for_dynamic(0, num_shards, num_shards, [&](int thread_id, int shard_id) {
+    LLVMInstance llvm_instance;
+    With<LLVMTarget> llvm_target(llvm_instance, target);
+    std::unique_ptr<CodeGenLLVM> cg = CodeGenLLVM::Create(llvm_target.get());
+    cg->Init("TVMMod", llvm_target.get(), false, false, false);
+    cg->SetFastMathFlags(llvm_target->GetFastMathFlags());
+    const std::vector<PrimFunc>& shard = shard_funcs[shard_id];
+    cg->AddFunctionsOrdered(shard.begin(), shard.end());
+    if (!entry_func.empty()) {
+      for (const PrimFunc& f : shard) {
+        if (f->GetAttr<String>(tvm::attr::kGlobalSymbol).value() == entry_func) {
+          cg->AddMainFunction(entry_func);
+          break;
+        }
+      }
+    }
+    std::unique_ptr<llvm::Module> module = cg->Finish();
+    llvm::raw_string_ostream os(shard_bitcodes[shard_id]);
+#if TVM_LLVM_VERSION <= 60
+    llvm::WriteBitcodeToFile(module.get(), os);
+#else
+    llvm::WriteBitcodeToFile(*module, os);
+#endif
+    os.flush();
+  });
+
+  std::unique_ptr<llvm::Module> module = llvm_instance_->ParseIR(shard_bitcodes[0]);
+  for (int i = 1; i < num_shards; ++i) {
+    ICHECK(!llvm::Linker::linkModules(*module, llvm_instance_->ParseIR(shard_bitcodes[i])))
+        << "Failed to link LLVM code generation shard " << i;
+  }
+  return module;
 }
 
 void LLVMModuleNode::Init(std::unique_ptr<llvm::Module> module,
@@ -343,6 +568,12 @@ void LLVMModuleNode::Init(std::unique_ptr<llvm::Module> module,
 void LLVMModuleNode::LoadIR(const std::string& file_name) {
   auto llvm_instance = std::make_unique<LLVMInstance>();
   std::unique_ptr<llvm::Module> module = llvm_instance->LoadIR(file_name);
+  // Recover the exported functions, which are the externally visible definitions.
+  for (const llvm::Function& f : module->functions()) {
+    if (!f.isDeclaration() && f.hasExternalLinkage()) {
+      function_names_.push_back(f.getName().str());
+    }
+  }
   Init(std::move(module), std::move(llvm_instance));
 }
 
@@ -373,6 +604,42 @@ void LLVMModuleNode::LazyInitJIT() {
       << " and ExecutionEngine (" << layout.getStringRepresentation() << ")";
   ee_ = builder.create(tm.release());
   ICHECK(ee_ != nullptr) << "Failed to initialize jit engine for " << module_->getTargetTriple();
+  // The object code from the kernel cache is linked by the JIT, which resolves the weak globals
+  // that each function defines, e.g. the module context, to a single definition.
+  char global_prefix = module_->getDataLayout().getGlobalPrefix();
+  for (const std::string& object : objects_) {
+    std::unique_ptr<llvm::MemoryBuffer> buffer = llvm::MemoryBuffer::getMemBufferCopy(object);
+    llvm::Expected<std::unique_ptr<llvm::object::ObjectFile>> object_file =
+        llvm::object::ObjectFile::createObjectFile(buffer->getMemBufferRef());
+    ICHECK(object_file) << "Failed to load object code: "
+                        << llvm::toString(object_file.takeError());
+    for (const llvm::object::SymbolRef& symbol : (*object_file)->symbols()) {
+#if TVM_LLVM_VERSION >= 110
+      uint32_t flags = llvm::cantFail(symbol.getFlags());
+#else
+      uint32_t flags = symbol.getFlags();
+#endif
+      llvm::Expected<llvm::StringRef> name = symbol.getName();
+      if (!name) {
+        llvm::consumeError(name.takeError());
+        continue;
+      }
+      if ((flags & llvm::object::SymbolRef::SF_Global) &&
+          !(flags & llvm::object::SymbolRef::SF_Undefined)) {
+        llvm::StringRef symbol_name = *name;
+        if (global_prefix != '\0' && !symbol_name.empty() && symbol_name[0] == global_prefix) {
+          symbol_name = symbol_name.drop_front();
+        }
+        object_symbols_.insert(symbol_name.str());
+      }
+    }
+    ee_->addObjectFile(llvm::object::OwningBinary<llvm::object::ObjectFile>(
+        std::move(*object_file), std::move(buffer)));
+  }
+  if (!objects_.empty()) {
+    ee_->finalizeObject();
+    objects_.clear();
+  }
   ee_->runStaticConstructorsDestructors(false);
 
   if (void** ctx_addr =
@@ -403,7 +670,7 @@ bool LLVMModuleNode::IsCompatibleWithHost(const llvm::TargetMachine* tm) const {
 // Get global address from execution engine.
 void* LLVMModuleNode::GetGlobalAddr(const std::string& name, const LLVMTarget& llvm_target) const {
   // first verifies if GV exists.
-  if (module_->getGlobalVariable(name) != nullptr) {
+  if (module_->getGlobalVariable(name) != nullptr || object_symbols_.count(name)) {
     return reinterpret_cast<void*>(ee_->getGlobalValueAddress(name));
   } else {
     return nullptr;
@@ -413,7 +680,7 @@ void* LLVMModuleNode::GetGlobalAddr(const std::string& name, const LLVMTarget& l
 void* LLVMModuleNode::GetFunctionAddr(const std::string& name,
                                       const LLVMTarget& llvm_target) const {
   // first verifies if GV exists.
-  if (module_->getFunction(name) != nullptr) {
+  if (module_->getFunction(name) != nullptr || object_symbols_.count(name)) {
     return reinterpret_cast<void*>(ee_->getFunctionAddress(name));
   } else {
     return nullptr;
@@ -472,6 +739,13 @@ TVM_REGISTER_GLOBAL("runtime.module.loadfile_ll")
       return runtime::Module(n);
     });
 
+TVM_REGISTER_GLOBAL("runtime.module.loadfile_bc")
+    .set_body_typed([](std::string filename, std::string fmt) -> runtime::Module {
+      auto n = make_object<LLVMModuleNode>();
+      n->LoadIR(filename);
+      return runtime::Module(n);
+    });
+
 TVM_REGISTER_GLOBAL("codegen.llvm_target_enabled")
     .set_body_typed([](std::string target_str) -> bool {
       LLVMInstance llvm_instance;
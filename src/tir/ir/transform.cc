@@ -58,6 +58,17 @@ class PrimFuncPassNode : public PassNode {
    */
   PassInfo Info() const override { return pass_info; }
 
+ private:
+  /*!
+   * \brief Run the pass function over all PrimFuncs of the module on a thread pool.
+   * \param mod The module that an optimization pass is applied on.
+   * \param pass_ctx The context that an optimization pass executes on.
+   * \param num_threads The number of threads to use.
+   * \return Return the updated module.
+   */
+  IRModule ParallelApply(IRModule mod, const PassContext& pass_ctx, int num_threads) const;
+
+ public:
   static constexpr const char* _type_key = "tir.PrimFuncPass";
   TVM_DECLARE_FINAL_OBJECT_INFO(PrimFuncPassNode, PassNode);
 };
@@ -88,6 +99,10 @@ PrimFuncPass::PrimFuncPass(
 // Perform Module -> Module optimizations at the PrimFunc level.
 IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx) const {
   ICHECK(mod.defined());
+  int num_threads = GetFunctionPassNumThreads(pass_ctx, pass_info);
+  if (num_threads > 1) {
+    return ParallelApply(std::move(mod), pass_ctx, num_threads);
+  }
   std::vector<ObjectRef> deleted_list;
   IRModuleNode* mod_ptr = mod.CopyOnWrite();
   auto* func_dict = mod_ptr->functions.CopyOnWrite();
@@ -113,10 +128,35 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
   return mod;
 }
 
+IRModule PrimFuncPassNode::ParallelApply(IRModule mod, const PassContext& pass_ctx,
+                                         int num_threads) const {
+  // Unlike the serial path, functions are not moved out of `mod`, since other functions
+  // may read it concurrently. Results are written back afterwards in the original order.
+  std::vector<std::pair<GlobalVar, PrimFunc>> updates;
+  for (const auto& kv : mod->functions) {
+    if (const auto* func = kv.second.as<PrimFuncNode>()) {
+      updates.emplace_back(kv.first, GetRef<PrimFunc>(func));
+    }
+  }
+  ParallelForEachFunction(pass_ctx, num_threads, updates.size(), [&](int task_id) {
+    PrimFunc& func = updates[task_id].second;
+    func = pass_func(std::move(func), mod, pass_ctx);
+  });
+  IRModuleNode* mod_ptr = mod.CopyOnWrite();
+  for (auto& kv : updates) {
+    if (kv.second.defined()) {
+      mod_ptr->functions.Set(kv.first, std::move(kv.second));
+    } else {
+      mod_ptr->functions.erase(kv.first);
+    }
+  }
+  return mod;
+}
+
 Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required, bool traceable) {
-  PassInfo pass_info = PassInfo(opt_level, name, required, traceable);
+    int opt_level, String name, tvm::Array<String> required, bool traceable, bool thread_safe) {
+  PassInfo pass_info = PassInfo(opt_level, name, required, traceable, thread_safe);
   return PrimFuncPass(pass_func, pass_info);
 }
 
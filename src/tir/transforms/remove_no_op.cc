@@ -185,7 +185,8 @@ Pass RemoveNoOp() {
     n->body = NoOpRemover()(std::move(n->body));
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.RemoveNoOp", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.RemoveNoOp", {}, /*traceable=*/false,
+                            /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.RemoveNoOp").set_body_typed(RemoveNoOp);
@@ -45,6 +45,7 @@ struct SimplifyConfigNode : public tvm::AttrsNode<SimplifyConfigNode> {
   bool propagate_knowns_to_simplify_expressions;
   bool convert_boolean_to_and_of_ors;
   bool apply_constraints_to_boolean_branches;
+  int simplify_cache_size;
 
   TVM_DECLARE_ATTRS(SimplifyConfigNode, "tir.transform.SimplifyConfig") {
     TVM_ATTR_FIELD(transitively_prove_inequalities)
@@ -72,6 +73,12 @@ struct SimplifyConfigNode : public tvm::AttrsNode<SimplifyConfigNode> {
             "If true, simplify each branch of AND/OR "
             "under a constraints provided by the other branch")
         .set_default(false);
+
+    TVM_ATTR_FIELD(simplify_cache_size)
+        .describe(
+            "If positive, memoize up to this many simplified expressions "
+            "within the current constraint context")
+        .set_default(0);
   }
 
   RewriteSimplifier::Extension GetEnabledExtensions() const {
@@ -104,6 +111,9 @@ class StmtSimplifier : public IRMutatorWithAnalyzer {
   static Stmt Apply(Stmt stmt, Analyzer* analyzer, Optional<SimplifyConfig> config_opt = NullOpt) {
     auto config = config_opt.value_or(AttrsWithDefaultValues<arith::SimplifyConfig>());
     analyzer->rewrite_simplify.SetEnabledExtensions(config->GetEnabledExtensions());
+    if (config->simplify_cache_size > 0) {
+      analyzer->EnableSimplifyCache(config->simplify_cache_size);
+    }
 
     std::optional<ControlFlowGraph> touch_pattern = std::nullopt;
     if (config->propagate_knowns_to_prove_conditional ||
@@ -286,7 +296,8 @@ Pass Simplify() {
     n->body = arith::StmtSimplifier::Apply(std::move(n->body), &analyzer, cfg);
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.Simplify", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.Simplify", {}, /*traceable=*/false,
+                            /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.Simplify").set_body_typed(Simplify);
@@ -235,7 +235,8 @@ Pass UnrollLoop() {
     n->body = UnrollLoop(std::move(f->body), cfg.value());
     return f;
   };
-  return CreatePrimFuncPass(pass_func, 0, "tir.UnrollLoop", {});
+  return CreatePrimFuncPass(pass_func, 0, "tir.UnrollLoop", {}, /*traceable=*/false,
+                            /*thread_safe=*/true);
 }
 
 TVM_REGISTER_GLOBAL("tir.transform.UnrollLoop").set_body_typed(UnrollLoop);
@@ -20,7 +20,10 @@
 #include <dmlc/logging.h>
 #include <gtest/gtest.h>
 #include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/te/operation.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt.h>
 
 TEST(Expr, Basic) {
   using namespace tvm;
@@ -53,3 +56,46 @@ TEST(ExprNodeRef, Basic) {
   const tir::MaxNode* op = z.as<tir::MaxNode>();
   ICHECK(GetRef<ObjectRef>(op).same_as(z));
 }
+
+TEST(PrimFunc, CachedStructuralHashAfterMutation) {
+  using namespace tvm;
+  using namespace tvm::tir;
+  Var x("x");
+  Var y("y");
+  auto f_hash_fresh = [&](PrimExpr value) {
+    return StructuralHash()(PrimFunc({x, y}, Evaluate(value)));
+  };
+
+  // A hash cached while the function was shared is dropped by CopyOnWrite.
+  PrimFunc func({x, y}, Evaluate(x + y));
+  {
+    PrimFunc other = func;
+    ICHECK_EQ(StructuralHash()(func), f_hash_fresh(x + y));
+  }
+  func.CopyOnWrite()->body = Evaluate(x * y);
+  ICHECK_EQ(StructuralHash()(func), f_hash_fresh(x * y));
+
+  // A function hashed between CopyOnWrite and the mutation is not cached.
+  PrimFuncNode* node = func.CopyOnWrite();
+  ICHECK_EQ(StructuralHash()(func), f_hash_fresh(x * y));
+  node->body = Evaluate(x - y);
+  ICHECK_EQ(StructuralHash()(func), f_hash_fresh(x - y));
+
+  // A copy made from a shared function starts without the cached hash.
+  PrimFunc shared = func;
+  ICHECK_EQ(StructuralHash()(shared), f_hash_fresh(x - y));
+  func.CopyOnWrite()->body = Evaluate(x / y);
+  ICHECK_EQ(StructuralHash()(func), f_hash_fresh(x / y));
+  ICHECK_EQ(StructuralHash()(shared), f_hash_fresh(x - y));
+}
+
+TEST(IntImm, InterningIsOptIn) {
+  using namespace tvm;
+  ICHECK(!IntImm(DataType::Int(32), 3).same_as(IntImm(DataType::Int(32), 3)));
+  bool prev = SetIntImmInterning(true);
+  ICHECK(IntImm(DataType::Int(32), 3).same_as(IntImm(DataType::Int(32), 3)));
+  ICHECK(!IntImm(DataType::Int(32), 3, Span(SourceName::Get("x"), 1, 1, 1, 1))
+              .same_as(IntImm(DataType::Int(32), 3)));
+  SetIntImmInterning(prev);
+  ICHECK(!IntImm(DataType::Int(32), 3).same_as(IntImm(DataType::Int(32), 3)));
+}
@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/te/operation.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/schedule/schedule.h>
+
+#include "../../src/meta_schedule/trace_cache.h"
+#include "../../src/te/operation/create_primfunc.h"
+
+namespace tvm {
+namespace meta_schedule {
+namespace {
+
+tir::Schedule CreateSchedule() {
+  te::Tensor a = te::placeholder({128, 128}, DataType::Float(32), "A");
+  te::Tensor b = te::compute(
+      {128, 128}, [&](tir::Var i, tir::Var j) { return a(i, j) + 1.0f; }, "B");
+  tir::PrimFunc func = tir::CreatePrimFunc({a, b}, NullOpt, std::nullopt);
+  return tir::Schedule::Traced(IRModule({{GlobalVar("main"), func}}), /*seed=*/0,
+                               /*debug_mask=*/0, tir::ScheduleErrorRenderLevel::kDetail);
+}
+
+void SplitOuterLoop(const tir::Schedule& sch) {
+  Array<tir::LoopRV> loops = sch->GetLoops(sch->GetBlock("B"));
+  sch->Split(loops[0], {Integer(4), NullOpt});
+}
+
+}  // namespace
+
+TEST(TraceCache, HitOnRepeatedTrace) {
+  tir::Schedule sch = CreateSchedule();
+  SplitOuterLoop(sch);
+  TraceCache cache(/*max_num_schedules=*/8);
+  TraceCache::Fingerprint fingerprint(sch->trace().value());
+  bool known_failure = true;
+  EXPECT_FALSE(cache.Lookup(fingerprint, &known_failure).defined());
+  EXPECT_FALSE(known_failure);
+  cache.Insert(fingerprint, sch);
+  // The same trace recorded by another schedule has the same fingerprint.
+  tir::Schedule other = CreateSchedule();
+  SplitOuterLoop(other);
+  TraceCache::Fingerprint repeated(other->trace().value());
+  Optional<tir::Schedule> hit = cache.Lookup(repeated, &known_failure);
+  ASSERT_TRUE(hit.defined());
+  EXPECT_FALSE(known_failure);
+  EXPECT_TRUE(StructuralEqual()(hit.value()->mod(), sch->mod()));
+  EXPECT_EQ(cache.SummarizeHits().rfind("Trace cache: 1 hit(s) out of 2 lookup(s)", 0), 0);
+}
+
+TEST(TraceCache, KnownFailure) {
+  TraceCache cache(/*max_num_schedules=*/8);
+  TraceCache::Fingerprint fingerprint(CreateSchedule()->trace().value());
+  cache.Insert(fingerprint, NullOpt);
+  bool known_failure = false;
+  EXPECT_FALSE(cache.Lookup(fingerprint, &known_failure).defined());
+  EXPECT_TRUE(known_failure);
+}
+
+TEST(TraceCache, DistinctScheduleForEachHit) {
+  tir::Schedule sch = CreateSchedule();
+  IRModule original = sch->mod();
+  TraceCache cache(/*max_num_schedules=*/8);
+  TraceCache::Fingerprint fingerprint(sch->trace().value());
+  cache.Insert(fingerprint, sch);
+  // The caller of Insert keeps its schedule and may mutate it.
+  SplitOuterLoop(sch);
+
+  bool known_failure = false;
+  tir::Schedule first = cache.Lookup(fingerprint, &known_failure).value();
+  tir::Schedule second = cache.Lookup(fingerprint, &known_failure).value();
+  EXPECT_FALSE(first.same_as(sch));
+  EXPECT_FALSE(first.same_as(second));
+  EXPECT_TRUE(StructuralEqual()(first->mod(), original));
+
+  // Mutating one population slot leaves the other one and the cache untouched.
+  SplitOuterLoop(first);
+  EXPECT_FALSE(StructuralEqual()(first->mod(), original));
+  EXPECT_TRUE(StructuralEqual()(second->mod(), original));
+  EXPECT_TRUE(second->trace().value()->insts.empty());
+  tir::Schedule third = cache.Lookup(fingerprint, &known_failure).value();
+  EXPECT_TRUE(StructuralEqual()(third->mod(), original));
+}
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "../../../src/runtime/rpc/rpc_endpoint.h"
+
+namespace tvm {
+namespace runtime {
+namespace {
+
+TEST(RPCCopyCache, Key) {
+  EXPECT_EQ(RPCCopyCacheKey("", 0),
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855-0");
+  EXPECT_EQ(RPCCopyCacheKey("abc", 3),
+            "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad-3");
+  std::string data(1000000, 'a');
+  EXPECT_EQ(RPCCopyCacheKey(data.data(), data.size()),
+            "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0-1000000");
+  EXPECT_TRUE(IsRPCCopyCacheKey(RPCCopyCacheKey(data.data(), data.size())));
+}
+
+TEST(RPCCopyCache, ValidKeys) {
+  const std::string hash = "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+  EXPECT_TRUE(IsRPCCopyCacheKey(hash + "-30800"));
+  EXPECT_TRUE(IsRPCCopyCacheKey(std::string(64, 'f') + "-18446744073709551615"));
+}
+
+TEST(RPCCopyCache, InvalidKeys) {
+  // Keys come from the client and name files of the server.
+  const std::string hash = "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+  EXPECT_FALSE(IsRPCCopyCacheKey("../../x"));
+  EXPECT_FALSE(IsRPCCopyCacheKey(hash + "-../../x"));
+  EXPECT_FALSE(IsRPCCopyCacheKey("/etc/passwd"));
+  EXPECT_FALSE(IsRPCCopyCacheKey(""));
+  EXPECT_FALSE(IsRPCCopyCacheKey(hash + "-"));
+  EXPECT_FALSE(IsRPCCopyCacheKey(hash + "-12/"));
+  EXPECT_FALSE(IsRPCCopyCacheKey("0123456789ABCDEF" + hash.substr(16) + "-12"));
+  EXPECT_FALSE(IsRPCCopyCacheKey(hash.substr(1) + "-12"));
+  EXPECT_FALSE(IsRPCCopyCacheKey(hash.substr(0, 32) + "-12"));
+  EXPECT_FALSE(IsRPCCopyCacheKey(hash + "_12"));
+  EXPECT_FALSE(IsRPCCopyCacheKey(hash + "-123456789012345678901"));
+  EXPECT_FALSE(IsRPCCopyCacheKey(hash + std::string("-1\0", 3)));
+}
+
+}  // namespace
+}  // namespace runtime
+}  // namespace tvm
@@ -20,9 +20,16 @@
 #include "../../src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/graph_executor.h"
 
 #include <gtest/gtest.h>
+#include <tvm/runtime/crt/module.h>
+#include <tvm/runtime/crt/static_graph_executor.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#include <vector>
 
 #include "../../src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/load_json.h"
 
+extern "C" MemoryManagerInterface* g_test_memory_manager;
+
 namespace {
 
 constexpr const char* kJson = R"(
@@ -112,4 +119,202 @@ TEST(TVMGraphExecutor_Load, Parse) {
   EXPECT_EQ(executor.nodes_count, 3);
 }
 
+// The operator of kJson.
+int FusedAdd(TVMValue* args, int* type_codes, int num_args, TVMValue* out_ret_value,
+             int* out_ret_tcode, void* resource_handle) {
+  const float* x = static_cast<const float*>(static_cast<DLTensor*>(args[0].v_handle)->data);
+  const float* p0 = static_cast<const float*>(static_cast<DLTensor*>(args[1].v_handle)->data);
+  float* out = static_cast<float*>(static_cast<DLTensor*>(args[2].v_handle)->data);
+  for (int i = 0; i < 10; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      out[i * 5 + j] = x[i * 5 + j] + p0[j];
+    }
+  }
+  return 0;
+}
+
+// The number of functions, in host byte order, followed by their names.
+const char kFuncNames[] = "\x01\x00tvmgen_default_fused_add\x00";
+const TVMBackendPackedCFunc kFuncs[] = {FusedAdd};
+const TVMFuncRegistry kFuncRegistry = {kFuncNames, kFuncs};
+const TVMModule kModule = {&kFuncRegistry};
+
+TVMModuleHandle GetModule() {
+  // Modules cannot be unregistered, so the module is registered once.
+  static TVMModuleHandle module = nullptr;
+  if (module == nullptr) {
+    EXPECT_EQ(TVMModCreateFromCModule(&kModule, &module), 0);
+  }
+  return module;
+}
+
+// Run the graph executor many times from a small pool, with an allocation that outlives each
+// run, and check the memory neither leaks nor fragments.
+TEST(TVMGraphExecutor_Run, RepeatedWithTLSFAllocator) {
+  static uint8_t memory_pool[32 * 1024];
+  MemoryManagerInterface* manager;
+  ASSERT_EQ(TLSFMemoryManagerCreate(&manager, memory_pool, sizeof(memory_pool)),
+            kTvmErrorNoError);
+  TLSFMemoryStats initial_stats;
+  ASSERT_EQ(TLSFMemoryManagerGetStats(manager, &initial_stats), kTvmErrorNoError);
+  TVMModuleHandle module = GetModule();
+
+  float x[50], p0[5], out[50];
+  for (int i = 0; i < 50; ++i) {
+    x[i] = i;
+  }
+  for (int j = 0; j < 5; ++j) {
+    p0[j] = 100 * j;
+  }
+  DLDevice dev = {kDLCPU, 0};
+  DLDataType dtype = {kDLFloat, 32, 1};
+  int64_t shape[2] = {10, 5};
+  int64_t p0_shape[2] = {1, 5};
+  DLTensor x_tensor = {x, dev, 2, dtype, shape, nullptr, 0};
+  DLTensor p0_tensor = {p0, dev, 2, dtype, p0_shape, nullptr, 0};
+  DLTensor out_tensor = {out, dev, 2, dtype, shape, nullptr, 0};
+
+  g_test_memory_manager = manager;
+  void* survivor = nullptr;
+  for (int iter = 0; iter < 1000; ++iter) {
+    TVMGraphExecutor* executor = nullptr;
+    ASSERT_EQ(TVMGraphExecutor_Create(kJson, module, &dev, &executor), 0);
+    void* next_survivor;
+    ASSERT_EQ(manager->Allocate(manager, 16 + iter % 512, dev, &next_survivor), kTvmErrorNoError);
+    if (survivor != nullptr) {
+      ASSERT_EQ(manager->Free(manager, survivor, dev), kTvmErrorNoError);
+    }
+    survivor = next_survivor;
+
+    TVMGraphExecutor_SetInput(executor, "x", &x_tensor);
+    TVMGraphExecutor_SetInput(executor, "p0", &p0_tensor);
+    TVMGraphExecutor_Run(executor);
+    ASSERT_EQ(TVMGraphExecutor_GetOutput(executor, 0, &out_tensor), 0);
+    for (int i = 0; i < 50; ++i) {
+      ASSERT_EQ(out[i], x[i] + p0[i % 5]);
+    }
+    ASSERT_EQ(TVMGraphExecutor_Release(&executor), 0);
+  }
+  ASSERT_EQ(manager->Free(manager, survivor, dev), kTvmErrorNoError);
+  g_test_memory_manager = nullptr;
+
+  TLSFMemoryStats stats;
+  ASSERT_EQ(TLSFMemoryManagerGetStats(manager, &stats), kTvmErrorNoError);
+  EXPECT_EQ(manager->vleak_size, 0);
+  EXPECT_EQ(stats.used_bytes, 0);
+  EXPECT_EQ(stats.num_free_blocks, 1);
+  EXPECT_EQ(stats.largest_free_block_bytes, initial_stats.free_bytes);
+  EXPECT_GT(stats.peak_used_bytes, 0);
+}
+
+// kJson with three chained additions, serialized by tvm.micro.serialize_graph_table. The first
+// and last sums share the same bytes of the 512-byte activation arena.
+const uint64_t kChainGraphTable[] = {
+    0x000000014c425447ULL, 0x0000000300000005ULL, 0x0000000200000009ULL, 0x0000000a00000001ULL,
+    0x0000020000000024ULL, 0x0000000000000040ULL, 0x000000000000000aULL, 0x0000000000000005ULL,
+    0x0000000000000001ULL, 0x0000000000000005ULL, 0x000000000000000aULL, 0x0000000000000005ULL,
+    0x000000000000000aULL, 0x0000000000000005ULL, 0x000000000000000aULL, 0x0000000000000005ULL,
+    0x00012002ffffffffULL, 0x0000000000000002ULL, 0x00012002ffffffffULL, 0x0000000200000002ULL,
+    0x0001200200000000ULL, 0x0000000400000002ULL, 0x0001200200000100ULL, 0x0000000600000002ULL,
+    0x0001200200000000ULL, 0x0000000800000002ULL, 0x0000000000000005ULL, 0x0000000500000003ULL,
+    0x0000000300000003ULL, 0x0000000600000005ULL, 0x0000000000000003ULL, 0x0000000200000001ULL,
+    0x0000000100000002ULL, 0x0000000300000003ULL, 0x0000000400000001ULL, 0x0000000000000000ULL,
+    0x0000000100000002ULL, 0x3070007800000004ULL, 0x5f6e65676d767400ULL, 0x5f746c7561666564ULL,
+    0x64615f6465737566ULL, 0x0000000000000064ULL,
+};
+
+constexpr size_t kChainArenaSize = TVM_STATIC_GRAPH_EXECUTOR_ARENA_SIZE(512, 5, 3, 9);
+
+// Run the static graph executor with an allocator which must stay unused.
+TEST(TVMStaticGraphExecutor, Run) {
+  static uint8_t memory_pool[4 * 1024];
+  MemoryManagerInterface* manager;
+  ASSERT_EQ(TLSFMemoryManagerCreate(&manager, memory_pool, sizeof(memory_pool)),
+            kTvmErrorNoError);
+  TVMModuleHandle module = GetModule();
+  g_test_memory_manager = manager;
+
+  static uint8_t arena[kChainArenaSize];
+  DLDevice dev = {kDLCPU, 0};
+  TVMStaticGraphExecutor* executor = nullptr;
+  ASSERT_EQ(TVMStaticGraphExecutor_Create(kChainGraphTable, sizeof(kChainGraphTable), module, &dev,
+                                          arena, sizeof(arena), &executor),
+            kTvmErrorNoError);
+  EXPECT_EQ(TVMStaticGraphExecutor_GetNumInputs(executor), 2);
+  EXPECT_EQ(TVMStaticGraphExecutor_GetNumOutputs(executor), 1);
+  EXPECT_EQ(TVMStaticGraphExecutor_GetInputIndex(executor, "p0"), 1);
+  EXPECT_EQ(TVMStaticGraphExecutor_GetInputIndex(executor, "y"), -1);
+
+  float x[50], p0[5], out[50];
+  for (int i = 0; i < 50; ++i) {
+    x[i] = i;
+  }
+  for (int j = 0; j < 5; ++j) {
+    p0[j] = 100 * j;
+  }
+  DLDataType dtype = {kDLFloat, 32, 1};
+  int64_t shape[2] = {10, 5};
+  int64_t p0_shape[2] = {1, 5};
+  DLTensor x_tensor = {x, dev, 2, dtype, shape, nullptr, 0};
+  DLTensor p0_tensor = {p0, dev, 2, dtype, p0_shape, nullptr, 0};
+  DLTensor out_tensor = {out, dev, 2, dtype, shape, nullptr, 0};
+
+  EXPECT_EQ(TVMStaticGraphExecutor_Run(executor), kTvmErrorExecutorInputNotSet);
+  EXPECT_EQ(TVMStaticGraphExecutor_SetInput(executor, "y", &x_tensor),
+            kTvmErrorExecutorModuleNoSuchInput);
+  EXPECT_EQ(TVMStaticGraphExecutor_SetInput(executor, "p0", &x_tensor),
+            kTvmErrorFunctionCallInvalidArg);
+  ASSERT_EQ(TVMStaticGraphExecutor_SetInput(executor, "x", &x_tensor), kTvmErrorNoError);
+  ASSERT_EQ(TVMStaticGraphExecutor_SetInput(executor, "p0", &p0_tensor), kTvmErrorNoError);
+  for (int iter = 0; iter < 3; ++iter) {
+    ASSERT_EQ(TVMStaticGraphExecutor_Run(executor), kTvmErrorNoError);
+    ASSERT_EQ(TVMStaticGraphExecutor_GetOutput(executor, 0, &out_tensor), kTvmErrorNoError);
+    for (int i = 0; i < 50; ++i) {
+      ASSERT_EQ(out[i], x[i] + 3 * p0[i % 5]);
+    }
+  }
+  EXPECT_EQ(TVMStaticGraphExecutor_GetOutput(executor, 1, &out_tensor),
+            kTvmErrorFunctionCallInvalidArg);
+  g_test_memory_manager = nullptr;
+
+  // The executor and its tensors live in the arena.
+  EXPECT_GE(reinterpret_cast<uint8_t*>(executor), arena);
+  EXPECT_LT(reinterpret_cast<uint8_t*>(executor), arena + sizeof(arena));
+  TLSFMemoryStats stats;
+  ASSERT_EQ(TLSFMemoryManagerGetStats(manager, &stats), kTvmErrorNoError);
+  EXPECT_EQ(stats.peak_used_bytes, 0);
+}
+
+TEST(TVMStaticGraphExecutor, BadTable) {
+  static uint8_t arena[kChainArenaSize];
+  DLDevice dev = {kDLCPU, 0};
+  TVMModuleHandle module = GetModule();
+  TVMStaticGraphExecutor* executor = nullptr;
+  EXPECT_EQ(TVMStaticGraphExecutor_Create(kChainGraphTable, sizeof(kChainGraphTable), module, &dev,
+                                          arena, sizeof(arena) - 128, &executor),
+            kTvmErrorExecutorArenaTooSmall);
+  EXPECT_EQ(TVMStaticGraphExecutor_Create(kChainGraphTable, sizeof(kChainGraphTable) - 8, module,
+                                          &dev, arena, sizeof(arena), &executor),
+            kTvmErrorExecutorGraphTableInvalid);
+
+  std::vector<uint64_t> table(kChainGraphTable, kChainGraphTable + std::size(kChainGraphTable));
+  table[0] ^= 1;
+  EXPECT_EQ(TVMStaticGraphExecutor_Create(table.data(), table.size() * sizeof(uint64_t), module,
+                                          &dev, arena, sizeof(arena), &executor),
+            kTvmErrorExecutorGraphTableInvalid);
+  table[0] ^= 1;
+  // Point the output of the second addition past the activations.
+  table[22] += 512ULL;
+  EXPECT_EQ(TVMStaticGraphExecutor_Create(table.data(), table.size() * sizeof(uint64_t), module,
+                                          &dev, arena, sizeof(arena), &executor),
+            kTvmErrorExecutorGraphTableInvalid);
+  table[22] -= 512ULL;
+  // Rename the operator.
+  table[38] ^= 0x100ULL << 48;
+  EXPECT_EQ(TVMStaticGraphExecutor_Create(table.data(), table.size() * sizeof(uint64_t), module,
+                                          &dev, arena, sizeof(arena), &executor),
+            kTvmErrorFunctionNameNotFound);
+  EXPECT_EQ(executor, nullptr);
+}
+
 }  // namespace
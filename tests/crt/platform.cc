@@ -20,6 +20,7 @@
 #include <dmlc/logging.h>
 #include <gtest/gtest.h>
 #include <stdarg.h>
+#include <tvm/runtime/crt/page_allocator.h>
 #include <tvm/runtime/crt/platform.h>
 
 // Provide dummy implementations for TVM runtime functions for use by the tests.
@@ -52,12 +53,21 @@ void TVMLogf(const char* fmt, ...) {
   }
 }
 
+// When set, memory is allocated by this memory manager instead of malloc.
+MemoryManagerInterface* g_test_memory_manager = NULL;
+
 tvm_crt_error_t TVMPlatformMemoryAllocate(size_t num_bytes, DLDevice dev, void** out_ptr) {
+  if (g_test_memory_manager != NULL) {
+    return g_test_memory_manager->Allocate(g_test_memory_manager, num_bytes, dev, out_ptr);
+  }
   *out_ptr = malloc(num_bytes);
   return *out_ptr ? kTvmErrorNoError : kTvmErrorPlatformNoMemory;
 }
 
 tvm_crt_error_t TVMPlatformMemoryFree(void* ptr, DLDevice dev) {
+  if (g_test_memory_manager != NULL) {
+    return g_test_memory_manager->Free(g_test_memory_manager, ptr, dev);
+  }
   if (ptr) {
     free(ptr);
   }
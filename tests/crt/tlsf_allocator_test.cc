@@ -0,0 +1,185 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/crt/internal/memory/tlsf_allocator.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#include <random>
+#include <vector>
+
+#include "crt_config.h"
+
+static constexpr const unsigned int kMemoryPoolSizeBytes = 64 * 1024;
+
+class TLSFAllocatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(TLSFMemoryManagerCreate(&interface, memory_pool, kMemoryPoolSizeBytes),
+              kTvmErrorNoError);
+    initial_stats = GetStats();
+    dev_ = {kDLCPU, 0};
+  }
+
+  TLSFMemoryStats GetStats() {
+    TLSFMemoryStats stats;
+    EXPECT_EQ(TLSFMemoryManagerGetStats(interface, &stats), kTvmErrorNoError);
+    return stats;
+  }
+
+  // Check all the memory is back in a single free block.
+  void ExpectAllFree() {
+    TLSFMemoryStats stats = GetStats();
+    EXPECT_EQ(interface->vleak_size, 0);
+    EXPECT_EQ(stats.used_bytes, 0);
+    EXPECT_EQ(stats.num_used_blocks, 0);
+    EXPECT_EQ(stats.num_free_blocks, 1);
+    EXPECT_EQ(stats.free_bytes, initial_stats.free_bytes);
+    EXPECT_EQ(stats.largest_free_block_bytes, initial_stats.free_bytes);
+  }
+
+  // Allocate and free random sizes below max_bytes, checking that no block overwrites another.
+  void RandomStress(size_t max_bytes) {
+    constexpr int kNumSlots = 64;
+    void* ptrs[kNumSlots] = {nullptr};
+    size_t sizes[kNumSlots];
+    std::mt19937 rng(0);
+    for (int iter = 0; iter < 20000; ++iter) {
+      int slot = rng() % kNumSlots;
+      if (ptrs[slot] != nullptr) {
+        const uint8_t* data = static_cast<const uint8_t*>(ptrs[slot]);
+        for (size_t i = 0; i < sizes[slot]; ++i) {
+          ASSERT_EQ(data[i], static_cast<uint8_t>(slot));
+        }
+        ASSERT_EQ(interface->Free(interface, ptrs[slot], dev_), kTvmErrorNoError);
+        ptrs[slot] = nullptr;
+      } else {
+        sizes[slot] = rng() % max_bytes;
+        if (interface->Allocate(interface, sizes[slot], dev_, &ptrs[slot]) == kTvmErrorNoError) {
+          memset(ptrs[slot], slot, sizes[slot]);
+        } else {
+          ptrs[slot] = nullptr;
+        }
+      }
+    }
+    for (int slot = 0; slot < kNumSlots; ++slot) {
+      if (ptrs[slot] != nullptr) {
+        ASSERT_EQ(interface->Free(interface, ptrs[slot], dev_), kTvmErrorNoError);
+      }
+    }
+    ExpectAllFree();
+  }
+
+  uint8_t memory_pool[kMemoryPoolSizeBytes];
+  MemoryManagerInterface* interface;
+  TLSFMemoryStats initial_stats;
+  DLDevice dev_;
+};
+
+TEST_F(TLSFAllocatorTest, Create) {
+  EXPECT_EQ(initial_stats.num_free_blocks, 1);
+  EXPECT_EQ(initial_stats.largest_free_block_bytes, initial_stats.free_bytes);
+  EXPECT_GT(initial_stats.free_bytes,
+            kMemoryPoolSizeBytes - sizeof(TLSFMemoryManager) -
+                2 * (sizeof(TLSFBlock) + TVM_CRT_TLSF_ALIGNMENT_BYTES));
+
+  MemoryManagerInterface* too_small;
+  EXPECT_EQ(TLSFMemoryManagerCreate(&too_small, memory_pool, sizeof(TLSFMemoryManager)),
+            kTvmErrorPlatformNoMemory);
+}
+
+TEST_F(TLSFAllocatorTest, AllocFree) {
+  void* a;
+  ASSERT_EQ(interface->Allocate(interface, 100, dev_, &a), kTvmErrorNoError);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % TVM_CRT_TLSF_ALIGNMENT_BYTES, 0);
+  EXPECT_EQ(interface->vleak_size, 1);
+  TLSFMemoryStats stats = GetStats();
+  EXPECT_GE(stats.used_bytes, 100);
+  EXPECT_EQ(stats.num_used_blocks, 1);
+  EXPECT_EQ(stats.peak_used_bytes, stats.used_bytes);
+
+  EXPECT_EQ(interface->Free(interface, a, dev_), kTvmErrorNoError);
+  ExpectAllFree();
+  EXPECT_EQ(GetStats().peak_used_bytes, stats.used_bytes);
+}
+
+TEST_F(TLSFAllocatorTest, AllocWholePool) {
+  void* a;
+  ASSERT_EQ(interface->Allocate(interface, initial_stats.free_bytes, dev_, &a), kTvmErrorNoError);
+  void* b;
+  EXPECT_EQ(interface->Allocate(interface, 1, dev_, &b), kTvmErrorPlatformNoMemory);
+  EXPECT_EQ(interface->Free(interface, a, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Allocate(interface, initial_stats.free_bytes + 1, dev_, &a),
+            kTvmErrorPlatformNoMemory);
+  ExpectAllFree();
+}
+
+TEST_F(TLSFAllocatorTest, BadFree) {
+  void* a;
+  ASSERT_EQ(interface->Allocate(interface, 100, dev_, &a), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, static_cast<uint8_t*>(a) + 1, dev_),
+            kTvmErrorPlatformMemoryBadFree);
+  EXPECT_EQ(interface->Free(interface, memory_pool, dev_), kTvmErrorPlatformMemoryBadFree);
+  EXPECT_EQ(interface->Free(interface, a, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, a, dev_), kTvmErrorPlatformMemoryBadFree);
+  ExpectAllFree();
+}
+
+// Freeing every other block fragments the pool until the rest is freed.
+TEST_F(TLSFAllocatorTest, Coalesce) {
+  std::vector<void*> ptrs;
+  void* a;
+  while (interface->Allocate(interface, 200, dev_, &a) == kTvmErrorNoError) {
+    ptrs.push_back(a);
+  }
+  ASSERT_GT(ptrs.size(), 100);
+  for (size_t i = 0; i < ptrs.size(); i += 2) {
+    EXPECT_EQ(interface->Free(interface, ptrs[i], dev_), kTvmErrorNoError);
+  }
+  TLSFMemoryStats stats = GetStats();
+  EXPECT_GE(stats.num_free_blocks, ptrs.size() / 2);
+  EXPECT_LT(stats.largest_free_block_bytes, 1024);
+  EXPECT_EQ(interface->Allocate(interface, 1024, dev_, &a), kTvmErrorPlatformNoMemory);
+
+  for (size_t i = 1; i < ptrs.size(); i += 2) {
+    EXPECT_EQ(interface->Free(interface, ptrs[i], dev_), kTvmErrorNoError);
+  }
+  ExpectAllFree();
+}
+
+TEST_F(TLSFAllocatorTest, MappingInsert) {
+  int fl, sl;
+  TLSF_MappingInsert(0, &fl, &sl);
+  EXPECT_EQ(fl, 0);
+  EXPECT_EQ(sl, 0);
+  TLSF_MappingInsert((1 << TLSF_FL_INDEX_SHIFT) - 1, &fl, &sl);
+  EXPECT_EQ(fl, 0);
+  EXPECT_EQ(sl, TLSF_SL_INDEX_COUNT - 1);
+  TLSF_MappingInsert(1 << TLSF_FL_INDEX_SHIFT, &fl, &sl);
+  EXPECT_EQ(fl, 1);
+  EXPECT_EQ(sl, 0);
+  TLSF_MappingInsert((2 << TLSF_FL_INDEX_SHIFT) - 1, &fl, &sl);
+  EXPECT_EQ(fl, 1);
+  EXPECT_EQ(sl, TLSF_SL_INDEX_COUNT - 1);
+}
+
+TEST_F(TLSFAllocatorTest, RandomStress) { RandomStress(2048); }
+
+// The sizes below (1 << TLSF_FL_INDEX_SHIFT) fall in the linear size classes.
+TEST_F(TLSFAllocatorTest, RandomStressSmall) { RandomStress(1 << TLSF_FL_INDEX_SHIFT); }
@@ -876,5 +876,57 @@ def test_incremental_solving_counter():
             assert not ctx1.match_dfb(simple_chain.body.blocks[0])
 
 
+def _stacked_attention_block(num_layers):
+    bb = rx.BlockBuilder()
+    x = rx.Var("x", [32, 32], rx.DynTensorType(2, "float32"))
+    weights = [rx.Var("w%d" % i, [32, 32], rx.DynTensorType(2, "float32")) for i in range(3)]
+    with bb.function("main", [x] + weights):
+        with bb.dataflow():
+            hidden = x
+            for _ in range(num_layers):
+                qkv = []
+                for w in weights:
+                    fc = bb.emit(rx.call_tir("my_fc", (hidden, w), (32, 32), dtype="float32"))
+                    qkv.append(
+                        bb.emit(rx.call_tir("my_transpose", (fc,), (32, 32), dtype="float32"))
+                    )
+                score = bb.emit(rx.op.multiply(qkv[0], qkv[1]))
+                prob = bb.emit(rx.call_tir("softmax", (score,), (32, 32), dtype="float32"))
+                attn = bb.emit(rx.op.multiply(prob, qkv[2]))
+                hidden = bb.emit(rx.op.add(attn, hidden))
+            out = bb.emit_output(hidden)
+        bb.emit_func_output(out)
+    return bb.get()["main"].body.blocks[0]
+
+
+def test_match_dfb_large_block():
+    # A transformer-sized block: candidates are looked up by op and call_tir callee,
+    # instead of trying every pattern node against every var.
+    num_layers = 24
+    dfb = _stacked_attention_block(num_layers)
+
+    with PatternContext() as ctx:
+        fc_trans = is_call_tir_extern("my_fc") >> is_call_tir_extern("my_transpose")
+        softmax = is_call_tir_extern("softmax")
+        fc_trans >> is_op("relax.multiply")(wildcard(), wildcard()) >> softmax
+        matched = ctx.match_dfb(dfb)
+        assert matched
+        assert matched[softmax].same_as(dfb.bindings[7].var)
+        # the exhaustive search finds the same sub-graph from the same start.
+        start = dfb.bindings[0].var
+        indexed = ctx.match_dfb(dfb, start_hint=start, must_include_hint=True)
+        unindexed = ctx.match_dfb(dfb, start_hint=start, must_include_hint=True, use_index=False)
+        assert all(unindexed[pattern].same_as(var) for pattern, var in indexed.items())
+
+        # every layer can be matched from its own start point
+        for layer in range(num_layers):
+            start = dfb.bindings[layer * 10].var
+            assert ctx.match_dfb(dfb, start_hint=start, must_include_hint=True)
+
+    with PatternContext() as ctx:
+        is_call_tir_extern("my_fc") >> is_call_tir_extern("softmax")
+        assert not ctx.match_dfb(dfb)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -146,6 +146,60 @@ def test_two_hop_addone():
     tvm.ir.assert_structural_equal(after, expected)
 
 
+def test_two_hop_distinct_funcs():
+    # transpose and addone are compiled together before folding
+    @tvm.script.ir_module
+    class Module:
+        @T.prim_func
+        def transpose(A: T.Buffer[(2, 3), "float32"], B: T.Buffer[(3, 2), "float32"]) -> None:
+            for i, j in T.grid(3, 2):
+                with T.block("transpose"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    B[vi, vj] = A[vj, vi]
+
+        @T.prim_func
+        def addone(A: T.Buffer[(3, 2), "float32"], B: T.Buffer[(3, 2), "float32"]) -> None:
+            for i, j in T.grid(3, 2):
+                with T.block("addone"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    B[vi, vj] = A[vi, vj] + T.float32(1)
+
+        @R.function
+        def before(c0: R.Tensor((2, 3), "float32")):
+            lv0 = relax.call_tir(transpose, (c0,), (3, 2), dtype="float32")
+            lv1 = relax.call_tir(addone, (lv0,), (3, 2), dtype="float32")
+            return lv1
+
+        @R.function
+        def expected(c1: R.Tensor((3, 2), "float32"), c2: R.Tensor((3, 2), "float32")):
+            lv0 = c1
+            lv1 = c2
+            return c2
+
+    c0_np = np.arange(2 * 3).astype("float32").reshape(2, 3)
+    c1_np = c0_np.T
+    c2_np = c1_np + 1
+    before = gen_mod(Module, "before", {"c0": c0_np})
+    expected = gen_mod(Module, "expected", {"c1": c1_np, "c2": c2_np})
+
+    # Count the llvm builds by wrapping the codegen hook that each build goes through.
+    build_llvm = tvm.get_global_func("target.build.llvm")
+    num_built_funcs = []
+
+    def counting_build_llvm(mod, target):
+        num_built_funcs.append(len(mod.functions))
+        return build_llvm(mod, target)
+
+    tvm.register_func("target.build.llvm", counting_build_llvm, override=True)
+    try:
+        after = relax.transform.FoldConstant()(before)
+    finally:
+        tvm.register_func("target.build.llvm", build_llvm, override=True)
+    tvm.ir.assert_structural_equal(after, expected)
+    # Both functions are compiled by a single build.
+    assert num_built_funcs == [2]
+
+
 def test_dataflow_fold():
     @tvm.script.ir_module
     class Module:
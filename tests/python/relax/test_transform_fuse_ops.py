@@ -773,5 +773,76 @@ def test_softmax():
     _check(before(), expected())
 
 
+def test_fuse_with_cost_model():
+    """Test that the cost model keeps a large reduction out of the elementwise group."""
+    bb = relax.BlockBuilder()
+    x = relax.Var("x", [1024, 1024], relax.DynTensorType(2, "float32"))
+    with bb.function("main", [x]):
+        with bb.dataflow():
+            lv0 = bb.emit_te(topi.add, x, relax.const(1, "float32"))
+            lv1 = bb.emit_te(topi.exp, lv0)
+            gv = bb.emit_output(bb.call_te(topi.sum, lv1, axis=1))
+        bb.emit_func_output(gv)
+    mod = relax.transform.AnnotateTIROpPattern()(bb.get())
+
+    greedy = relax.transform.FuseOps()(mod)
+    assert "fused_add_exp_sum" in [gv.name_hint for gv in greedy.get_global_vars()]
+
+    config = {"relax.FuseOps.cost_model": "analytical", "relax.FuseOps.cache_bytes": 1 << 20}
+    with tvm.transform.PassContext(config=config):
+        fused = relax.transform.FuseOps()(mod)
+    names = [gv.name_hint for gv in fused.get_global_vars()]
+    assert "fused_add_exp" in names
+    assert "fused_add_exp_sum" not in names
+    # the report is only kept in the IR on request.
+    assert fused.attrs is None or "fusion_report" not in fused.attrs
+
+    with tvm.transform.PassContext(config={**config, "relax.FuseOps.report": True}):
+        fused = relax.transform.FuseOps()(mod)
+    report = fused.attrs["fusion_report"]
+    accepted = [r for r in report if r["fused"]]
+    rejected = [r for r in report if not r["fused"]]
+    assert len(accepted) == 1 and len(rejected) > 0
+    # fusing add into exp keeps the 4 MiB intermediate out of memory: one write and one read.
+    assert accepted[0]["bytes_saved"] == 2 * 1024 * 1024 * 4
+    assert rejected[0]["working_set_bytes"] > 1 << 20
+
+    # a pluggable cost model that refuses everything disables fusion.
+    @tvm.register_func("test.fuse_ops.never_fuse", override=True)
+    def never_fuse(mod, group):
+        return False
+
+    with tvm.transform.PassContext(config={"relax.FuseOps.cost_model": "test.fuse_ops.never_fuse"}):
+        unfused = relax.transform.FuseOps()(mod)
+    assert not [gv for gv in unfused.get_global_vars() if gv.name_hint.startswith("fused")]
+
+
+def test_fuse_compute_bound_with_cost_model():
+    """Test that the cost model fuses a compute bound reduction despite a large working set."""
+    bb = relax.BlockBuilder()
+    x = relax.Var("x", [512, 512], relax.DynTensorType(2, "float32"))
+    w = relax.Var("w", [512, 512], relax.DynTensorType(2, "float32"))
+    with bb.function("main", [x, w]):
+        with bb.dataflow():
+            lv0 = bb.emit_te(topi.nn.dense, x, w)
+            gv = bb.emit_output(bb.call_te(topi.add, lv0, relax.const(1, "float32")))
+        bb.emit_func_output(gv)
+    mod = relax.transform.AnnotateTIROpPattern()(bb.get())
+
+    config = {
+        "relax.FuseOps.cost_model": "analytical",
+        "relax.FuseOps.cache_bytes": 1 << 20,
+        "relax.FuseOps.report": True,
+    }
+    with tvm.transform.PassContext(config=config):
+        fused = relax.transform.FuseOps()(mod)
+    assert "fused_dense_add" in [gv.name_hint for gv in fused.get_global_vars()]
+    (record,) = fused.attrs["fusion_report"]
+    assert record["fused"]
+    # the 3 MiB working set exceeds the budget, but each byte moved feeds ~40 iterations.
+    assert record["working_set_bytes"] > 1 << 20
+    assert record["intensity"].value > 4.0
+
+
 if __name__ == "__main__":
     sys.exit(pytest.main([__file__] + sys.argv[1:]))
@@ -15,10 +15,11 @@
 # specific language governing permissions and limitations
 # under the License.
 
+import numpy as np
 import pytest
 import sys
 import tvm
-from tvm import topi
+from tvm import te, tir, topi
 from tvm import relax
 
 
@@ -572,5 +573,159 @@ def test_fuse_return_partial_result():
     _check(before(), expected())
 
 
+def test_fuse_reuse_intermediate_buffers():
+    def before():
+        bb = relax.BlockBuilder()
+        x = relax.Var("x", [10, 20], relax.DynTensorType(2, "float32"))
+        with bb.function("fused_exp_exp_exp_exp_squeeze", [x], attrs={"Primitive": True}):
+            with bb.dataflow():
+                lv0 = bb.emit_te(topi.exp, x)
+                lv1 = bb.emit_te(topi.exp, lv0)
+                lv2 = bb.emit_te(topi.exp, lv1)
+                lv3 = bb.emit_te(topi.exp, lv2)
+                gv = bb.emit_output(bb.call_te(topi.squeeze, lv3))
+            bb.emit_func_output(gv)
+        func_gv = bb.get().get_global_var("fused_exp_exp_exp_exp_squeeze")
+
+        x = relax.Var("x", [10, 20], relax.DynTensorType(2, "float32"))
+        with bb.function("main", [x]):
+            with bb.dataflow():
+                gv = bb.emit_output(relax.Call(func_gv, [x]))
+            bb.emit_func_output(gv)
+        return bb.get()
+
+    def num_alloc_buffers(mod):
+        return len(mod["fused_exp_exp_exp_exp_squeeze"].body.block.alloc_buffers)
+
+    mod_before = before()
+    mod = relax.transform.FuseTIR()(mod_before)
+    with tvm.transform.PassContext(config={"relax.FuseTIR.reuse_intermediate_buffers": True}):
+        mod_reuse = relax.transform.FuseTIR()(mod_before)
+    # The 3rd and 4th exp write into the buffers of the 1st and 2nd ones, which are dead by then.
+    assert num_alloc_buffers(mod) == 4
+    assert num_alloc_buffers(mod_reuse) == 2
+
+    target = tvm.target.Target("llvm", host="llvm")
+    data = tvm.nd.array(np.random.rand(10, 20).astype("float32"))
+    results = []
+    for m in [mod, mod_reuse]:
+        vm = relax.VirtualMachine(relax.vm.build(m, target), tvm.cpu())
+        results.append(vm["main"](data).numpy())
+    np.testing.assert_allclose(results[0], results[1], rtol=1e-5, atol=1e-5)
+
+
+def get_call_tirs(func):
+    calls = []
+
+    def fvisit(e):
+        if isinstance(e, relax.Call) and e.op == tvm.ir.Op.get("relax.call_tir"):
+            calls.append(e)
+
+    relax.analysis.post_order_visit(func, fvisit)
+    return calls
+
+
+def test_horizontal_fuse():
+    def before():
+        bb = relax.BlockBuilder()
+        x = relax.Var("x", [16, 32], relax.DynTensorType(2, "float32"))
+        wq = relax.Var("wq", [32, 32], relax.DynTensorType(2, "float32"))
+        wk = relax.Var("wk", [32, 32], relax.DynTensorType(2, "float32"))
+        wv = relax.Var("wv", [32, 32], relax.DynTensorType(2, "float32"))
+        with bb.function("main", [x, wq, wk, wv]):
+            with bb.dataflow():
+                q = bb.emit_te(topi.nn.matmul, x, wq)
+                k = bb.emit_te(topi.nn.matmul, x, wk)
+                # Depends on q, so it cannot be batched with the projections.
+                qq = bb.emit_te(topi.nn.matmul, q, wq)
+                v = bb.emit_te(topi.nn.matmul, x, wv)
+                lv0 = bb.emit_te(topi.add, qq, k)
+                gv = bb.emit_output(bb.call_te(topi.add, lv0, v))
+            bb.emit_func_output(gv)
+        return bb.get()
+
+    mod_before = before()
+    mod = relax.transform.HorizontalFuseTIR()(mod_before)
+    assert len(get_call_tirs(mod_before["main"])) == 6
+    calls = get_call_tirs(mod["main"])
+    assert len(calls) == 4
+    # q, k and v are computed by one kernel, qq is left alone.
+    x, wq, wk, wv = mod["main"].params
+    batched = [call for call in calls if call.args[0].name_hint == "matmul_horizontal"]
+    assert len(batched) == 1
+    assert list(batched[0].args[1].fields) == [x, wq, x, wk, x, wv]
+    matmuls = [call for call in calls if call.args[0].name_hint == "matmul"]
+    assert len(matmuls) == 1
+    assert matmuls[0].args[1].fields[1].same_as(wq)
+
+    target = tvm.target.Target("llvm", host="llvm")
+    inputs = [np.random.rand(*shape).astype("float32") for shape in [(16, 32)] + [(32, 32)] * 3]
+    results = []
+    for m in [mod_before, mod]:
+        ex = relax.vm.build(m, target)
+        vm = relax.VirtualMachine(ex, tvm.cpu())
+        results.append(vm["main"](*[tvm.nd.array(data) for data in inputs]).numpy())
+    np.testing.assert_allclose(results[0], results[1], rtol=1e-5, atol=1e-5)
+
+
+def test_horizontal_fuse_symbolic_output_shape():
+    m = tir.Var("m", "int64")
+    n = tir.Var("n", "int64")
+    a = te.placeholder((m, n), "float32", "a")
+    exp = te.create_prim_func([a, topi.exp(a)])
+
+    bb = relax.BlockBuilder()
+    x = relax.Var("x", [16, 32], relax.DynTensorType(2, "float32"))
+    y = relax.Var("y", None, relax.DynTensorType(2, "float32"))
+    exp_gv = bb.add_func(exp, "exp")
+    with bb.function("main", [x, y]):
+        with bb.dataflow():
+            lv0 = bb.emit(relax.call_tir(exp_gv, [x], (16, 32), "float32"))
+            bb.match_shape(y, [m, n])
+            # The arguments are defined before lv0, but the output shape is not.
+            lv1 = bb.emit(relax.call_tir(exp_gv, [y], (m, n), "float32"))
+            lv2 = bb.emit(relax.call_tir(exp_gv, [x], (16, 32), "float32"))
+            lv3 = bb.emit(relax.call_tir(exp_gv, [y], (m, n), "float32"))
+            gv = bb.emit_output(relax.Tuple([lv0, lv1, lv2, lv3]))
+        bb.emit_func_output(gv)
+
+    mod = relax.transform.HorizontalFuseTIR()(bb.get())
+    # lv0 and lv2 are batched, and so are lv1 and lv3 after the match_shape.
+    x, y = mod["main"].params
+    batched = [
+        call for call in get_call_tirs(mod["main"]) if call.args[0].name_hint == "exp_horizontal"
+    ]
+    assert len(batched) == 2
+    assert list(batched[0].args[1].fields) == [x, x]
+    assert list(batched[1].args[1].fields) == [y, y]
+
+
+def test_horizontal_fuse_structurally_equal_funcs():
+    def create_exp():
+        a = te.placeholder((16, 32), "float32", "a")
+        return te.create_prim_func([a, topi.exp(a)])
+
+    bb = relax.BlockBuilder()
+    x = relax.Var("x", [16, 32], relax.DynTensorType(2, "float32"))
+    y = relax.Var("y", [16, 32], relax.DynTensorType(2, "float32"))
+    exp_gv = bb.add_func(create_exp(), "exp")
+    # Bound to another GlobalVar below, as if it came from a merged module.
+    exp_copy_gv = relax.GlobalVar("exp_copy")
+    with bb.function("main", [x, y]):
+        with bb.dataflow():
+            lv0 = bb.emit(relax.call_tir(exp_gv, [x], (16, 32), "float32"))
+            lv1 = bb.emit(relax.call_tir(exp_copy_gv, [y], (16, 32), "float32"))
+            gv = bb.emit_output(relax.Tuple([lv0, lv1]))
+        bb.emit_func_output(gv)
+    mod_before = bb.get()
+    mod_before[exp_copy_gv] = create_exp()
+
+    mod = relax.transform.HorizontalFuseTIR()(mod_before)
+    calls = get_call_tirs(mod["main"])
+    assert len(calls) == 1
+    x, y = mod["main"].params
+    assert list(calls[0].args[1].fields) == [x, y]
+
+
 if __name__ == "__main__":
     sys.exit(pytest.main([__file__] + sys.argv[1:]))
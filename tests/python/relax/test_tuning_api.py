@@ -381,6 +381,36 @@ def test_database():
         assert len(new_tuning_records) == 0
 
 
+def test_database_bounded_records_and_trace_prefix():
+    mod1, _ = setup_test_const_folding()
+    knob = Knob("test", {"noapply": Choice()})
+    target = tvm.target.Target("llvm")
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path_workload = osp.join(tmpdir, "workloads.json")
+        path_tuning_record = osp.join(tmpdir, "tuning_records.json")
+        path_measurement_record = osp.join(tmpdir, "measurement_records.json")
+        database = JSONDatabase(
+            path_workload, path_tuning_record, path_measurement_record, max_records_per_key=2
+        )
+        workload = database.commit_workload(mod1)
+        traces = [Trace(mod1, [knob] * i, ["noapply"] * i) for i in range(1, 4)]
+        for trace, run_sec in zip(traces, [0.3, 0.1, 0.2]):
+            database.commit_tuning_record(workload, target, TuningRecord(trace, [run_sec]))
+
+        # Only the two fastest records are kept in memory.
+        records = database.get_top_k(workload, target, top_k=3)
+        assert len(records) == 2
+        assert [r.trace.size for r in records] == [2, 3]
+
+        # Output modules of the kept traces are reusable as prefixes.
+        assert database.query_trace_prefix(workload, target, [knob] * 2, ["noapply"] * 2)
+        assert database.query_trace_prefix(workload, target, [knob], ["noapply"]) is None
+
+        # The evicted record stays on disk.
+        database = JSONDatabase(path_workload, path_tuning_record, path_measurement_record)
+        assert len(database.get_top_k(workload, target, top_k=3)) == 3
+
+
 def test_default_functions():
     mod = setup_test()
     assert isinstance(mod, tvm.IRModule)
@@ -447,6 +477,45 @@ def test_default_functions():
             assert PassContext.current().num_evals == 0
 
 
+def test_default_functions_reuse_trace_prefix():
+    mod = setup_test()
+    num_applied = [0]
+
+    @tvm.register_func("testing.count_apply_fold_constant", override=True)
+    def count_apply_fold_constant(mod):
+        num_applied[0] += 1
+        return relax.transform.FoldConstant()(mod)
+
+    choices = {"apply": Choice("testing.count_apply_fold_constant"), "noapply": Choice()}
+    knob = Knob("TestKnob", choices)
+    trace = Trace(mod)
+    target = "llvm --num-cores=16"
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        database = create_tmp_database(tmpdir)
+        with transform.PassContext(trace=trace, tuning_api_database=database):
+            candidates = default_generate_candidate([knob], trace, target=target)
+            assert num_applied[0] == 1
+            default_evaluate(candidates, target, record_traces=True)
+
+            # The recorded decision histories are reused for the same target.
+            reused = default_generate_candidate([knob], trace, target=target)
+            assert num_applied[0] == 1
+            for before, after in zip(candidates, reused):
+                tvm.ir.assert_structural_equal(before.out_mod, after.out_mod)
+
+            # Without a target, the decisions are applied again.
+            default_generate_candidate([knob], trace)
+            assert num_applied[0] == 2
+
+            # Prefixes applied during generation are reused even if they were never evaluated.
+            other = Knob("OtherKnob", {"apply": Choice("testing.count_apply_fold_constant")})
+            default_generate_candidate([knob, other], trace, target=target)
+            assert num_applied[0] == 4
+            default_generate_candidate([knob, other], trace, target=target)
+            assert num_applied[0] == 4
+
+
 # TODO(sunggg): Do we need to serialize pass context as well?
 def test_pass_context():
     before, expected = setup_test_const_folding()
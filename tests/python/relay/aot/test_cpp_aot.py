@@ -16,6 +16,7 @@
 # under the License.
 """AOT with C++ Runtime Tests"""
 
+import json
 import re
 import textwrap
 
@@ -242,5 +243,64 @@ def test_aot_input_name_with_special_character(target_kind: str, input_name: str
         assert (runner.get_output(0).asnumpy() == expected_output).all()
 
 
+@pytest.mark.parametrize("target_kind", ["c", "llvm"])
+def test_profile(target_kind):
+    """Checks the operators of a model built with instrument-ops are profiled"""
+    x = relay.var("x", shape=(4, 8), dtype="float32")
+    y = relay.nn.relu(relay.add(x, relay.const(1.0)))
+    z = relay.nn.softmax(relay.multiply(y, relay.const(2.0)))
+    func = relay.Function([x], z)
+
+    def build(instrument_ops):
+        with tvm.transform.PassContext(opt_level=0):
+            mod = tvm.relay.build(
+                IRModule.from_expr(func),
+                target=target_kind,
+                executor=backend.Executor("aot", {"instrument-ops": instrument_ops}),
+            )
+        temp_dir = tvm.contrib.utils.TempDirectory()
+        test_so_path = temp_dir / "test.so"
+        mod.export_library(test_so_path, cc="gcc", options=["-std=c11"])
+        loaded_mod = tvm.runtime.load_module(test_so_path)
+        return tvm.runtime.executor.AotModule(loaded_mod["default"](tvm.cpu(0)))
+
+    data = np.random.uniform(size=(4, 8)).astype("float32")
+    runner = build(True)
+    report = runner.profile(x=data)
+    expected = np.exp(2 * np.maximum(data + 1, 0))
+    expected /= expected.sum(axis=1, keepdims=True)
+    tvm.testing.assert_allclose(runner.get_output(0).numpy(), expected, rtol=1e-5)
+
+    assert report.configuration["Executor"] == "AOT"
+    parsed = json.loads(report.json())
+    assert len(parsed["calls"]) >= 2
+    for call in parsed["calls"]:
+        assert call["Name"].startswith("tvmgen_default_fused")
+        assert call["Duration (us)"]["microseconds"] >= 0
+        assert call["Workspace (bytes)"]["count"] >= 0
+    high_water = max(call["Workspace (bytes)"]["count"] for call in parsed["calls"])
+    for metrics in parsed["device_metrics"].values():
+        assert metrics["Workspace High-Water (bytes)"]["count"] == high_water
+    assert "tvmgen_default_fused" in str(report)
+
+    # Without the instrumentation, the operators cannot be told apart.
+    with pytest.raises(tvm.TVMError, match="instrument-ops"):
+        build(False).profile(x=data)
+
+
+def test_instrument_ops_crt():
+    """Checks that instrument-ops is rejected with the C runtime"""
+    two = relay.add(relay.var("x", shape=(2,)), relay.const(1.0))
+    func = relay.Function(relay.analysis.free_vars(two), two)
+
+    with pytest.raises(tvm.TVMError, match="instrument-ops is only supported with the c\\+\\+"):
+        tvm.relay.build(
+            IRModule.from_expr(func),
+            target="c",
+            runtime=backend.Runtime("crt"),
+            executor=backend.Executor("aot", {"instrument-ops": True}),
+        )
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -16,6 +16,7 @@
 # under the License.
 import os
 import numpy as np
+import pytest
 import tvm
 from tvm import te, runtime
 import json
@@ -39,6 +40,83 @@ def test_save_load():
     np.testing.assert_equal(param2["y"].numpy(), y)
 
 
+def test_save_load_file():
+    params = {
+        "x": np.random.uniform(size=(10, 3)).astype("float32"),
+        "y": np.arange(7).astype("int8"),
+        "z": np.random.uniform(size=(2, 2, 5)).astype("float64"),
+    }
+    temp = utils.tempdir()
+    path = temp.relpath("params.bin")
+    runtime.save_param_file(params, path)
+
+    # The arrays are mapped from the file, or read from its bytes.
+    with open(path, "rb") as f:
+        param_bytes = f.read()
+    for loaded in [runtime.load_param_file(path), runtime.load_param_dict(param_bytes)]:
+        assert len(loaded) == 3
+        for name, value in params.items():
+            assert loaded[name].dtype == value.dtype
+            np.testing.assert_equal(loaded[name].numpy(), value)
+
+    # Files of save_param_dict are loaded too.
+    legacy_path = temp.relpath("legacy.bin")
+    with open(legacy_path, "wb") as f:
+        f.write(runtime.save_param_dict(params))
+    loaded = runtime.load_param_file(legacy_path)
+    np.testing.assert_equal(loaded["x"].numpy(), params["x"])
+
+
+def test_load_file_parallel():
+    params = {
+        "x": np.random.uniform(size=(10, 3)).astype("float32"),
+        "y": np.arange(7).astype("int8"),
+    }
+    temp = utils.tempdir()
+    path = temp.relpath("params.bin")
+    runtime.save_param_file(params, path)
+
+    for num_threads in [1, 4]:
+        loaded = runtime.load_param_file(path, copy=True, num_threads=num_threads)
+        for name, value in params.items():
+            np.testing.assert_equal(loaded[name].numpy(), value)
+        profile = runtime.last_load_profile()
+        for phase in ["map", "parse", "allocate", "verify", "copy", "total"]:
+            assert profile[phase] >= 0
+        assert profile["num_threads"] == num_threads
+
+    # A corrupted array fails the checksum verification.
+    with open(path, "r+b") as f:
+        f.seek(-1, 2)
+        last = f.read(1)
+        f.seek(-1, 2)
+        f.write(bytes([last[0] ^ 0xFF]))
+    with pytest.raises(tvm.TVMError, match="Checksum mismatch"):
+        runtime.load_param_file(path, copy=True)
+
+
+def test_graph_executor_load_params_from_file():
+    x = relay.var("x", shape=(10, 3))
+    w = relay.var("w", shape=(10, 3))
+    func = relay.Function([x, w], relay.add(x, w))
+    graph, lib, _ = relay.build(func, target="llvm")
+    x_np = np.random.uniform(size=(10, 3)).astype("float32")
+    w_np = np.random.uniform(size=(10, 3)).astype("float32")
+
+    temp = utils.tempdir()
+    aligned_path = temp.relpath("aligned.bin")
+    runtime.save_param_file({"w": w_np}, aligned_path)
+    legacy_path = temp.relpath("legacy.bin")
+    with open(legacy_path, "wb") as f:
+        f.write(runtime.save_param_dict({"w": w_np}))
+
+    for path in [aligned_path, legacy_path]:
+        mod = graph_executor.create(graph, lib, tvm.cpu(0))
+        mod.load_params_from_file(path)
+        mod.run(x=x_np)
+        tvm.testing.assert_allclose(mod.get_output(0).numpy(), x_np + w_np)
+
+
 def test_ndarray_reflection():
     # Make two `NDArrayWrapper`s that point to the same underlying array.
     np_array = np.random.uniform(size=(10, 2)).astype("float32")
@@ -91,5 +169,8 @@ def test_bigendian_rpc_param():
 
 if __name__ == "__main__":
     test_save_load()
+    test_save_load_file()
+    test_load_file_parallel()
+    test_graph_executor_load_params_from_file()
     test_ndarray_reflection()
     test_bigendian_rpc_param()
@@ -355,6 +355,42 @@ def test_simplify_cast():
     ck.verify(res, 2)
 
 
+def test_simplify_cache():
+    x = te.var("x")
+    y = te.var("y")
+    expr = tvm.tir.floordiv(x * 4 + y, 4)
+    cond = x < 10
+
+    ref = tvm.arith.Analyzer()
+    analyzer = tvm.arith.Analyzer()
+    analyzer.enable_simplify_cache()
+    for ana in [ref, analyzer]:
+        ana.bind(y, tvm.ir.Range(0, 4))
+
+    for _ in range(2):
+        tvm.ir.assert_structural_equal(analyzer.simplify(expr), ref.simplify(expr))
+        tvm.ir.assert_structural_equal(analyzer.simplify(cond), ref.simplify(cond))
+        # cached results do not leak in or out of a constraint context
+        with analyzer.constraint_scope(x < 5):
+            assert analyzer.simplify(cond).value == 1
+        tvm.ir.assert_structural_equal(analyzer.simplify(cond), cond)
+
+    # binding a var invalidates the cached results
+    z = te.var("z")
+    expr = z + 1
+    assert not isinstance(analyzer.simplify(expr), tvm.tir.IntImm)
+    analyzer.bind(z, 3)
+    assert analyzer.simplify(expr).value == 4
+
+    # even the results cached outside a constraint context bound in
+    w = te.var("w")
+    expr = w + 1
+    assert not isinstance(analyzer.simplify(expr), tvm.tir.IntImm)
+    with analyzer.constraint_scope(x < 5):
+        analyzer.bind(w, 3)
+    assert analyzer.simplify(expr).value == 4
+
+
 if __name__ == "__main__":
     test_floormod_simplify()
     test_mul_sum_simplify()
@@ -367,3 +403,4 @@ if __name__ == "__main__":
     test_canonical_mixed()
     test_complex_cases()
     test_simplify_cast()
+    test_simplify_cache()
@@ -413,6 +413,32 @@ def test_meta_schedule_database_reload():
             _equal_record(ret[1], records[2])
 
 
+def test_meta_schedule_database_anchor_block_schema():
+    mod: IRModule = Matmul
+    # Its anchor block has the same schema as `mod` but different shapes, so the hashes collide
+    mod_2: IRModule = MatmulRelu
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path_workload = osp.join(tmpdir, "workloads.json")
+        path_tuning_record = osp.join(tmpdir, "tuning_records.json")
+        for database in [
+            ms.database.MemoryDatabase(module_equality="anchor-block-schema"),
+            ms.database.JSONDatabase(
+                path_workload, path_tuning_record, module_equality="anchor-block-schema"
+            ),
+        ]:
+            workload = database.commit_workload(mod)
+            assert database.has_workload(mod)
+            assert not database.has_workload(mod_2)
+            workload_2 = database.commit_workload(mod_2)
+            assert not workload.same_as(workload_2)
+            assert database.commit_workload(mod).same_as(workload)
+        new_database = ms.database.JSONDatabase(
+            path_workload, path_tuning_record, module_equality="anchor-block-schema"
+        )
+        assert new_database.has_workload(mod)
+        assert new_database.has_workload(mod_2)
+
+
 def test_meta_schedule_database_union():
     mod: IRModule = Matmul
     target = tvm.target.Target("llvm")
@@ -47,6 +47,22 @@ class Matmul:
                     C[vi, vj] = 0.0 # type: ignore
                 C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vk, vj]
 
+
+@tvm.script.ir_module
+class Matmul64:
+    @T.prim_func
+    def main(a: T.handle, b: T.handle, c: T.handle) -> None: # type: ignore
+        T.func_attr({"global_symbol": "main"})
+        A = T.match_buffer(a, (64, 64), "float32")
+        B = T.match_buffer(b, (64, 64), "float32")
+        C = T.match_buffer(c, (64, 64), "float32")
+        for i, j, k in T.grid(64, 64, 64):
+            with T.block("matmul"):
+                vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                with T.init():
+                    C[vi, vj] = 0.0 # type: ignore
+                C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vk, vj]
+
 # fmt: on
 # pylint: enable=missing-class-docstring,invalid-name,no-member,line-too-long,too-many-nested-blocks,no-self-argument
 
@@ -252,6 +268,141 @@ def test_meta_schedule_evolutionary_search_early_stop():  # pylint: disable = in
     assert num_trials_each_iter == [1, 0, 0, 0, 0]
 
 
+def test_meta_schedule_evolutionary_search_transfer_from_similar_workload():  # pylint: disable = invalid-name
+    target = tvm.target.Target("llvm")
+    database = ms.database.MemoryDatabase()
+    # Records of a matmul that differs from the workload being tuned only in shape constants
+    workload = database.commit_workload(Matmul64)
+    for sch in ms.space_generator.ScheduleFn(sch_fn=_schedule_matmul).generate_design_space(
+        Matmul64
+    ):
+        database.commit_tuning_record(
+            ms.database.TuningRecord(
+                trace=sch.trace,
+                workload=workload,
+                run_secs=[1.0],
+                target=target,
+            )
+        )
+
+    context = ms.TuneContext(
+        mod=Matmul,
+        space_generator=ms.space_generator.ScheduleFn(
+            sch_fn=_schedule_matmul,
+            sch_rules=[],
+            postprocs=[],
+            mutator_probs={
+                DummyMutator(): 1.0,
+            },
+        ),
+        search_strategy=ms.search_strategy.EvolutionarySearch(
+            population_size=5,
+            init_measured_ratio=0.5,
+            init_min_unmeasured=2,
+            genetic_num_iters=3,
+            genetic_mutate_prob=0.5,
+            genetic_max_fail_count=10,
+            eps_greedy=0.9,
+        ),
+        target=target,
+        num_threads=1,  # because we are using a mutator from the python side
+    )
+    strategy = context.search_strategy
+    strategy.pre_tuning(
+        max_trials=10,
+        num_trials_per_iter=5,
+        design_spaces=context.space_generator.generate_design_space(context.mod),
+        database=database,
+        cost_model=ms.cost_model.RandomModel(),
+    )
+    candidates = strategy.generate_measure_candidates()
+    assert candidates is not None
+    assert len(candidates) > 0
+    for candidate in candidates:
+        assert candidate.sch.mod["main"].buffer_map[candidate.sch.mod["main"].params[0]].shape[
+            0
+        ] == MATMUL_M
+    strategy.post_tuning()
+
+
+def test_meta_schedule_evolutionary_search_database_without_listing():  # pylint: disable = invalid-name
+    @derived_object
+    class NoListingDatabase(ms.database.PyDatabase):
+        """A database that, like UnionDatabase, cannot list all of its records"""
+
+        def __init__(self):
+            super().__init__()
+            self.impl = ms.database.MemoryDatabase()
+
+        def has_workload(self, mod):
+            return self.impl.has_workload(mod)
+
+        def commit_workload(self, mod):
+            return self.impl.commit_workload(mod)
+
+        def commit_tuning_record(self, record):
+            self.impl.commit_tuning_record(record)
+
+        def get_top_k(self, workload, top_k):
+            return self.impl.get_top_k(workload, top_k)
+
+        def __len__(self):
+            return len(self.impl)
+
+    target = tvm.target.Target("llvm")
+    database = NoListingDatabase()
+    workload = database.commit_workload(Matmul64)
+    for sch in ms.space_generator.ScheduleFn(sch_fn=_schedule_matmul).generate_design_space(
+        Matmul64
+    ):
+        database.commit_tuning_record(
+            ms.database.TuningRecord(
+                trace=sch.trace,
+                workload=workload,
+                run_secs=[1.0],
+                target=target,
+            )
+        )
+    with pytest.raises(tvm.TVMError):
+        database.get_all_tuning_records()
+
+    context = ms.TuneContext(
+        mod=Matmul,
+        space_generator=ms.space_generator.ScheduleFn(
+            sch_fn=_schedule_matmul,
+            sch_rules=[],
+            postprocs=[],
+            mutator_probs={
+                DummyMutator(): 1.0,
+            },
+        ),
+        search_strategy=ms.search_strategy.EvolutionarySearch(
+            population_size=5,
+            init_measured_ratio=0.5,
+            init_min_unmeasured=2,
+            genetic_num_iters=3,
+            genetic_mutate_prob=0.5,
+            genetic_max_fail_count=10,
+            eps_greedy=0.9,
+        ),
+        target=target,
+        num_threads=1,  # because we are using a mutator from the python side
+    )
+    strategy = context.search_strategy
+    # Retargeting is skipped rather than failing the search
+    strategy.pre_tuning(
+        max_trials=10,
+        num_trials_per_iter=5,
+        design_spaces=context.space_generator.generate_design_space(context.mod),
+        database=database,
+        cost_model=ms.cost_model.RandomModel(),
+    )
+    candidates = strategy.generate_measure_candidates()
+    assert candidates is not None
+    assert len(candidates) > 0
+    strategy.post_tuning()
+
+
 def test_meta_schedule_evolutionary_search_fail_init_population():  # pylint: disable = invalid-name
     @derived_object
     class AlwaysFailPostproc(ms.postproc.PyPostproc):
@@ -311,4 +462,6 @@ if __name__ == "__main__":
     test_meta_schedule_replay_func(ms.search_strategy.ReplayTrace)
     test_meta_schedule_evolutionary_search()
     test_meta_schedule_evolutionary_search_early_stop()
+    test_meta_schedule_evolutionary_search_transfer_from_similar_workload()
+    test_meta_schedule_evolutionary_search_database_without_listing()
     test_meta_schedule_evolutionary_search_fail_init_population()
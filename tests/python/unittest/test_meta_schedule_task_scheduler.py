@@ -231,6 +231,51 @@ def test_meta_schedule_task_scheduler_multiple():
         )
 
 
+@pytest.mark.parametrize("max_inflight_batches", [1, 2])
+def test_meta_schedule_task_scheduler_multiple_async(max_inflight_batches: int):
+    num_trials_per_iter = 6
+    max_trials_per_task = 101
+    tasks = [
+        ms.TuneContext(
+            MatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="Matmul",
+            rand_state=42,
+        ),
+        ms.TuneContext(
+            BatchMatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_batch_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="BatchMatmul",
+            rand_state=0x114514,
+        ),
+    ]
+    database = ms.database.MemoryDatabase()
+    round_robin = ms.task_scheduler.RoundRobin(max_inflight_batches=max_inflight_batches)
+    assert round_robin.max_inflight_batches == max_inflight_batches
+    round_robin.tune(
+        tasks,
+        [1.0, 1.0],
+        builder=DummyBuilder(),
+        runner=DummyRunner(),
+        database=database,
+        measure_callbacks=[ms.measure_callback.AddToDatabase()],
+        max_trials_global=max_trials_per_task * len(tasks),
+        max_trials_per_task=max_trials_per_task,
+        num_trials_per_iter=num_trials_per_iter,
+        cost_model=None,
+    )
+    assert len(database) == max_trials_per_task * len(tasks)
+    for task in tasks:
+        assert (
+            len(database.get_top_k(database.commit_workload(task.mod), 100000))
+            == max_trials_per_task
+        )
+
+
 def test_meta_schedule_task_scheduler_NIE():  # pylint: disable=invalid-name
     @ms.derived_object
     class NIETaskScheduler(ms.task_scheduler.PyTaskScheduler):
@@ -439,6 +484,7 @@ def test_meta_schedule_task_scheduler_gradient_based_with_null_search_strategy()
 if __name__ == "__main__":
     test_meta_schedule_task_scheduler_single()
     test_meta_schedule_task_scheduler_multiple()
+    test_meta_schedule_task_scheduler_multiple_async(2)
     test_meta_schedule_task_scheduler_NIE()
     test_meta_schedule_task_scheduler_avoid_cyclic()
     test_meta_schedule_task_scheduler_override_next_task_id_only()
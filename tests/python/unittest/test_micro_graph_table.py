@@ -0,0 +1,121 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+"""Tests for the graph tables of the CRT static graph executor."""
+
+import json
+import struct
+
+import pytest
+
+import tvm.testing
+from tvm.micro import graph_table
+
+
+def _chain_graph(num_adds, func_name="tvmgen_default_fused_add"):
+    """A graph which adds p0 to x num_adds times."""
+    nodes = [
+        {"op": "null", "name": "x", "inputs": []},
+        {"op": "null", "name": "p0", "inputs": []},
+    ]
+    for i in range(num_adds):
+        nodes.append(
+            {
+                "op": "tvm_op",
+                "name": f"add{i}",
+                "attrs": {
+                    "num_outputs": "1",
+                    "num_inputs": "2",
+                    "flatten_data": "0",
+                    "func_name": func_name,
+                },
+                "inputs": [[i + 1 if i else 0, 0, 0], [1, 0, 0]],
+            }
+        )
+    num_nodes = len(nodes)
+    return {
+        "nodes": nodes,
+        "arg_nodes": [0, 1],
+        "heads": [[num_nodes - 1, 0, 0]],
+        "attrs": {
+            "dltype": ["list_str", ["float32"] * num_nodes],
+            "device_index": ["list_int", [1] * num_nodes],
+            "storage_id": ["list_int", list(range(num_nodes))],
+            "shape": ["list_shape", [[10, 5], [1, 5]] + [[10, 5]] * num_adds],
+        },
+        "node_row_ptr": list(range(num_nodes + 1)),
+    }
+
+
+def test_arena_layout():
+    table = graph_table.serialize_graph_table(json.dumps(_chain_graph(3)))
+    # Each sum needs 200 bytes, and the first one is dead when the last one is computed.
+    assert table.storage_offsets == {2: 0, 3: 256, 4: 0}
+    assert table.activation_bytes == 512
+    assert (table.num_entries, table.num_ops, table.num_op_args) == (5, 3, 9)
+
+    header = struct.unpack_from("<12I", table.data)
+    assert header[:2] == (graph_table.GRAPH_TABLE_MAGIC, graph_table.GRAPH_TABLE_VERSION)
+    assert header[2:10] == (5, 3, 9, 2, 1, 10, 36, 512)
+    assert len(table.data) % 8 == 0
+
+    # Inputs have no storage in the arena.
+    entries_offset = 48 + 10 * 8
+    entries = [struct.unpack_from("<4I", table.data, entries_offset + 16 * i) for i in range(5)]
+    assert [e[0] for e in entries] == [graph_table.EXTERNAL_OFFSET] * 2 + [0, 256, 0]
+    assert entries[2][1] == 2 | (32 << 8) | (1 << 16)
+
+    # The shared function name is stored once.
+    assert table.data.count(b"tvmgen_default_fused_add\0") == 1
+
+
+def test_arena_no_overlap():
+    table = graph_table.serialize_graph_table(json.dumps(_chain_graph(8)), alignment=16)
+    # Consecutive sums are live at the same time, others may share memory.
+    assert table.activation_bytes == 2 * 208
+    for sid in range(2, 9):
+        assert table.storage_offsets[sid] != table.storage_offsets[sid + 1]
+
+
+def test_c_source():
+    table = graph_table.serialize_graph_table(json.dumps(_chain_graph(3)))
+    source = table.to_c_source("chain")
+    assert "#define CHAIN_ARENA_SIZE TVM_STATIC_GRAPH_EXECUTOR_ARENA_SIZE(512, 5, 3, 9)" in source
+    assert f"const uint64_t chain_graph_table[{len(table.data) // 8}]" in source
+    assert "0x000000014c425447ULL" in source
+
+
+def test_unsupported():
+    with pytest.raises(graph_table.GraphTableError, match="__nop"):
+        graph_table.serialize_graph_table(json.dumps(_chain_graph(1, "__nop")))
+
+    graph = _chain_graph(2)
+    graph["nodes"][3]["attrs"]["flatten_data"] = "1"
+    with pytest.raises(graph_table.GraphTableError, match="flatten_data"):
+        graph_table.serialize_graph_table(json.dumps(graph))
+
+    graph = _chain_graph(2)
+    graph["attrs"]["storage_id"][1][3] = 0
+    with pytest.raises(graph_table.GraphTableError, match="shared by an input"):
+        graph_table.serialize_graph_table(json.dumps(graph))
+
+    with pytest.raises(graph_table.GraphTableError, match="alignment"):
+        graph_table.serialize_graph_table(json.dumps(_chain_graph(1)), alignment=4)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -138,6 +138,110 @@ def test_load_unexpected_params():
     rt_mod.load_params(runtime.save_param_dict(new_params))
 
 
+@tvm.testing.requires_llvm
+def test_graph_parallel():
+    # Independent branches, with intermediate storage reused between them.
+    x = relay.var("x", shape=(64, 64))
+    branches = []
+    for i in range(4):
+        y = relay.nn.relu(relay.add(x, relay.const(float(i))))
+        branches.append(relay.exp(relay.negative(y)))
+    z = relay.concatenate(branches, axis=0)
+    func = relay.Function([x], relay.sum(z, axis=1))
+
+    with tvm.transform.PassContext(opt_level=0):
+        graph, lib, _ = relay.build(func, target="llvm")
+    x_np = np.random.uniform(-1, 1, size=(64, 64)).astype("float32")
+
+    mod = graph_executor.create(graph, lib, tvm.cpu(0))
+    mod.run(x=x_np)
+    expected = mod.get_output(0).numpy()
+
+    for num_workers, intra_op_threads in [(4, 1), (2, 0), (1, 0)]:
+        mod.set_parallel(num_workers, intra_op_threads)
+        for _ in range(10):
+            mod.run(x=x_np)
+            tvm.testing.assert_allclose(mod.get_output(0).numpy(), expected, rtol=1e-6)
+
+
+def test_graph_create_instance():
+    x = relay.var("x", shape=(8, 16))
+    w = relay.var("w", shape=(4, 16))
+    func = relay.Function([x, w], relay.nn.relu(relay.nn.dense(x, w)))
+    w_np = np.random.uniform(-1, 1, size=(4, 16)).astype("float32")
+
+    graph, lib, _ = relay.build(func, target="llvm")
+    mod = graph_executor.create(graph, lib, tvm.cpu(0))
+    mod.load_params(runtime.save_param_dict({"w": w_np}))
+    instances = [mod.create_instance() for _ in range(3)]
+
+    # Each instance has its own inputs and outputs.
+    x_nps = [np.random.uniform(-1, 1, size=(8, 16)).astype("float32") for _ in range(4)]
+    for m, x_np in zip([mod] + instances, x_nps):
+        m.set_input("x", x_np)
+    for m in [mod] + instances:
+        m.run()
+    for m, x_np in zip([mod] + instances, x_nps):
+        expected = np.maximum(np.dot(x_np, w_np.T), 0)
+        tvm.testing.assert_allclose(m.get_output(0).numpy(), expected, rtol=1e-5)
+
+    # The parameters are shared.
+    w_new = np.random.uniform(-1, 1, size=(4, 16)).astype("float32")
+    mod.set_input("w", w_new)
+    instances[0].run()
+    expected = np.maximum(np.dot(x_nps[1], w_new.T), 0)
+    tvm.testing.assert_allclose(instances[0].get_output(0).numpy(), expected, rtol=1e-5)
+
+
+def test_graph_create_instance_set_input_weights():
+    x = relay.var("x", shape=(8, 16))
+    w = relay.var("w", shape=(4, 16))
+    func = relay.Function([x, w], relay.nn.relu(relay.nn.dense(x, w)))
+    w_np = np.random.uniform(-1, 1, size=(4, 16)).astype("float32")
+    x_np = np.random.uniform(-1, 1, size=(8, 16)).astype("float32")
+
+    graph, lib, _ = relay.build(func, target="llvm")
+    mod = graph_executor.create(graph, lib, tvm.cpu(0))
+    # The weights are passed as ordinary inputs, not loaded as parameters.
+    mod.set_input(w=w_np)
+    instance = mod.create_instance()
+    instance.set_input("x", x_np)
+    instance.run()
+    expected = np.maximum(np.dot(x_np, w_np.T), 0)
+    tvm.testing.assert_allclose(instance.get_output(0).numpy(), expected, rtol=1e-5)
+
+    # They are copied rather than shared.
+    mod.set_input("w", np.zeros((4, 16), "float32"))
+    instance.run()
+    tvm.testing.assert_allclose(instance.get_output(0).numpy(), expected, rtol=1e-5)
+
+
+def test_graph_create_instance_factory():
+    x = relay.var("x", shape=(8, 16))
+    w = relay.var("w", shape=(4, 16))
+    func = relay.Function([x, w], relay.nn.relu(relay.nn.dense(x, w)))
+    w_np = np.random.uniform(-1, 1, size=(4, 16)).astype("float32")
+    x_np = np.random.uniform(-1, 1, size=(8, 16)).astype("float32")
+
+    lib = relay.build(tvm.IRModule.from_expr(func), "llvm", params={"w": w_np})
+    mod = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+    # Sharing the parameters of the factory does not change the reported inputs.
+    shape_dict, _ = mod.get_input_info()
+    assert set(shape_dict.keys()) == set(["x"] + list(lib.get_params().keys()))
+
+    instance = mod.create_instance()
+    shape_dict, _ = instance.get_input_info()
+    assert set(shape_dict.keys()) == set(["x"] + list(lib.get_params().keys()))
+    instance.set_input("x", x_np)
+    instance.run()
+    expected = np.maximum(np.dot(x_np, w_np.T), 0)
+    tvm.testing.assert_allclose(instance.get_output(0).numpy(), expected, rtol=1e-5)
+
+
 if __name__ == "__main__":
     test_graph_simple()
     test_load_unexpected_params()
+    test_graph_parallel()
+    test_graph_create_instance()
+    test_graph_create_instance_set_input_weights()
+    test_graph_create_instance_factory()
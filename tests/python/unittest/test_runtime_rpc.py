@@ -176,6 +176,99 @@ def test_rpc_large_array():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_copy_stream():
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+
+    def check_remote(window, block_bytes):
+        remote.set_copy_stream(window, block_bytes)
+        dev = remote.cpu(0)
+        # Not a multiple of the block size, so that the last block is partial.
+        a_np = np.random.uniform(size=(1000, 777)).astype("float32")
+        a = tvm.nd.array(a_np, dev)
+        np.testing.assert_equal(a.numpy(), a_np)
+        b = tvm.nd.empty(a_np.shape, "float32", dev)
+        b.copyfrom(a_np)
+        np.testing.assert_equal(b.numpy(), a_np)
+
+    for window in [0, 1, 2, 8]:
+        check_remote(window, 4096)
+
+
+@tvm.testing.requires_rpc
+def test_rpc_large_copy():
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+    dev = remote.cpu(0)
+
+    # The payloads of these copies are received directly into the destination.
+    for window in [0, 8]:
+        remote.set_copy_stream(window, 1 << 17)
+        for shape in [(300, 257), (7, 11, 13, 17, 19)]:
+            a_np = np.random.uniform(size=shape).astype("float32")
+            a = tvm.nd.array(a_np, dev)
+            np.testing.assert_equal(a.numpy(), a_np)
+
+
+@tvm.testing.requires_rpc
+def test_rpc_copy_cache():
+    server = rpc.Server(copy_cache=True)
+    copy_cache_dir = server.copy_cache.temp_dir
+    remote = rpc.connect("127.0.0.1", server.port)
+    remote.set_copy_cache(1024)
+    dev = remote.cpu(0)
+    a_np = np.random.uniform(size=(100, 77)).astype("float32")
+    a = tvm.nd.array(a_np, dev)
+    np.testing.assert_equal(a.numpy(), a_np)
+    assert remote.transfer_stats()["cache_hit_bytes"] == 0
+    # The same content is copied from the cache of the server.
+    b = tvm.nd.array(a_np, dev)
+    np.testing.assert_equal(b.numpy(), a_np)
+    stats = remote.transfer_stats()
+    assert stats["cache_hit_bytes"] == a_np.nbytes
+    assert stats["copy_to_remote_bytes"] == 2 * a_np.nbytes
+    # Small arrays bypass the cache.
+    c_np = np.ones((8,), "float32")
+    np.testing.assert_equal(tvm.nd.array(c_np, dev).numpy(), c_np)
+    np.testing.assert_equal(tvm.nd.array(c_np, dev).numpy(), c_np)
+    assert remote.transfer_stats()["cache_hit_bytes"] == a_np.nbytes
+
+    # The cache is removed with the server.
+    del remote
+    server.terminate()
+    assert not os.path.exists(copy_cache_dir)
+
+    # Servers have no copy cache unless asked for one.
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+    remote.set_copy_cache(1024)
+    dev = remote.cpu(0)
+    np.testing.assert_equal(tvm.nd.array(a_np, dev).numpy(), a_np)
+    np.testing.assert_equal(tvm.nd.array(a_np, dev).numpy(), a_np)
+    assert remote.transfer_stats()["cache_hit_bytes"] == 0
+
+
+@tvm.testing.requires_rpc
+def test_rpc_copy_compression():
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+    remote.set_copy_compression(level=1, min_bytes=1024)
+    dev = remote.cpu(0)
+    # Spans several compressed blocks, the last one partial.
+    a_np = np.tile(np.arange(1000, dtype="float32"), 2500)
+    a = tvm.nd.array(a_np, dev)
+    np.testing.assert_equal(a.numpy(), a_np)
+    stats = remote.transfer_stats()
+    assert stats["compressed_copy_bytes"] == 2 * a_np.nbytes
+    assert stats["compressed_payload_bytes"] < a_np.nbytes // 10
+    # Blocks which do not compress are sent as is.
+    b_np = np.random.uniform(size=(300, 257)).astype("float32")
+    np.testing.assert_equal(tvm.nd.array(b_np, dev).numpy(), b_np)
+    stats = remote.transfer_stats()
+    assert stats["compressed_copy_bytes"] == 2 * (a_np.nbytes + b_np.nbytes)
+
+
 @tvm.testing.requires_rpc
 def test_rpc_echo():
     def check(remote):
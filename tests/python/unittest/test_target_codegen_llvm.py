@@ -19,9 +19,11 @@ import ctypes
 import json
 import math
 import numpy as np
+import os
 import pytest
 import re
 import sys
+import tempfile
 
 import tvm
 import tvm.testing
@@ -29,6 +31,7 @@ from tvm import te
 from tvm.contrib import clang, utils
 from tvm.relay.backend import Runtime
 from tvm.script import tir as T
+from tvm.target import codegen
 from tvm.target.codegen import llvm_get_intrinsic_name, llvm_lookup_intrinsic_id
 
 
@@ -288,6 +291,80 @@ def test_multiple_func():
     check_llvm()
 
 
+@tvm.testing.requires_llvm
+def test_sharded_codegen():
+    n = 1024
+    A = te.placeholder((n,), name="A")
+    B = te.placeholder((n,), name="B")
+    C = te.compute(A.shape, lambda *i: A(*i) + B(*i), name="C")
+    s = te.create_schedule(C.op)
+    xo, xi = s[C].split(C.op.axis[0], factor=4)
+    s[C].parallel(xo)
+    s[C].vectorize(xi)
+
+    funcs = [tvm.lower(s, [A, B, C], name="fadd%d" % i) for i in range(8)]
+    with tvm.transform.PassContext(config={"codegen.llvm.num_shards": 3}):
+        m = tvm.build(funcs, "llvm")
+
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    b = tvm.nd.array(np.random.uniform(size=n).astype(B.dtype), dev)
+    for i in range(8):
+        c = tvm.nd.array(np.zeros(n, dtype=C.dtype), dev)
+        m["fadd%d" % i](a, b, c)
+        tvm.testing.assert_allclose(c.numpy(), a.numpy() + b.numpy())
+
+
+@tvm.testing.requires_llvm
+def test_kernel_cache():
+    n = 64
+    A = te.placeholder((n,), name="A")
+    B = te.compute(A.shape, lambda *i: A(*i) + 1.0, name="B")
+    C = te.compute(A.shape, lambda *i: A(*i) * 2.0, name="C")
+    D = te.compute(A.shape, lambda *i: A(*i) * 3.0, name="D")
+
+    def build(cache_dir, funcs, **config):
+        config["codegen.kernel_cache_dir"] = cache_dir
+        codegen.reset_kernel_cache_stats()
+        with tvm.transform.PassContext(config=config):
+            return tvm.build(
+                [tvm.lower(te.create_schedule(T.op), [A, T], name=name) for name, T in funcs],
+                "llvm",
+            )
+
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    b = tvm.nd.array(np.zeros(n, dtype=B.dtype), dev)
+    with tempfile.TemporaryDirectory() as cache_dir:
+        build(cache_dir, [("add", B), ("mul", C)])
+        stats = codegen.kernel_cache_stats()
+        assert stats["misses"] == 2
+        assert stats["insertions"] == 2
+
+        # Changing one kernel only misses for that kernel, and the hits run the cached object code.
+        f = build(cache_dir, [("add", B), ("mul", D)])
+        stats = codegen.kernel_cache_stats()
+        assert stats["hits"] == 1
+        assert stats["misses"] == 1
+        f["add"](a, b)
+        tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1.0)
+        f["mul"](a, b)
+        tvm.testing.assert_allclose(b.numpy(), a.numpy() * 3.0)
+
+        # The IR is generated again to save a module built from the cache.
+        assert "define" in f.get_source("ll")
+        path = os.path.join(cache_dir, "lib.so")
+        f.export_library(path)
+        g = tvm.runtime.load_module(path)
+        g["add"](a, b)
+        tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1.0)
+
+        # Every entry is evicted under a zero budget.
+        build(cache_dir, [("add", B), ("sub", C)], **{"codegen.kernel_cache_max_bytes": 0})
+        assert codegen.kernel_cache_stats()["evictions"] == 4
+        assert not [name for name in os.listdir(cache_dir) if name.endswith(".o")]
+
+
 @tvm.testing.requires_llvm
 def test_llvm_condition():
     def check_llvm(n, offset):
@@ -130,6 +130,41 @@ def test_prim_func():
     tvm.ir.assert_structural_equal(mod0, mod1)
 
 
+def test_prim_func_cached_hash():
+    x = te.var("x")
+    y = te.var("y")
+    func0 = tvm.tir.PrimFunc([x, y], tvm.tir.Evaluate(x + y))
+    func1 = tvm.ir.load_json(tvm.ir.save_json(func0))
+    hash0 = tvm.ir.structural_hash(func0)
+    # the cached value is reused and agrees with an uncached computation
+    assert tvm.ir.structural_hash(func0) == hash0
+    assert tvm.ir.structural_hash(func1) == hash0
+    # copy-on-write updates do not see the cached value of the original
+    func2 = func0.with_attr("global_symbol", "main")
+    assert tvm.ir.structural_hash(func2) != hash0
+    assert tvm.ir.structural_hash(func2) == tvm.ir.structural_hash(
+        func1.with_attr("global_symbol", "main")
+    )
+    assert tvm.ir.structural_hash(func0) == hash0
+
+
+def test_int_imm_interned():
+    # interning is opt-in, so identity-keyed code sees distinct constants by default
+    assert not tvm.tir.IntImm("int32", 3).same_as(tvm.tir.IntImm("int32", 3))
+    prev = tvm.ir.set_int_imm_interning(True)
+    try:
+        assert tvm.tir.IntImm("int32", 3).same_as(tvm.tir.IntImm("int32", 3))
+        assert tvm.tir.IntImm("int64", 0).same_as(tvm.tir.const(0, "int64"))
+        assert tvm.tir.const(True).same_as(tvm.tir.const(True))
+        assert not tvm.tir.IntImm("int32", 3).same_as(tvm.tir.IntImm("int64", 3))
+        # values outside the table still get fresh nodes
+        assert not tvm.tir.IntImm("int32", 100000).same_as(tvm.tir.IntImm("int32", 100000))
+        assert tvm.tir.IntImm("int32", 100000).value == 100000
+    finally:
+        tvm.ir.set_int_imm_interning(prev)
+    assert not tvm.tir.IntImm("int32", 3).same_as(tvm.tir.IntImm("int32", 3))
+
+
 def test_prim_func_param_count_mismatch():
     x = te.var("x")
     y = te.var("y")
@@ -397,6 +432,8 @@ def test_seq_length_mismatch():
 if __name__ == "__main__":
     test_exprs()
     test_prim_func()
+    test_prim_func_cached_hash()
+    test_int_imm_interned()
     test_attrs()
     test_array()
     test_env_func()
@@ -63,6 +63,25 @@ def test_cow_pass():
     assert func_hash == mod["main"].__hash__()
 
 
+def test_parallel_prim_func_pass():
+    funcs = {}
+    for i in range(64):
+        x = te.var("x")
+        stmt = tvm.tir.LetStmt(x, i, tvm.tir.Evaluate(x + 1))
+        funcs["func%d" % i] = tvm.tir.PrimFunc([], stmt)
+    mod = tvm.IRModule(funcs)
+
+    assert tvm.tir.transform.Simplify().info.thread_safe
+    expected = tvm.tir.transform.Simplify()(mod)
+    with tvm.transform.PassContext(config={"ir.function_pass_num_threads": 4}):
+        actual = tvm.tir.transform.Simplify()(mod)
+    tvm.ir.assert_structural_equal(actual, expected)
+    assert [gv.name_hint for gv in actual.get_global_vars()] == [
+        gv.name_hint for gv in expected.get_global_vars()
+    ]
+
+
 if __name__ == "__main__":
     test_cow_pass()
     test_prim_func_pass()
+    test_parallel_prim_func_pass()
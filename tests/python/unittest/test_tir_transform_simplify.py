@@ -136,6 +136,28 @@ def test_complex_likely_elimination():
     assert "if" not in str(stmt)
 
 
+def test_simplify_cache_consistency():
+    # A tiled matmul, whose index expressions are simplified many times
+    # under the same loop context.
+    n = 256
+    A = te.placeholder((n, n), name="A")
+    B = te.placeholder((n, n), name="B")
+    k = te.reduce_axis((0, n), name="k")
+    C = te.compute((n, n), lambda i, j: te.sum(A[i, k] * B[k, j], axis=k), name="C")
+    s = te.create_schedule(C.op)
+    i, j = s[C].op.axis
+    io, ii = s[C].split(i, factor=7)
+    jo, ji = s[C].split(j, factor=13)
+    ko, ki = s[C].split(s[C].op.reduce_axis[0], factor=5)
+    s[C].reorder(io, jo, ko, ii, ki, ji)
+    mod = tvm.lower(s, [A, B, C])
+
+    expected = tvm.tir.transform.Simplify()(mod)
+    with tvm.transform.PassContext(config={"tir.Simplify": {"simplify_cache_size": 64}}):
+        after = tvm.tir.transform.Simplify()(mod)
+    tvm.ir.assert_structural_equal(after, expected)
+
+
 class BaseBeforeAfter(tvm.testing.CompareBeforeAfter):
     transitively_prove_inequalities = False
     convert_boolean_to_and_of_ors = False